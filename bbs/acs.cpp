@@ -26,6 +26,7 @@
 #include "common/value/uservalueprovider.h"
 #include "core/stl.h"
 #include <string>
+#include <vector>
 
 using namespace wwiv::common::value;
 using namespace wwiv::stl;
@@ -44,8 +45,10 @@ bool check_acs(const std::string& expression, acs_debug_t debug) {
   const UserValueProvider user_provider(a()->context());
   const BbsValueProvider bbs_provider(*a()->config(), a()->sess());
 
-  auto [result, debug_info] =
-      sdk::acs::check_acs(*a()->config(), expression, &user_provider, &bbs_provider);
+  std::vector<std::string> debug_info;
+  const auto result =
+      sdk::acs::eval_acs(expression, make_vector(&user_provider, &bbs_provider),
+                         debug == acs_debug_t::none ? nullptr : &debug_info);
   for (const auto& l : debug_info) {
     if (debug == acs_debug_t::local) {
       LOG(INFO) << l;
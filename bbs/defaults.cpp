@@ -31,6 +31,7 @@
 #include "bbs/mmkey.h"
 #include "bbs/msgbase1.h"
 #include "bbs/newuser.h"
+#include "bbs/subacc.h"
 #include "bbs/sysoplog.h"
 #include "bbs/utility.h"
 #include "bbs/xfer.h"
@@ -1156,7 +1157,8 @@ void config_scan_plus(int type) {
         case 5:
           if (type == 0) {
             bool nextsub = false;
-            qscan(static_cast<uint16_t>(top + pos), nextsub);
+            const auto usub_num = static_cast<uint16_t>(top + pos);
+            qscan(usub_num, nextsub, WWIVReadLastRead(a()->usub[usub_num].subnum));
           } else {
             auto cudn_saved = a()->current_user_dir_num();
             a()->set_current_user_dir_num(static_cast<uint16_t>(top + pos));
@@ -36,6 +36,7 @@
 #include "bbs/readmail.h"
 #include "bbs/shortmsg.h"
 #include "bbs/stuffin.h"
+#include "bbs/subacc.h"
 #include "bbs/sysoplog.h"
 #include "bbs/trashcan.h"
 #include "bbs/utility.h"
@@ -894,12 +895,14 @@ void logon() {
 
   if (a()->HasConfigFlag(OP_FLAGS_USE_FORCESCAN) && !done_newscan_all) {
     auto nextsub = false;
+    const auto usub_num = a()->GetForcedReadSubNumber();
+    const auto last_post = WWIVReadLastRead(a()->usub[usub_num].subnum);
     if (a()->user()->sl() < 255) {
       a()->sess().forcescansub(true);
-      qscan(a()->GetForcedReadSubNumber(), nextsub);
+      qscan(usub_num, nextsub, last_post);
       a()->sess().forcescansub(false);
     } else {
-      qscan(a()->GetForcedReadSubNumber(), nextsub);
+      qscan(usub_num, nextsub, last_post);
     }
   }
   CleanUserInfo();
@@ -25,6 +25,7 @@
 #include "bbs/bbsovl3.h"
 #include "bbs/defaults.h"
 #include "bbs/hop.h"
+#include "bbs/message_find.h"
 #include "bbs/newuser.h"
 #include "bbs/sublist.h"
 #include "bbs/syschat.h"
@@ -752,6 +753,10 @@ This command does not attempt to display a .msg/.ans file.
                                           // /A NewMsgsAllConfs
                                           NewMsgsAllConfs();
                                         }));
+  m.emplace("SearchAllSubs", MenuItem(R"(
+  Search the messages in all subs for text
+)",
+                                      MENU_CAT_MSGS, [](MenuContext&) { SearchAllSubs(); }));
   m.emplace("MultiEMail", MenuItem(R"(
   Send multi-email
 )",
@@ -26,7 +26,13 @@
 #include "common/input.h"
 #include "common/output.h"
 #include "core/strings.h"
+#include "fmt/format.h"
 #include "sdk/subxtr.h"
+#include "sdk/msgapi/message_api.h"
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace wwiv::bbs {
 
@@ -34,12 +40,27 @@ static std::string last_search_string;
 static bool last_search_forward{true};
 
 using namespace wwiv::core;
+using namespace wwiv::sdk;
 using namespace wwiv::strings;
 
+/**
+ * Returns the message numbers in the current sub that may contain
+ * search_string according to the full text index, or std::nullopt if
+ * every message needs to be searched.
+ */
+static std::optional<std::vector<int>> FindCandidateMessages(const std::string& search_string) {
+  auto area = a()->msgapi()->Open(a()->current_sub(), a()->sess().GetCurrentReadMessageArea());
+  if (!area) {
+    return std::nullopt;
+  }
+  return area->FindMessages(search_string);
+}
+
 
 find_message_result_t FindNextMessageAgain(int msgno) {
   const auto search_string = last_search_string;
   const auto msgnum_limit = last_search_forward ? a()->GetNumMessagesInCurrentMessageArea() : 1;
+  const auto candidates = FindCandidateMessages(search_string);
   auto tmp_msgnum = msgno;
   auto fnd = false;
   while (tmp_msgnum != msgnum_limit && !fnd) {
@@ -48,6 +69,10 @@ find_message_result_t FindNextMessageAgain(int msgno) {
     } else {
       tmp_msgnum--;
     }
+    if (candidates &&
+        !std::binary_search(std::begin(*candidates), std::end(*candidates), tmp_msgnum)) {
+      continue;
+    }
     if (bin.checka()) {
       break;
     }
@@ -123,4 +148,62 @@ find_message_result_t FindNextMessageFS(common::FullScreenView& fs, int msgno) {
   return FindNextMessageAgain(msgno);
 }
 
+void SearchAllSubs() {
+  bout.nl();
+  bout.print("|#7Search all subs for? (CR=\"{}\")|#1: ", last_search_string);
+  auto search_string = bin.input_upper(20);
+  if (search_string.empty()) {
+    search_string = last_search_string;
+  }
+  if (search_string.empty()) {
+    return;
+  }
+  last_search_string = search_string;
+  bout.nl();
+
+  auto abort = false;
+  auto num_found = 0;
+  for (const auto& usub : a()->usub) {
+    if (abort || a()->sess().hangup()) {
+      break;
+    }
+    const auto& sub = a()->subs().sub(usub.subnum);
+    if (!a()->msgapi()->Exist(sub)) {
+      continue;
+    }
+    auto area = a()->msgapi()->Open(sub, usub.subnum);
+    if (!area) {
+      continue;
+    }
+    std::vector<int> msgnums;
+    if (auto candidates = area->FindMessages(search_string)) {
+      msgnums = std::move(candidates.value());
+    } else {
+      for (auto i = 1; i <= area->number_of_messages(); i++) {
+        msgnums.push_back(i);
+      }
+    }
+    for (const auto msgnum : msgnums) {
+      if (bin.checka(&abort) || abort) {
+        break;
+      }
+      const auto m = area->ReadMessage(msgnum);
+      if (!m) {
+        continue;
+      }
+      const auto title = stripcolors(m->header().title());
+      if (ToStringUpperCase(title).find(search_string) == std::string::npos &&
+          ToStringUpperCase(m->text().string()).find(search_string) == std::string::npos) {
+        continue;
+      }
+      ++num_found;
+      bout.bpla(fmt::format("|#9{}. |#2{} |#9#{} |#1{}", usub.keys, sub.name, msgnum, title),
+                &abort);
+    }
+  }
+  bout.nl();
+  bout.print("|#1{} |#9messages found.\r\n", num_found);
+  bout.nl();
+}
+
 }
@@ -52,6 +52,12 @@ find_message_result_t FindNextMessage(int msgno);
  */
 find_message_result_t FindNextMessageFS(common::FullScreenView& fs, int msgno);
 
+/**
+ * Prompts for a search string and lists the messages containing it in
+ * every sub the user has access to.
+ */
+void SearchAllSubs();
+
 }
 
 #endif
\ No newline at end of file
@@ -46,11 +46,13 @@
 #include "sdk/usermanager.h"
 #include "sdk/fido/fido_address.h"
 #include "sdk/msgapi/parsed_message.h"
+#include "sdk/msgapi/sub_qscan_table.h"
 #include "sdk/net/ftn_msgdupe.h"
 #include "sdk/net/networks.h"
 #include "sdk/net/subscribers.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 using std::chrono::duration;
 using std::chrono::duration_cast;
@@ -382,38 +384,33 @@ std::string grab_user_name(messagerec* m, const std::string& file_name, int netw
   return {};
 }
 
-void qscan(uint16_t start_subnum, bool& nextsub) {
+bool qscan(uint16_t start_subnum, bool& nextsub, uint32_t last_post) {
   const int sub_number = a()->usub[start_subnum].subnum;
 
   if (a()->sess().hangup() || sub_number < 0) {
-    return;
+    return false;
   }
   bout.nl();
   auto memory_last_read = a()->sess().qsc_p[sub_number];
 
-  iscan1(sub_number);
   auto num_lines = 3;
-  if (const auto on_disk_last_post = WWIVReadLastRead(sub_number); !on_disk_last_post || on_disk_last_post > memory_last_read) {
+  auto has_new = false;
+  if (!last_post || last_post > memory_last_read) {
+    has_new = true;
     const auto old_subnum = a()->current_user_sub_num();
     a()->set_current_user_sub_num(start_subnum);
 
     if (!iscan(a()->current_user_sub_num())) {
       bout.outstr("\r\n|#6A file required is in use by another instance. Try again later.\r\n");
-      return;
+      return true;
     }
     memory_last_read = a()->sess().qsc_p[sub_number];
 
     bout.printf("\r\n\n|#1< Q-scan %s %s - %lu msgs >\r\n", a()->current_sub().name,
                  a()->current_user_sub().keys, a()->GetNumMessagesInCurrentMessageArea());
 
-    int i;
-    for (i = a()->GetNumMessagesInCurrentMessageArea();
-         (i > 1) && (get_post(i - 1)->qscan > memory_last_read); i--)
-      ;
-
-    if (a()->GetNumMessagesInCurrentMessageArea() > 0 &&
-        i <= a()->GetNumMessagesInCurrentMessageArea() &&
-        get_post(i)->qscan > a()->sess().qsc_p[a()->sess().GetCurrentReadMessageArea()]) {
+    if (const auto i = find_first_new_post(memory_last_read);
+        i <= a()->GetNumMessagesInCurrentMessageArea()) {
       scan(i, MsgScanOption::SCAN_OPTION_READ_MESSAGE, nextsub, false);
     } else {
       const auto status = a()->status_manager()->get_status();
@@ -433,16 +430,54 @@ void qscan(uint16_t start_subnum, bool& nextsub) {
   bout.clreol();
   bout.move_up_if_newline(num_lines);
   bout.nl();
+  return has_new;
+}
+
+static bool is_qscan_sub(int usub_num) {
+  const auto subnum = a()->usub[usub_num].subnum;
+  return a()->sess().qsc_q[subnum / 32] & (1L << (subnum % 32));
+}
+
+/**
+ * Reads the qscan pointer of the last post in each of the subs from
+ * start_subnum on that are in the user's qscan, in a single pass.
+ * The result is indexed by usub number, and is 0 for the other subs.
+ *
+ * Subs in the shared SubQScanTable are not opened at all, the others
+ * are read from disk and added to the table.
+ */
+static std::vector<uint32_t> read_last_posts(uint16_t start_subnum) {
+  SubQScanTable table(a()->config()->datadir());
+  table.Load();
+  std::vector<uint32_t> last_posts(a()->usub.size());
+  for (auto i = start_subnum; i < a()->usub.size(); i++) {
+    if (!is_qscan_sub(i)) {
+      continue;
+    }
+    const auto subnum = a()->usub[i].subnum;
+    const auto& filename = a()->subs().sub(subnum).filename;
+    if (const auto q = table.last_qscan(filename)) {
+      last_posts[i] = q.value();
+      continue;
+    }
+    last_posts[i] = WWIVReadLastRead(subnum);
+    if (last_posts[i]) {
+      table.Update(filename, last_posts[i]);
+    }
+  }
+  return last_posts;
 }
 
 void nscan(uint16_t start_subnum) {
   bool nextsub = true;
 
   bout.outstr("\r\n|#3-=< Q-Scan All >=-\r\n");
+  auto last_posts = read_last_posts(start_subnum);
   for (auto i = start_subnum; i < a()->usub.size() && nextsub && !a()->sess().hangup();
        i++) {
-    if (a()->sess().qsc_q[a()->usub[i].subnum / 32] & (1L << (a()->usub[i].subnum % 32))) {
-      qscan(i, nextsub);
+    if (is_qscan_sub(i) && qscan(i, nextsub, last_posts[i])) {
+      // Reading messages takes a while, so pick up anything posted meanwhile.
+      last_posts = read_last_posts(static_cast<uint16_t>(i + 1));
     }
     bool abort = false;
     bin.checka(&abort);
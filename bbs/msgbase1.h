@@ -58,7 +58,12 @@ void post(const PostData& data);
 void add_ftn_msgid(const wwiv::sdk::Config& config, const wwiv::sdk::fido::FidoAddress& addr, const std::string& msgid,
                    wwiv::common::MessageEditorData* data);
 std::string grab_user_name(messagerec* m, const std::string& file_name, int network_number);
-void qscan(uint16_t start_subnum, bool& next_sub);
+/**
+ * Scans usub start_subnum for new messages. last_post is the qscan pointer
+ * of the last post in the sub (see WWIVReadLastRead). Returns true if there
+ * were new messages.
+ */
+bool qscan(uint16_t start_subnum, bool& next_sub, uint32_t last_post);
 void nscan(uint16_t start_subnum = 0);
 void ScanMessageTitles();
 void remove_post();
@@ -18,9 +18,12 @@
 /**************************************************************************/
 #include "bbs/msgbase1.h"
 #include "bbs/bbs_helper.h"
+#include "bbs/subacc.h"
 #include "common/message_editor_data.h"
 #include "core/stl.h"
 #include "core/strings.h"
+#include "sdk/subxtr.h"
+#include "sdk/vardec.h"
 #include "sdk/fido/fido_address.h"
 
 #include "gtest/gtest.h"
@@ -49,3 +52,27 @@ TEST(Msgbase1Test, AddFtnMsgid_Smoke) {
   // Reply line added right.
   ASSERT_NE(std::string::npos, data.text.find("REPLY: 1:2/3 deadbeef\r\n"));
 }
+
+TEST(Msgbase1Test, FindFirstNewPost) {
+  BbsHelper helper;
+  helper.SetUp();
+
+  subboard_t sub{};
+  sub.name = "Sub";
+  sub.filename = "sub";
+  ASSERT_TRUE(a()->subs().add(sub));
+  ASSERT_TRUE(iscan1(0));
+  EXPECT_EQ(1, find_first_new_post(0));
+
+  for (uint32_t qscan = 10; qscan <= 30; qscan += 10) {
+    postrec p{};
+    p.qscan = qscan;
+    add_post(&p);
+  }
+  ASSERT_EQ(3, a()->GetNumMessagesInCurrentMessageArea());
+  EXPECT_EQ(1, find_first_new_post(0));
+  EXPECT_EQ(2, find_first_new_post(10));
+  EXPECT_EQ(2, find_first_new_post(15));
+  EXPECT_EQ(3, find_first_new_post(20));
+  EXPECT_EQ(4, find_first_new_post(30));
+}
@@ -61,10 +61,8 @@
 #include "sdk/status.h"
 #include "sdk/user.h"
 #include "sdk/usermanager.h"
-#include <chrono>
 #include <string>
 
-using std::chrono::milliseconds;
 using wwiv::common::InputMode;
 using namespace wwiv::common;
 using namespace wwiv::core;
@@ -491,67 +489,13 @@ static void InsertSmallRecord(StatusMgr& sm, Names& names, int user_number, cons
 }
 
 static int find_new_usernum(const User* pUser, uint32_t* qscn) {
-  File userFile(FilePath(a()->config()->datadir(), USER_LST));
-  for (int i = 0; !userFile.IsOpen() && (i < 20); i++) {
-    if (!userFile.Open(File::modeBinary | File::modeReadWrite | File::modeCreateFile)) {
-      sleep_for(milliseconds(100));
-    }
-  }
-  if (!userFile.IsOpen()) {
-    return -1;
-  }
-
-  int nNewUserNumber = static_cast<int>((userFile.length() / a()->config()->userrec_length()) - 1);
-  userFile.Seek(a()->config()->userrec_length(), File::Whence::begin);
-  int user_number = 1;
-
-  if (nNewUserNumber == a()->status_manager()->user_count()) {
-    user_number = nNewUserNumber + 1;
-  } else {
-    while (user_number <= nNewUserNumber) {
-      if (user_number % 25 == 0) {
-        userFile.Close();
-        for (int n = 0; !userFile.IsOpen() && (n < 20); n++) {
-          if (!userFile.Open(File::modeBinary | File::modeReadWrite | File::modeCreateFile)) {
-            sleep_for(milliseconds(100));
-          }
-        }
-        if (!userFile.IsOpen()) {
-          return -1;
-        }
-        userFile.Seek(static_cast<File::size_type>(user_number * a()->config()->userrec_length()),
-                      File::Whence::begin);
-        nNewUserNumber =
-            static_cast<int>((userFile.length() / a()->config()->userrec_length()) - 1);
-      }
-      User tu;
-      userFile.Read(&tu.data, a()->config()->userrec_length());
-
-      if (tu.deleted() && tu.sl() != 255) {
-        userFile.Seek(static_cast<File::size_type>(user_number * a()->config()->userrec_length()),
-                      File::Whence::begin);
-        userFile.Write(&pUser->data, a()->config()->userrec_length());
-        userFile.Close();
-        write_qscn(user_number, qscn, false);
-        InsertSmallRecord(*a()->status_manager(), *a()->names(), user_number, pUser->GetName());
-        return user_number;
-      }
-      user_number++;
-    }
-  }
-
-  if (user_number <= a()->config()->max_users()) {
-    userFile.Seek(static_cast<File::size_type>(user_number * a()->config()->userrec_length()),
-                  File::Whence::begin);
-    userFile.Write(&pUser->data, a()->config()->userrec_length());
-    userFile.Close();
-    write_qscn(user_number, qscn, false);
-    InsertSmallRecord(*a()->status_manager(), *a()->names(), user_number, pUser->GetName());
-    return user_number;
-  } else {
-    userFile.Close();
+  const auto user_number = a()->users()->add_user(*pUser);
+  if (!user_number) {
     return -1;
   }
+  write_qscn(user_number.value(), qscn, false);
+  InsertSmallRecord(*a()->status_manager(), *a()->names(), user_number.value(), pUser->GetName());
+  return user_number.value();
 }
 
 // Clears a()->user()'s data and makes it ready to be a new user, also
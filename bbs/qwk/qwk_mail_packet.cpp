@@ -269,7 +269,6 @@ void qwk_gather_sub(uint16_t bn, qwk_state* qwk_info) {
   if (!sd || sd > qscnptrx) {
     const auto os = a()->current_user_sub_num();
     a()->set_current_user_sub_num(bn);
-    int i;
 
     // Get total amount of messages in base
     if (!qwk_iscan(a()->current_user_sub_num())) {
@@ -279,19 +278,7 @@ void qwk_gather_sub(uint16_t bn, qwk_state* qwk_info) {
     qscnptrx = a()->sess().qsc_p[sn];
 
     // Find out what message number we are on
-    int amount = 0;
-    {
-      // Pre-open the sub to speed up access.
-      open_sub(false);
-      auto at_exit = finally([]{ close_sub();});
-      const auto total = a()->GetNumMessagesInCurrentMessageArea();
-      for (i = total; i > 1 && get_post(i - 1)->qscan > qscnptrx; i--) {
-        if ((++amount % 1000) == 0) {
-          bout.print("\r|#9Finding Last Read: (|#2{} |#9/ |#1{}|#9)|#0", amount, total);
-        }
-      }
-    }
-    bout.clear_whole_line();      
+    const auto i = find_first_new_post(qscnptrx);
 
     char thissub[81];
     to_char_array_trim(thissub, a()->current_sub().name);
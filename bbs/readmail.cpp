@@ -56,6 +56,7 @@
 #include "sdk/filenames.h"
 #include "sdk/names.h"
 #include "sdk/status.h"
+#include "sdk/msgapi/email_index.h"
 #include "sdk/msgapi/message_utils_wwiv.h"
 #include "sdk/net/networks.h"
 
@@ -1150,21 +1151,10 @@ void readmail(bool newmail_only) {
 }
 
 int check_new_mail(int user_number) {
-  auto new_messages = 0; // number of new mail
-
-  if (auto file(OpenEmailFile(false)); file->Exists() && file->IsOpen()) {
-    const auto mfLength = static_cast<int>(file->length() / sizeof(mailrec));
-    for (auto i = 0; i < mfLength; i++) {
-      mailrec m{};
-      file->Seek(i * sizeof(mailrec), File::Whence::begin);
-      file->Read(&m, sizeof(mailrec));
-      if (m.tosys == 0 && m.touser == user_number) {
-        if (!(m.status & status_seen)) {
-          ++new_messages;
-        }
-      }
-    }
-    file->Close();
+  // The mailbox index is rebuilt from EMAIL.DAT if it is out of date, so
+  // this only reads every mailrec when EMAIL.DAT changed since last time.
+  if (EmailIndex index(FilePath(a()->config()->datadir(), EMAIL_DAT)); index.Load()) {
+    return index.unread(user_number);
   }
-  return new_messages;
+  return 0;
 }
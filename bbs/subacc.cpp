@@ -23,6 +23,7 @@
 #include "bbs/connect1.h"
 #include "bbs/message_file.h"
 #include "common/output.h"
+#include "core/datafile.h"
 #include "core/datetime.h"
 #include "core/file.h"
 #include "core/stl.h"
@@ -32,10 +33,13 @@
 #include "sdk/config.h"
 #include "sdk/status.h"
 #include "sdk/subxtr.h"
+#include "sdk/msgapi/sub_qscan_table.h"
 #include "sdk/vardec.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace wwiv::core;
 using namespace wwiv::sdk;
@@ -193,6 +197,29 @@ postrec* get_post(int mn) {
   return &p;
 }
 
+int find_first_new_post(uint32_t last_read) {
+  const auto num_msgs = a()->GetNumMessagesInCurrentMessageArea();
+  if (num_msgs < 1) {
+    return 1;
+  }
+  // Record 0 is the header, post #n is record n.
+  if (const DataFileView<postrec> posts(subdat_fn); posts && posts.size() > num_msgs) {
+    const auto first = std::begin(posts) + 1;
+    const auto it = std::partition_point(
+        first, first + num_msgs, [last_read](const postrec& p) { return p.qscan <= last_read; });
+    return static_cast<int>(it - std::begin(posts));
+  }
+  // Fall back to reading the posts one at a time from the end.
+  auto i = num_msgs + 1;
+  for (; i > 1; i--) {
+    const auto* p = get_post(i - 1);
+    if (!p || p->qscan <= last_read) {
+      break;
+    }
+  }
+  return i;
+}
+
 void write_post(int mn, postrec* pp) {
   if (!fileSub || !fileSub->IsOpen()) {
     return;
@@ -239,6 +266,8 @@ void add_post(postrec* pp) {
   // add the new post
   fileSub->Seek(a()->GetNumMessagesInCurrentMessageArea() * sizeof(postrec), File::Whence::begin);
   fileSub->Write(pp, sizeof(postrec));
+  // Let new message scans know there is something new here.
+  msgapi::SubQScanTable(a()->config()->datadir()).Update(a()->current_sub().filename, pp->qscan);
 
   // we've modified the sub
   a()->subchg = 0;
@@ -248,8 +277,6 @@ void add_post(postrec* pp) {
   }
 }
 
-static constexpr size_t BUFSIZE = 32000;
-
 void delete_message(int mn) {
   bool need_close = false;
 
@@ -262,37 +289,31 @@ void delete_message(int mn) {
   a()->status_manager()->reload_status();
 
   if (fileSub) {
-    if (mn > 0 && mn <= a()->GetNumMessagesInCurrentMessageArea()) {
-      if (auto* buffer = static_cast<char*>(malloc(BUFSIZE))) {
-        const auto* p1 = get_post(mn);
-        remove_link(&(p1->msg), a()->current_sub().filename);
-
-        auto cp = static_cast<long>(mn + 1) * sizeof(postrec);
-        const auto len = static_cast<long>(a()->GetNumMessagesInCurrentMessageArea() + 1) * sizeof(postrec);
-
-        unsigned int nb;
-        do {
-          const auto l = len - cp;
-          nb = l < BUFSIZE ? static_cast<int>(l) : BUFSIZE;
-          if (nb) {
-            fileSub->Seek(cp, File::Whence::begin);
-            fileSub->Read(buffer, nb);
-            fileSub->Seek(cp - sizeof(postrec), File::Whence::begin);
-            fileSub->Write(buffer, nb);
-            cp += nb;
-          }
-        } while (nb == BUFSIZE);
-
-        // update # msgs
-        postrec p{};
-        fileSub->Seek(0L, File::Whence::begin);
-        fileSub->Read(&p, sizeof(postrec));
-        p.owneruser--;
-        a()->SetNumMessagesInCurrentMessageArea(p.owneruser);
-        fileSub->Seek(0L, File::Whence::begin);
-        fileSub->Write(&p, sizeof(postrec));
-        free(buffer);
+    const auto num_messages = a()->GetNumMessagesInCurrentMessageArea();
+    if (mn > 0 && mn <= num_messages) {
+      const auto* p1 = get_post(mn);
+      remove_link(&(p1->msg), a()->current_sub().filename);
+
+      // Shift the posts after mn down with a single read and write.
+      std::vector<postrec> rest(num_messages - mn);
+      if (!rest.empty()) {
+        const auto size = static_cast<File::size_type>(rest.size() * sizeof(postrec));
+        fileSub->Seek((mn + 1) * sizeof(postrec), File::Whence::begin);
+        fileSub->Read(&rest[0], size);
+        fileSub->Seek(mn * sizeof(postrec), File::Whence::begin);
+        fileSub->Write(&rest[0], size);
       }
+
+      // update # msgs
+      postrec p{};
+      fileSub->Seek(0L, File::Whence::begin);
+      fileSub->Read(&p, sizeof(postrec));
+      p.owneruser--;
+      a()->SetNumMessagesInCurrentMessageArea(p.owneruser);
+      fileSub->Seek(0L, File::Whence::begin);
+      fileSub->Write(&p, sizeof(postrec));
+      // Drop the now unused last record so other instances see the size change.
+      fileSub->set_length(static_cast<File::size_type>(num_messages) * sizeof(postrec));
     }
   }
   // close file, if needed
@@ -28,6 +28,13 @@ uint32_t WWIVReadLastRead(int sub_number);
 bool iscan1(int si);
 int iscan(int b);
 postrec* get_post(int mn);
+/**
+ * Returns the number of the first post in the current sub with a qscan
+ * pointer newer than last_read, or one past the last post if there are
+ * none. Posts are in qscan order, so this is a binary search over the
+ * sub file instead of reading the posts one at a time.
+ */
+int find_first_new_post(uint32_t last_read);
 void delete_message(int mn);
 void write_post(int mn, postrec * pp);
 void add_post(postrec * pp);
@@ -27,7 +27,6 @@
 #include "bbs/utility.h"
 #include "common/com.h"
 #include "common/output.h"
-#include "core/scope_exit.h"
 #include "core/stl.h"
 #include "core/strings.h"
 #include "fmt/printf.h"
@@ -132,44 +131,14 @@ void old_sublist() {
 }
 
 /**
- * Gets the count of new posts in subnum.
- *
- * Starts at the end and will search backwards from the midpoint before starting
- * from the front.  This assumes most people have read most of the messages, and
- * will prioritize performance for those people. Afterwards will start at the
- * start and search forward.
- *
- * If we need to optimize more ever, we can use a binary search if needed or just
- * load all of the postrecs and search in memory.
+ * Gets the count of new posts in subnum, which must be the current sub.
  */
 int get_new_posts_count(int subnum) {
   const auto num = a()->GetNumMessagesInCurrentMessageArea();
-  const auto q = a()->sess().qsc_p[subnum];
   if (num == 0) {
     return 0;
   }
-  const auto midpoint = num / 2;
-  auto msgIndex = num;
-  int64_t last_qscan = 0;
-  open_sub(false);
-  auto at_exit = finally([] { close_sub(); });
-  while(msgIndex > midpoint) {
-    const auto cur = get_post(msgIndex)->qscan;
-    if (cur <= q) {
-      last_qscan = cur;
-      ++msgIndex;
-      break;
-    }
-    --msgIndex;
-  }
-  if (last_qscan < static_cast<int64_t>(q)) {
-    msgIndex = 1;
-    while (msgIndex <= a()->GetNumMessagesInCurrentMessageArea() &&
-           get_post(msgIndex)->qscan <= a()->sess().qsc_p[subnum]) {
-      ++msgIndex;
-    }
-  }
-  return a()->GetNumMessagesInCurrentMessageArea() - msgIndex + 1;
+  return num - find_first_new_post(a()->sess().qsc_p[subnum]) + 1;
 }
 
 void SubList() {
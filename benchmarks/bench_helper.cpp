@@ -0,0 +1,165 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "benchmarks/bench_helper.h"
+
+#include "core/datafile.h"
+#include "core/datetime.h"
+#include "core/file.h"
+#include "core/textfile.h"
+#include "sdk/fido/fido_address.h"
+#include "sdk/filenames.h"
+#include "sdk/net/packets.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace wwiv::core;
+using namespace wwiv::sdk;
+using namespace wwiv::sdk::fido;
+using namespace wwiv::sdk::net;
+
+namespace wwiv::benchmarks {
+
+static int scale_ = 1;
+
+int scale() noexcept { return scale_; }
+
+void set_scale(int scale) noexcept { scale_ = std::max(1, scale); }
+
+int scaled(int64_t n) noexcept { return static_cast<int>(n * scale_); }
+
+// Every synthetic data set starts on 01/01/1999, so it does not change between runs.
+static constexpr daten_t bench_start_daten = 915192000;
+
+static std::filesystem::path create_root(const std::string& name) {
+  static std::atomic<int> counter{0};
+  auto dir = std::filesystem::temp_directory_path() /
+             fmt::format("wwiv_bench_{}_{}_{}", name, time_t_now(), counter++);
+  std::filesystem::create_directories(dir);
+  return dir;
+}
+
+BenchBbs::BenchBbs(const std::string& name) : root_(create_root(name)) {
+  for (const auto& d : {datadir(), msgsdir(), netdir(), root_ / "gfiles", root_ / "menus",
+                        root_ / "dloads", root_ / "scripts"}) {
+    std::filesystem::create_directories(d);
+  }
+  config_t c{};
+  c.userreclen = sizeof(userrec);
+  c.maxusers = 65000;
+  c.max_dirs = 64;
+  c.max_subs = 64;
+  config_ = std::make_unique<Config>(root_, c);
+  config_->set_initialized_for_test(true);
+  config_->set_paths_for_test(datadir(), msgsdir(), root_ / "gfiles", root_ / "menus",
+                              root_ / "dloads", root_ / "scripts");
+}
+
+BenchBbs::~BenchBbs() {
+  std::error_code ec;
+  std::filesystem::remove_all(root_, ec);
+}
+
+bool write_names(const std::filesystem::path& datadir, int num_users) {
+  std::vector<smalrec> names;
+  names.reserve(num_users);
+  for (auto i = 1; i <= num_users; i++) {
+    smalrec sr{};
+    const auto name = synthetic_user_name(i);
+    strncpy(reinterpret_cast<char*>(sr.name), name.c_str(), sizeof(sr.name) - 1);
+    sr.number = static_cast<uint16_t>(i);
+    names.push_back(sr);
+  }
+  std::sort(std::begin(names), std::end(names), [](const smalrec& a, const smalrec& b) {
+    const auto equal = strcmp(reinterpret_cast<const char*>(a.name),
+                              reinterpret_cast<const char*>(b.name));
+    return equal == 0 ? a.number < b.number : equal < 0;
+  });
+  DataFile<smalrec> file(FilePath(datadir, NAMES_LST), File::modeReadWrite | File::modeBinary |
+                                                          File::modeCreateFile | File::modeTruncate);
+  return file && file.WriteVector(names);
+}
+
+bool write_postrecs(const std::filesystem::path& path, int num_records) {
+  SyntheticData data(static_cast<uint32_t>(num_records), 1, bench_start_daten);
+  auto posts = data.posts(num_records, 1, nullptr);
+  for (auto i = 0; i < num_records; i++) {
+    posts[i].msg.storage_type = 2;
+    posts[i].msg.stored_as = static_cast<uint32_t>(i + 1);
+  }
+  DataFile<postrec> file(path, File::modeReadWrite | File::modeBinary | File::modeCreateFile |
+                                   File::modeTruncate);
+  return file && file.WriteVector(posts);
+}
+
+bool write_net_packets(const std::filesystem::path& path, int num_packets, int text_size) {
+  SyntheticData data(static_cast<uint32_t>(num_packets), text_size, bench_start_daten);
+  const auto packets = data.wwivnet_posts(num_packets, 1, "GENCHAT");
+  File::Remove(path);
+  return write_wwivnet_packets(path, packets);
+}
+
+bool write_fido_packet(const std::filesystem::path& path, int num_messages, int text_size) {
+  SyntheticData data(static_cast<uint32_t>(num_messages), text_size, bench_start_daten);
+  return data.write_fido_packet(path, FidoAddress("1:100/1"), FidoAddress("1:100/2"),
+                                num_messages, "GENCHAT");
+}
+
+bool write_nodelist(const std::filesystem::path& path, int num_nets, int nodes_per_net) {
+  TextFile f(path, "wt");
+  if (!f) {
+    return false;
+  }
+  f.WriteLine(";A Synthetic Nodelist");
+  f.WriteLine("Zone,1,Zone_1,Somewhere,Sysop_Name,-Unpublished-,300,CM,INA:zone1.example.com");
+  for (auto net = 100; net < 100 + num_nets; net++) {
+    f.WriteLine(fmt::format("Host,{},Net_{},Somewhere,Sysop_Name,-Unpublished-,300,CM,"
+                            "INA:net{}.example.com,IBN",
+                            net, net, net));
+    for (auto node = 1; node <= nodes_per_net; node++) {
+      auto sysop = synthetic_user_name(node);
+      std::replace(std::begin(sysop), std::end(sysop), ' ', '_');
+      f.WriteLine(fmt::format(",{},Node_{}_{},Somewhere,{},-Unpublished-,300,CM,"
+                              "INA:node{}.net{}.example.com,IBN:24554",
+                              node, net, node, sysop,
+                              node, net));
+    }
+  }
+  return true;
+}
+
+bool write_text_file(const std::filesystem::path& path, int64_t size) {
+  File f(path);
+  if (!f.Open(File::modeReadWrite | File::modeBinary | File::modeCreateFile | File::modeTruncate)) {
+    return false;
+  }
+  constexpr int chunk_size = 64 * 1024;
+  const auto chunk = synthetic_text(chunk_size, 1);
+  for (int64_t written = 0; written < size; written += chunk_size) {
+    const auto len = static_cast<int>(std::min<int64_t>(chunk_size, size - written));
+    if (f.Write(chunk.data(), len) != len) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
@@ -0,0 +1,79 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#ifndef INCLUDED_BENCHMARKS_BENCH_HELPER_H
+#define INCLUDED_BENCHMARKS_BENCH_HELPER_H
+
+#include "sdk/config.h"
+#include "sdk/synthetic_data.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace wwiv::benchmarks {
+
+/** Multiplier applied to every data set size, set by --wwiv_bench_scale. */
+[[nodiscard]] int scale() noexcept;
+void set_scale(int scale) noexcept;
+/** Returns n multiplied by the scale. */
+[[nodiscard]] int scaled(int64_t n) noexcept;
+
+/**
+ * Throw away BBS directory tree under the system temp directory, removed
+ * again when destroyed. The Config is only held in memory.
+ */
+class BenchBbs final {
+public:
+  explicit BenchBbs(const std::string& name);
+  ~BenchBbs();
+
+  [[nodiscard]] const std::filesystem::path& root() const noexcept { return root_; }
+  [[nodiscard]] std::filesystem::path datadir() const { return root_ / "data"; }
+  [[nodiscard]] std::filesystem::path msgsdir() const { return root_ / "msgs"; }
+  [[nodiscard]] std::filesystem::path netdir() const { return root_ / "network"; }
+  [[nodiscard]] sdk::Config& config() const { return *config_; }
+
+private:
+  const std::filesystem::path root_;
+  std::unique_ptr<sdk::Config> config_;
+};
+
+// Synthetic data sets, made with the same generator as "wwivutil generate".
+// They are the same every time for a given size, so runs can be compared
+// with each other.
+
+using sdk::synthetic_text;
+using sdk::synthetic_user_name;
+
+/** Writes NAMES_LST in datadir with num_users users, sorted like Names::Save. */
+bool write_names(const std::filesystem::path& datadir, int num_users);
+/** Writes num_records postrec records to path. */
+bool write_postrecs(const std::filesystem::path& path, int num_records);
+/** Writes num_packets WWIVnet post packets of about text_size bytes to path. */
+bool write_net_packets(const std::filesystem::path& path, int num_packets, int text_size);
+/** Writes a type 2+ FidoNet packet with num_messages messages to path. */
+bool write_fido_packet(const std::filesystem::path& path, int num_messages, int text_size);
+/** Writes a nodelist with num_nets nets of nodes_per_net nodes each to path. */
+bool write_nodelist(const std::filesystem::path& path, int num_nets, int nodes_per_net);
+/** Writes size bytes of synthetic text to path. */
+bool write_text_file(const std::filesystem::path& path, int64_t size);
+
+}  // namespace
+
+#endif
@@ -0,0 +1,52 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "benchmarks/bench_helper.h"
+#include "core/log.h"
+#include "core/strings.h"
+
+#include "benchmark/benchmark.h"
+#include <iostream>
+#include <string>
+
+using namespace wwiv::strings;
+
+// Runs all of the WWIV benchmarks. Besides the usual --benchmark_* flags,
+// --wwiv_bench_scale=N multiplies the size of every generated data set by N.
+int main(int argc, char* argv[]) {
+  try {
+    benchmark::Initialize(&argc, argv);
+    for (auto i = 1; i < argc; i++) {
+      const std::string arg(argv[i]);
+      if (starts_with(arg, "--wwiv_bench_scale=")) {
+        wwiv::benchmarks::set_scale(to_number<int>(arg.substr(19)));
+      }
+    }
+    wwiv::core::LoggerConfig logger_config{};
+    logger_config.register_file_destinations = false;
+    logger_config.log_startup = false;
+    wwiv::core::Logger::Init(argc, argv, logger_config);
+    benchmark::AddCustomContext("wwiv_bench_scale", std::to_string(wwiv::benchmarks::scale()));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+  }
+  return 1;
+}
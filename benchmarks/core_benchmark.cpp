@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "benchmarks/bench_helper.h"
+#include "core/crc32.h"
+#include "core/datafile.h"
+#include "core/file.h"
+#include "sdk/vardec.h"
+
+#include "benchmark/benchmark.h"
+#include <vector>
+
+using namespace wwiv::benchmarks;
+using namespace wwiv::core;
+
+// DataFile read patterns over a *.sub sized file of range(0) postrecs.
+
+static void BM_DataFile_ReadEachRecord(benchmark::State& state) {
+  const BenchBbs bbs("datafile");
+  const auto num = scaled(state.range(0));
+  const auto path = bbs.datadir() / "bench.sub";
+  write_postrecs(path, num);
+  for (auto _ : state) {
+    DataFile<postrec> file(path);
+    postrec p{};
+    for (auto i = 0; i < num; i++) {
+      file.Read(i, &p);
+    }
+    benchmark::DoNotOptimize(p);
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_DataFile_ReadEachRecord)->Arg(1000)->Arg(10000);
+
+static void BM_DataFile_ReadVector(benchmark::State& state) {
+  const BenchBbs bbs("datafile");
+  const auto num = scaled(state.range(0));
+  const auto path = bbs.datadir() / "bench.sub";
+  write_postrecs(path, num);
+  for (auto _ : state) {
+    DataFile<postrec> file(path);
+    std::vector<postrec> posts;
+    file.ReadVector(posts);
+    benchmark::DoNotOptimize(posts.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_DataFile_ReadVector)->Arg(1000)->Arg(10000);
+
+static void BM_DataFileView_Scan(benchmark::State& state) {
+  const BenchBbs bbs("datafile");
+  const auto num = scaled(state.range(0));
+  const auto path = bbs.datadir() / "bench.sub";
+  write_postrecs(path, num);
+  for (auto _ : state) {
+    const DataFileView<postrec> view(path);
+    uint32_t last = 0;
+    for (const auto& p : view) {
+      last = p.qscan;
+    }
+    benchmark::DoNotOptimize(last);
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_DataFileView_Scan)->Arg(1000)->Arg(10000);
+
+// crc32file over a file of range(0) KiB.
+static void BM_Crc32File(benchmark::State& state) {
+  const BenchBbs bbs("crc32");
+  const int64_t size = scaled(state.range(0)) * int64_t{1024};
+  const auto path = bbs.root() / "bench.zip";
+  write_text_file(path, size);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(crc32file(path));
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_Crc32File)->Arg(64)->Arg(4096);
@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "benchmarks/bench_helper.h"
+#include "core/file.h"
+#include "core/strings.h"
+#include "sdk/msgapi/message_api_wwiv.h"
+#include "sdk/msgapi/msgapi.h"
+#include "sdk/msgapi/type2_text.h"
+
+#include "benchmark/benchmark.h"
+#include <memory>
+#include <vector>
+
+using namespace wwiv::benchmarks;
+using namespace wwiv::core;
+using namespace wwiv::sdk;
+using namespace wwiv::sdk::msgapi;
+using namespace wwiv::strings;
+
+// Saves range(0) messages of 1 to 8 blocks, returning where each was stored.
+static std::vector<messagerec> fill_type2(Type2Text& t, int num) {
+  std::vector<messagerec> msgs;
+  msgs.reserve(num);
+  for (auto i = 0; i < num; i++) {
+    const auto text = synthetic_text(200 + (i * 977) % 3800, static_cast<uint32_t>(i));
+    if (auto m = t.savefile(text)) {
+      msgs.push_back(m.value());
+    }
+  }
+  return msgs;
+}
+
+// Saves one message into a *.dat already holding range(0) messages, then
+// removes it again so every iteration sees the same file.
+static void BM_Type2Text_SaveFile(benchmark::State& state) {
+  const BenchBbs bbs("type2");
+  Type2Text t(bbs.msgsdir() / "bench.dat");
+  fill_type2(t, scaled(state.range(0)));
+  const auto text = synthetic_text(1500, 42);
+  for (auto _ : state) {
+    const auto m = t.savefile(text);
+    if (!m || !t.remove_link(m.value())) {
+      state.SkipWithError("savefile failed");
+      break;
+    }
+  }
+}
+BENCHMARK(BM_Type2Text_SaveFile)->Arg(1000)->Arg(10000);
+
+static void BM_Type2Text_ReadFile(benchmark::State& state) {
+  const BenchBbs bbs("type2");
+  Type2Text t(bbs.msgsdir() / "bench.dat");
+  const auto msgs = fill_type2(t, scaled(state.range(0)));
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(t.readfile(msgs[i++ % msgs.size()]));
+  }
+}
+BENCHMARK(BM_Type2Text_ReadFile)->Arg(1000)->Arg(10000);
+
+// Duplicate check done for every incoming network post, against a sub
+// holding range(0) posts.
+static void BM_MessageArea_Exists(benchmark::State& state) {
+  const BenchBbs bbs("exists");
+  MessageApiOptions options;
+  options.overflow_strategy = OverflowStrategy::delete_none;
+  WWIVMessageApi api(options, bbs.config(), {}, new NullLastReadImpl());
+  subboard_t sub{};
+  sub.filename = "bench";
+  if (!api.Create(sub, -1)) {
+    state.SkipWithError("Unable to create sub");
+    return;
+  }
+  auto area(api.Open(sub, -1));
+  const auto num = scaled(state.range(0));
+  for (auto i = 0; i < num; i++) {
+    auto msg = area->CreateMessage();
+    auto& h = msg.header();
+    h.set_from_system(1);
+    h.set_from_usernum(static_cast<uint16_t>(i % 1000 + 1));
+    h.set_title(StrCat("Post #", i));
+    h.set_from(synthetic_user_name(i));
+    h.set_daten(static_cast<daten_t>(915192000 + i * 60));
+    msg.set_text(synthetic_text(300, static_cast<uint32_t>(i)));
+    (void)area->AddMessage(msg, {});
+  }
+  auto i = 0;
+  for (auto _ : state) {
+    // Half of the lookups find a post.
+    const auto n = i++ % (2 * num);
+    benchmark::DoNotOptimize(area->Exists(static_cast<daten_t>(915192000 + n * 60),
+                                          StrCat("Post #", n), 1,
+                                          static_cast<uint16_t>(n % 1000 + 1)));
+  }
+}
+BENCHMARK(BM_MessageArea_Exists)->Arg(1000)->Arg(5000);
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "benchmarks/bench_helper.h"
+#include "core/file.h"
+#include "sdk/fido/fido_packets.h"
+#include "sdk/fido/nodelist.h"
+#include "sdk/net/packets.h"
+
+#include "benchmark/benchmark.h"
+
+using namespace wwiv::benchmarks;
+using namespace wwiv::core;
+using namespace wwiv::sdk::fido;
+using namespace wwiv::sdk::net;
+
+// Reads every packet of a WWIVnet file holding range(0) posts of 2k each.
+static void BM_ReadPacket(benchmark::State& state) {
+  const BenchBbs bbs("read_packet");
+  const auto num = scaled(state.range(0));
+  const auto path = bbs.netdir() / "p1.net";
+  if (!write_net_packets(path, num, 2048)) {
+    state.SkipWithError("Unable to write packets");
+    return;
+  }
+  for (auto _ : state) {
+    File f(path);
+    if (!f.Open(File::modeBinary | File::modeReadOnly)) {
+      state.SkipWithError("Unable to open packets");
+      break;
+    }
+    for (;;) {
+      auto [packet, response] = read_packet(f, false);
+      if (response != ReadNetPacketResponse::OK) {
+        break;
+      }
+      benchmark::DoNotOptimize(packet);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_ReadPacket)->Arg(1000)->Arg(10000);
+
+// Same as BM_ReadPacket using a memory mapped NetMailFileView.
+static void BM_ReadPacketView(benchmark::State& state) {
+  const BenchBbs bbs("read_packet_view");
+  const auto num = scaled(state.range(0));
+  const auto path = bbs.netdir() / "p1.net";
+  if (!write_net_packets(path, num, 2048)) {
+    state.SkipWithError("Unable to write packets");
+    return;
+  }
+  for (auto _ : state) {
+    NetMailFileView file(path, false);
+    if (!file) {
+      state.SkipWithError("Unable to open packets");
+      break;
+    }
+    for (const auto& packet : file) {
+      benchmark::DoNotOptimize(packet);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_ReadPacketView)->Arg(1000)->Arg(10000);
+
+// Reads every message of a FidoNet packet holding range(0) messages of 2k each.
+static void BM_FidoPacket_Read(benchmark::State& state) {
+  const BenchBbs bbs("fido_packet");
+  const auto num = scaled(state.range(0));
+  const auto path = bbs.netdir() / "00000001.pkt";
+  if (!write_fido_packet(path, num, 2048)) {
+    state.SkipWithError("Unable to write packet");
+    return;
+  }
+  for (auto _ : state) {
+    auto packet = FidoPacket::Open(path);
+    if (!packet) {
+      state.SkipWithError("Unable to open packet");
+      break;
+    }
+    for (;;) {
+      auto [response, msg] = packet->Read();
+      if (response != ReadNetPacketResponse::OK) {
+        break;
+      }
+      benchmark::DoNotOptimize(msg);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_FidoPacket_Read)->Arg(1000)->Arg(10000);
+
+// Loads a nodelist of range(0) nets with 100 nodes each.
+static void BM_Nodelist_Load(benchmark::State& state) {
+  const BenchBbs bbs("nodelist");
+  const auto num_nets = scaled(state.range(0));
+  const auto path = bbs.netdir() / "nodelist.001";
+  if (!write_nodelist(path, num_nets, 100)) {
+    state.SkipWithError("Unable to write nodelist");
+    return;
+  }
+  for (auto _ : state) {
+    const Nodelist nl(path, "");
+    benchmark::DoNotOptimize(nl.initialized());
+  }
+  state.SetItemsProcessed(state.iterations() * num_nets * 101);
+}
+BENCHMARK(BM_Nodelist_Load)->Arg(10)->Arg(100);
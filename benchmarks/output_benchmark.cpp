@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "benchmarks/bench_helper.h"
+#include "common/context.h"
+#include "common/macro_context.h"
+#include "common/null_remote_io.h"
+#include "common/output.h"
+#include "local_io/null_local_io.h"
+#include "sdk/chains.h"
+#include "sdk/user.h"
+
+#include "benchmark/benchmark.h"
+#include <string>
+#include <vector>
+
+using namespace wwiv::benchmarks;
+using namespace wwiv::common;
+using namespace wwiv::local::io;
+using namespace wwiv::sdk;
+
+namespace {
+
+class BenchContext final : public Context {
+public:
+  BenchContext(Config& config, LocalIO* local_io)
+      : config_(config), sess_ctx_(local_io), chains_(config) {
+    User::CreateNewUserRecord(&user_, 50, 20, 0, 0.1234f, {7, 11, 14, 13, 31, 10, 12, 9, 5, 3},
+                              {7, 15, 15, 15, 112, 15, 15, 7, 7, 7});
+    user_.set_flag(User::flag_ansi);
+    user_.set_flag(User::status_color);
+  }
+  [[nodiscard]] Config& config() override { return config_; }
+  [[nodiscard]] User& u() override { return user_; }
+  SessionContext& session_context() override { return sess_ctx_; }
+  [[nodiscard]] bool mci_enabled() const override { return true; }
+  [[nodiscard]] const std::vector<editorrec>& editors() const override { return editors_; }
+  [[nodiscard]] const Chains& chains() const override { return chains_; }
+
+private:
+  Config& config_;
+  User user_{};
+  SessionContext sess_ctx_;
+  std::vector<editorrec> editors_;
+  Chains chains_;
+};
+
+// Pipe codes are all this benchmark uses, so macros expand to nothing.
+class BenchMacroContext final : public MacroContext {
+public:
+  explicit BenchMacroContext(Context* context) : MacroContext(context) {}
+  [[nodiscard]] std::string interpret_macro_char(char) const override { return {}; }
+  [[nodiscard]] Interpreted interpret_string(const std::string&) const override { return {}; }
+  [[nodiscard]] Interpreted evaluate_expression(const std::string&) const override { return {}; }
+};
+
+// bout is global, so everything it points at lives until exit.
+struct OutputBench {
+  OutputBench()
+      : bbs("outstr"), remote_io(&local_io), context(bbs.config(), &local_io),
+        macro_context(&context) {
+    bout.SetLocalIO(&local_io);
+    bout.SetComm(&remote_io);
+    bout.set_context_provider([this]() -> Context& { return context; });
+    bout.set_macro_context_provider([this]() -> MacroContext& { return macro_context; });
+    context.session_context().outcom(true);
+  }
+  BenchBbs bbs;
+  NullLocalIO local_io;
+  NullRemoteIO remote_io;
+  BenchContext context;
+  BenchMacroContext macro_context;
+};
+
+OutputBench& output_bench() {
+  static OutputBench bench;
+  return bench;
+}
+
+}  // namespace
+
+// Displays menu sized text full of pipe color codes.
+static void BM_Output_Outstr_PipeCodes(benchmark::State& state) {
+  output_bench();
+  std::string text;
+  for (auto i = 0; i < 24; i++) {
+    text.append("|#1[|#2").append(std::to_string(i)).append("|#1] |10Menu item |15text |#0\r\n");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(bout.outstr(text));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_Output_Outstr_PipeCodes);
@@ -0,0 +1,65 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "benchmarks/bench_helper.h"
+#include "common/value/uservalueprovider.h"
+#include "sdk/acs/acs.h"
+#include "sdk/names.h"
+#include "sdk/user.h"
+
+#include "benchmark/benchmark.h"
+#include <string>
+
+using namespace wwiv::benchmarks;
+using namespace wwiv::common::value;
+using namespace wwiv::sdk;
+using namespace wwiv::sdk::acs;
+
+// ACS expressions are checked for every menu item, sub and dir listed.
+static void BM_CheckAcs(benchmark::State& state) {
+  const BenchBbs bbs("acs");
+  User user{};
+  user.sl(50);
+  user.dsl(50);
+  user.set_name("SYSOP");
+  const slrec sl{};
+  const UserValueProvider provider(bbs.config(), user, user.sl(), sl);
+  const std::string expr = R"(user.sl >= 20 && (user.dsl > 200 || user.name == "SYSOP"))";
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(check_acs(bbs.config(), expr, &provider));
+  }
+}
+BENCHMARK(BM_CheckAcs);
+
+// Looks up users in a NAMES.LST of range(0) users. Half of the lookups are
+// for users that do not exist.
+static void BM_Names_FindUser(benchmark::State& state) {
+  const BenchBbs bbs("names");
+  const auto num = std::min(scaled(state.range(0)), 65000);
+  if (!write_names(bbs.datadir(), num)) {
+    state.SkipWithError("Unable to write names");
+    return;
+  }
+  Names names(bbs.config());
+  auto i = 0;
+  for (auto _ : state) {
+    const auto n = 1 + (i++ * 7919) % (2 * num);
+    benchmark::DoNotOptimize(names.FindUser(synthetic_user_name(n)));
+  }
+}
+BENCHMARK(BM_Names_FindUser)->Arg(1000)->Arg(30000);
@@ -29,6 +29,7 @@
 #include "core/file.h"
 #include "core/log.h"
 #include "core/os.h"
+#include "core/scope_exit.h"
 #include "core/socket_exceptions.h"
 #include "core/stl.h"
 #include "core/strings.h"
@@ -106,6 +107,13 @@ bool BinkP::process_opt(const std::string& opt) {
           LOG(INFO) << "       CRAM-MD5 disabled in net.ini; Using plain text passwords.";
         }
       }
+    } else if (s == "NR") {
+      if (config_->nr()) {
+        LOG(INFO) << "       Enabling NR mode";
+        nr_ = true;
+      } else {
+        LOG(INFO) << "       Not enabling NR mode (disabled in net.ini).";
+      }
     } else if (s == "CRC") {
       if (config_->crc()) {
         LOG(INFO) << "       Enabling CRC support";
@@ -171,6 +179,9 @@ bool BinkP::process_command(int16_t length, duration<double> d) {
   case BinkpCommands::M_GOT: {
     HandleFileGotRequest(s);
   } break;
+  case BinkpCommands::M_SKIP: {
+    HandleFileSkipRequest(s);
+  } break;
   case BinkpCommands::M_EOB: {
     eob_received_ = true;
   } break;
@@ -269,8 +280,10 @@ bool BinkP::process_frames(const std::function<bool()>& predicate, duration<doub
   try {
     while (!predicate()) {
       VLOG(3) << "       process_frames(pred)";
+      // Once we have the header, always wait up to 10s for the rest of the frame,
+      // even when d is 0, since a partial frame would leave us out of sync.
       if (const auto header = conn_->read_uint16(d); header & 0x8000) {
-        if (!process_command(header & 0x7fff, d)) {
+        if (!process_command(header & 0x7fff, seconds(10))) {
           // false return value means an error occurred.
           return false;
         }
@@ -295,20 +308,20 @@ bool BinkP::send_command_packet(uint8_t command_id, const std::string& data) {
     return false;
   }
   const auto size = 3 + size_int(data); /* header + command + data + null*/
-  const auto packet = std::make_unique<uint8_t[]>(size);
+  frame_.resize(size);
   // Actual packet size parameter does not include the size parameter itself.
   // And for sending a command this will be 2 less than our actual packet size.
   const auto packet_length = static_cast<uint16_t>(data.size() + sizeof(uint8_t)) | 0x8000;
   const uint8_t b0 = ((packet_length & 0xff00) >> 8) | 0x80;
   const uint8_t b1 = packet_length & 0x00ff;
 
-  auto* p = packet.get();
+  auto* p = frame_.data();
   *p++ = b0;
   *p++ = b1;
   *p++ = command_id;
   memcpy(p, data.data(), data.size());
 
-  conn_->send(packet.get(), size, seconds(3));
+  conn_->send(frame_.data(), size, seconds(3));
   if (command_id != BinkpCommands::M_PWD) {
     LOG(INFO) << "SEND:  " << BinkpCommands::command_id_to_name(command_id) << ": " << data;
   } else {
@@ -319,21 +332,21 @@ bool BinkP::send_command_packet(uint8_t command_id, const std::string& data) {
   return true;
 }
 
-bool BinkP::send_data_packet(const char* data, int packet_length) {
+char* BinkP::data_frame(int size) {
+  frame_.resize(size + 2);
+  return &frame_[2];
+}
+
+bool BinkP::send_data_frame(int packet_length) {
   if (!conn_->is_open()) {
     return false;
   }
   // for now assume everything fits within a single frame.
-  const std::unique_ptr<char[]> packet(new char[packet_length + 2]);
   packet_length &= 0x7fff;
-  uint8_t b0 = ((packet_length & 0xff00) >> 8);
-  uint8_t b1 = packet_length & 0x00ff;
-  auto* p = packet.get();
-  *p++ = b0;
-  *p++ = b1;
-  memcpy(p, data, packet_length);
+  frame_[0] = static_cast<char>((packet_length & 0xff00) >> 8);
+  frame_[1] = static_cast<char>(packet_length & 0x00ff);
 
-  conn_->send(packet.get(), packet_length + 2, seconds(10));
+  conn_->send(frame_.data(), packet_length + 2, seconds(10));
   VLOG(3) << "SEND:  data packet: packet_length: " << packet_length;
   return true;
 }
@@ -370,6 +383,9 @@ BinkState BinkP::WaitConn() {
   if (config_->crc()) {
     send_command_packet(BinkpCommands::M_NUL, "OPT CRC");
   }
+  if (config_->nr()) {
+    send_command_packet(BinkpCommands::M_NUL, "OPT NR");
+  }
 
   std::string network_addresses;
   if (side_ == BinkSide::ANSWERING) {
@@ -631,10 +647,8 @@ BinkState BinkP::TransferFiles() {
   }
 
   VLOG(1) << "STATE: After SendFilePacket for all files.";
-  // Quickly let the inbound event loop percolate.
-  for (auto i = 0; i < 5; i++) {
-    process_frames(milliseconds(500));
-  }
+  // Wait for the M_GOT for every file we sent.
+  process_frames([&]() -> bool { return files_to_send_.empty(); }, seconds(5));
 
   // TODO(rushfan): Should this be in a new state?
   if (files_to_send_.empty()) {
@@ -701,33 +715,89 @@ bool BinkP::SendFilePacket(TransferFile* file) {
   const auto filename(file->filename());
   VLOG(1) << "       SendFilePacket: " << filename;
   files_to_send_[filename] = std::unique_ptr<TransferFile>(file);
-  send_command_packet(BinkpCommands::M_FILE, file->as_packet_data(0));
-  process_frames(seconds(2));
+  if (nr_) {
+    // In NR mode the other side answers with an M_GET for the offset it wants,
+    // and HandleFileGetRequest sends the data from there.
+    send_command_packet(BinkpCommands::M_FILE, file->as_packet_data(-1));
+    process_frames(
+        [&]() -> bool {
+          return contains(files_started_, filename) || !contains(files_to_send_, filename);
+        },
+        seconds(30));
+    LOG_IF(!contains(files_started_, filename) && contains(files_to_send_, filename), ERROR)
+        << "       No M_GET received for: " << filename;
+    return true;
+  }
+
+  // Don't wait for a reply, an M_GET, M_GOT or M_SKIP for this file is handled
+  // while the data is being sent.
+  return SendFileData(filename, 0);
+}
 
-  // file* may not be viable anymore if it was already send.
-  if (contains(files_to_send_, filename)) {
-    // We have the file still to send.
-    SendFileData(file);
+bool BinkP::has_file_to_send(const std::string& filename) const {
+  return contains(files_to_send_, filename);
+}
+
+bool BinkP::SendFileData(const std::string& filename, long offset) {
+  file_get_requests_[filename] = offset;
+  if (sending_file_data_) {
+    // We were called while processing frames from StreamFile, the loop below
+    // will pick this up.
+    return true;
   }
-  return true;
+  sending_file_data_ = true;
+  auto on_exit = finally([this] { sending_file_data_ = false; });
+  auto result = true;
+  while (!file_get_requests_.empty()) {
+    const auto [name, start] = *std::begin(file_get_requests_);
+    file_get_requests_.erase(std::begin(file_get_requests_));
+    if (!StreamFile(name, start)) {
+      result = false;
+    }
+  }
+  return result;
 }
 
-bool BinkP::SendFileData(TransferFile* file) {
-  VLOG(1) << "       SendFileData: " << file->filename();
-  const auto file_length = file->file_size();
+bool BinkP::StreamFile(const std::string& filename, long offset) {
+  VLOG(1) << "       SendFileData: " << filename << "; offset: " << offset;
+  files_started_.insert(filename);
   const auto chunk_size = 16384; // This is 1<<14.  The max per spec is (1 << 15) - 1
-  const auto chunk = std::make_unique<char[]>(chunk_size);
-  for (long start = 0; start < file_length; start += chunk_size) {
+  auto start = std::max<long>(0, offset);
+  auto send_file_command = true;
+  for (;;) {
+    // Look the file up each time, processing frames may have removed it.
+    const auto iter = files_to_send_.find(filename);
+    if (iter == std::end(files_to_send_)) {
+      // M_GOT or M_SKIP received, the other side doesn't want the rest.
+      return true;
+    }
+    auto* file = iter->second.get();
+    if (send_file_command) {
+      // Tell the other side where the data that follows starts.
+      send_command_packet(BinkpCommands::M_FILE, file->as_packet_data(static_cast<int>(start)));
+      send_file_command = false;
+    }
+    const long file_length = file->file_size();
+    if (start >= file_length) {
+      return true;
+    }
     const auto size = std::min<int>(chunk_size, file_length - start);
-    if (!file->GetChunk(chunk.get(), start, size)) {
-      // Bad chunk. Abort
+    if (!file->GetChunk(data_frame(size), start, size)) {
+      LOG(ERROR) << "       Unable to read: " << filename << " at offset: " << start;
+      return false;
+    }
+    send_data_frame(size);
+    start += size;
+    // Handle any inbound frames that have already arrived without waiting for
+    // more, so the data frames go out back to back.
+    process_frames(seconds(0));
+    if (const auto get = file_get_requests_.find(filename); get != std::end(file_get_requests_)) {
+      // The other side wants us to start again from a new offset.
+      start = std::max<long>(0, get->second);
+      file_get_requests_.erase(get);
+      send_file_command = true;
     }
-    send_data_packet(chunk.get(), size);
-    // sending multi-chunk files was not reliable.  check after each frame if we have
-    // an inbound command.
-    process_frames(seconds(1));
   }
-  return true;
 }
 
 bool BinkP::HandlePassword(const std::string& password_line) {
@@ -773,6 +843,12 @@ bool BinkP::HandleFileRequest(const std::string& request_line) {
   auto* p = new ReceiveFile(received_transfer_file_factory_(net, filename), filename,
                             expected_length, timestamp, crc);
   current_receive_file_.reset(p);
+  if (starting_offset == -1) {
+    // NR mode, the sender waits for us to say where to start. We don't keep
+    // partially received files, so that's always the beginning.
+    send_command_packet(BinkpCommands::M_GET,
+                        fmt::format("{} {} {} 0", filename, expected_length, timestamp));
+  }
   return true;
 }
 
@@ -786,16 +862,12 @@ bool BinkP::HandleFileGetRequest(const std::string& request_line) {
   if (s.size() >= 4) {
     offset = to_number<long>(s.at(3));
   }
-  if (offset != 0) {
-    LOG(WARNING) << "offset specified in FileGetRequest.  We don't support offset != 0";
-  }
 
-  const auto iter = files_to_send_.find(filename);
-  if (iter == end(files_to_send_)) {
+  if (!contains(files_to_send_, filename)) {
     LOG(ERROR) << "File not found: " << filename;
     return false;
   }
-  return SendFileData(iter->second.get());
+  return SendFileData(filename, offset);
   // File was sent but wait until we receive M_GOT before we remove it from the list.
 }
 
@@ -829,6 +901,21 @@ bool BinkP::HandleFileGotRequest(const std::string& request_line) {
   return true;
 }
 
+bool BinkP::HandleFileSkipRequest(const std::string& request_line) {
+  LOG(INFO) << "       HandleFileSkipRequest: request_line: [" << request_line << "]";
+  const auto s = SplitString(request_line, " ");
+  const auto& filename = s.at(0);
+
+  const auto iter = files_to_send_.find(filename);
+  if (iter == end(files_to_send_)) {
+    LOG(ERROR) << "File not found: " << filename;
+    return false;
+  }
+  // The other side will take this file in a later session, so keep it around.
+  files_to_send_.erase(iter);
+  return true;
+}
+
 void BinkP::Run(const wwiv::core::CommandLine& cmdline) {
   const auto now = DateTime::now();
   config_->session_identifier(fmt::format("in-{}", now.to_time_t()));
@@ -30,7 +30,9 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace wwiv::net {
   
@@ -77,9 +79,18 @@ public:
 
   void Run(const wwiv::core::CommandLine& cmdline);
 
-private:
-  // Process frames until we time out waiting for a new frame.
+  // The following are used by Run, and directly by tests.
+
+  // Takes ownership of file and sends it, along with any other files the
+  // remote asks for with M_GET while it is being sent.
+  bool SendFilePacket(TransferFile* file);
+  // Process frames until we time out waiting for a new frame. A duration of 0
+  // only processes the frames that have already arrived.
   bool process_frames(std::chrono::duration<double> d);
+  // True until the remote acknowledges filename with M_GOT or M_SKIP.
+  [[nodiscard]] bool has_file_to_send(const std::string& filename) const;
+
+private:
   // Process frames until predicate is satisfied (returns true) or we time out waiting
   // for a new frame.
   bool process_frames(const std::function<bool()>& predicate, std::chrono::duration<double> d);
@@ -89,7 +100,10 @@ private:
   bool process_data(int16_t length, std::chrono::duration<double> d);
 
   bool send_command_packet(uint8_t command_id, const std::string& data);
-  bool send_data_packet(const char* data, int size);
+  // Returns where to put size bytes of data for the next send_data_frame.
+  char* data_frame(int size);
+  // Sends the data frame filled in after data_frame(size).
+  bool send_data_frame(int size);
 
   void process_network_files(const wwiv::core::CommandLine& cmdline) const;
 
@@ -108,10 +122,14 @@ private:
   BinkState WaitEob();
   BinkState Unknown();
   BinkState FatalError();
-  bool SendFilePacket(TransferFile* file);
-  bool SendFileData(TransferFile* file);
+  // Sends filename starting at offset, along with any other files requested
+  // by M_GET while sending.
+  bool SendFileData(const std::string& filename, long offset);
+  // Sends M_FILE for filename with offset and then its data from there.
+  bool StreamFile(const std::string& filename, long offset);
   bool HandleFileGetRequest(const std::string& request_line);
   bool HandleFileGotRequest(const std::string& request_line);
+  bool HandleFileSkipRequest(const std::string& request_line);
   bool HandlePassword(const std::string& password_line);
   bool HandleFileRequest(const std::string& request_line);
 
@@ -122,6 +140,13 @@ private:
   bool ok_received_ = false;
   bool eob_received_ = false;
   std::map<std::string, std::unique_ptr<TransferFile>> files_to_send_;
+  // Offsets requested by M_GET for files to send, see SendFileData.
+  std::map<std::string, long> file_get_requests_;
+  // Files which we have started to send data for.
+  std::set<std::string> files_started_;
+  bool sending_file_data_ = false;
+  // Reused for every frame sent.
+  std::vector<char> frame_;
   BinkSide side_;
   const std::string expected_remote_node_;
   std::string remote_password_;
@@ -136,6 +161,8 @@ private:
   // Auth type used.
   AuthType auth_type_ = AuthType::PLAIN_TEXT;
   bool crc_ = false;
+  // Both sides support non-reliable mode.
+  bool nr_ = false;
 
   std::unique_ptr<FileManager> file_manager_;
   Remote remote_;
@@ -69,6 +69,13 @@ public:
   [[nodiscard]] int network_version() const { return network_version_; }
   [[nodiscard]] bool crc() const { return crc_; }
   [[nodiscard]] bool cram_md5() const { return cram_md5_; }
+  /**
+   * Use binkp's non-reliable (NR) mode so the receiver picks the offset to
+   * resume from. Set from "nr" in net.ini, which may be set per network in
+   * the [networkb-<network name>] section, for peers that mishandle it.
+   */
+  [[nodiscard]] bool nr() const { return nr_; }
+  void set_nr(bool nr) { nr_ = nr; }
   [[nodiscard]] const sdk::Config& config() const { return config_; }
 
   [[nodiscard]] std::string session_identifier() const { return session_identifier_; }
@@ -94,6 +101,7 @@ private:
   int network_version_{38};
   bool crc_{true};
   bool cram_md5_{true};
+  bool nr_{true};
   std::string session_identifier_;
 };
 
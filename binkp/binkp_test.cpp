@@ -21,13 +21,17 @@
 #include "binkp/transfer_file.h"
 #include "binkp/fake_connection.h"
 #include "core/file.h"
+#include "core/stl.h"
 #include "core/strings.h"
 #include "core/test/file_helper.h"
 #include "sdk/net/callout.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <chrono>
+#include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 using wwiv::sdk::Callout;
 using namespace wwiv::core;
@@ -87,6 +91,144 @@ TEST_F(BinkTest, ErrorAbortsSession) {
   }
 }
 
+class BinkSendTest : public testing::Test {
+protected:
+  BinkSendTest() : conn_(true) {
+    CHECK(files_.Mkdir("network"));
+    CHECK(files_.Mkdir("gfiles"));
+    wwiv::sdk::config_t wwiv_config{};
+    wwiv_config.systemname = "Test System";
+    wwiv_config.sysopname = "Test Sysop";
+    config_ = std::make_unique<wwiv::sdk::Config>(File::current_directory(), wwiv_config);
+    config_->gfilesdir(files_.DirName("gfiles"));
+    binkp_config_ =
+        std::make_unique<BinkConfig>(ORIGINATING_ADDRESS, *config_, files_.DirName("network"));
+    binkp_ = std::make_unique<BinkP>(&conn_, binkp_config_.get(), BinkSide::ORIGINATING,
+                                     ANSWERING_ADDRESS, factory_);
+    for (auto i = 0; i < 40000; i++) {
+      contents_.push_back(static_cast<char>('a' + i % 26));
+    }
+  }
+
+  // Returns every frame sent so far.
+  std::vector<FakeBinkpPacket> SentPackets() {
+    std::vector<FakeBinkpPacket> packets;
+    while (conn_.has_sent_packets()) {
+      packets.push_back(conn_.GetNextPacket());
+    }
+    return packets;
+  }
+
+  // Returns the data of the data frames in packets, starting at first.
+  static std::string Data(const std::vector<FakeBinkpPacket>& packets, int first) {
+    std::string data;
+    for (auto i = first; i < wwiv::stl::ssize(packets) && !packets[i].is_command(); i++) {
+      data += packets[i].data();
+    }
+    return data;
+  }
+
+  bool SendFile() {
+    return binkp_->SendFilePacket(new InMemoryTransferFile("a.net", contents_, 1000));
+  }
+
+  wwiv::core::test::FileHelper files_;
+  FakeConnection conn_;
+  std::unique_ptr<wwiv::sdk::Config> config_;
+  std::unique_ptr<BinkConfig> binkp_config_;
+  BinkP::received_transfer_file_factory_t factory_ = [](const std::string&,
+                                                        const std::string& filename) {
+    return new InMemoryTransferFile(filename, "");
+  };
+  std::unique_ptr<BinkP> binkp_;
+  std::string contents_;
+};
+
+TEST_F(BinkSendTest, StreamsDataFrames) {
+  ASSERT_TRUE(SendFile());
+
+  const auto packets = SentPackets();
+  ASSERT_EQ(4u, packets.size());
+  ASSERT_TRUE(packets[0].is_command());
+  EXPECT_EQ(BinkpCommands::M_FILE, packets[0].command());
+  EXPECT_TRUE(starts_with(packets[0].command_data(), "a.net 40000 1000 0 "))
+      << packets[0].command_data();
+  EXPECT_EQ(16384, packets[1].header());
+  EXPECT_EQ(16384, packets[2].header());
+  EXPECT_EQ(40000 - 2 * 16384, packets[3].header());
+  EXPECT_EQ(contents_, Data(packets, 1));
+
+  // The file is kept until the other side says it got it.
+  EXPECT_TRUE(binkp_->has_file_to_send("a.net"));
+  conn_.ReplyCommand(BinkpCommands::M_GOT, "a.net 40000 1000");
+  binkp_->process_frames(std::chrono::seconds(0));
+  EXPECT_FALSE(binkp_->has_file_to_send("a.net"));
+}
+
+TEST_F(BinkSendTest, Get_ResumesFromOffset) {
+  // Processed after the first data frame is sent.
+  conn_.ReplyCommand(BinkpCommands::M_GET, "a.net 40000 1000 20000");
+  ASSERT_TRUE(SendFile());
+
+  const auto packets = SentPackets();
+  ASSERT_EQ(5u, packets.size());
+  EXPECT_TRUE(starts_with(packets[0].command_data(), "a.net 40000 1000 0 "));
+  EXPECT_EQ(contents_.substr(0, 16384), packets[1].data());
+  ASSERT_TRUE(packets[2].is_command());
+  EXPECT_EQ(BinkpCommands::M_FILE, packets[2].command());
+  EXPECT_TRUE(starts_with(packets[2].command_data(), "a.net 40000 1000 20000 "))
+      << packets[2].command_data();
+  EXPECT_EQ(contents_.substr(20000), Data(packets, 3));
+}
+
+TEST_F(BinkSendTest, Skip_StopsSending) {
+  conn_.ReplyCommand(BinkpCommands::M_SKIP, "a.net 40000 1000");
+  ASSERT_TRUE(SendFile());
+
+  const auto packets = SentPackets();
+  ASSERT_EQ(2u, packets.size());
+  EXPECT_EQ(BinkpCommands::M_FILE, packets[0].command());
+  EXPECT_FALSE(packets[1].is_command());
+  EXPECT_FALSE(binkp_->has_file_to_send("a.net"));
+}
+
+TEST_F(BinkSendTest, NR_WaitsForGet) {
+  conn_.ReplyCommand(BinkpCommands::M_NUL, "OPT NR");
+  binkp_->process_frames(std::chrono::seconds(0));
+  conn_.ReplyCommand(BinkpCommands::M_GET, "a.net 40000 1000 30000");
+  ASSERT_TRUE(SendFile());
+
+  const auto packets = SentPackets();
+  ASSERT_EQ(3u, packets.size());
+  EXPECT_TRUE(starts_with(packets[0].command_data(), "a.net 40000 1000 -1 "))
+      << packets[0].command_data();
+  EXPECT_TRUE(starts_with(packets[1].command_data(), "a.net 40000 1000 30000 "))
+      << packets[1].command_data();
+  EXPECT_EQ(contents_.substr(30000), Data(packets, 2));
+}
+
+TEST_F(BinkSendTest, NR_DisabledInConfig) {
+  binkp_config_->set_nr(false);
+  conn_.ReplyCommand(BinkpCommands::M_NUL, "OPT NR");
+  binkp_->process_frames(std::chrono::seconds(0));
+  ASSERT_TRUE(SendFile());
+
+  const auto packets = SentPackets();
+  ASSERT_EQ(4u, packets.size());
+  EXPECT_TRUE(starts_with(packets[0].command_data(), "a.net 40000 1000 0 "));
+  EXPECT_EQ(contents_, Data(packets, 1));
+}
+
+TEST_F(BinkSendTest, NR_ReceiveAsksForStart) {
+  conn_.ReplyCommand(BinkpCommands::M_FILE, "b.net 5 1000 -1");
+  binkp_->process_frames(std::chrono::seconds(0));
+
+  const auto packets = SentPackets();
+  ASSERT_EQ(1u, packets.size());
+  EXPECT_EQ(BinkpCommands::M_GET, packets[0].command());
+  EXPECT_EQ("b.net 5 1000 0", packets[0].command_data());
+}
+
 static int node_number_from_address_list(const std::string& addresses,
                                          const std::string& network_name) {
   const auto a = ftn_address_from_address_list(addresses, network_name);
@@ -18,14 +18,13 @@
 #include "binkp/fake_connection.h"
 
 #include "core/os.h"
-#include "core/scope_exit.h"
 #include "core/socket_exceptions.h"
 #include "core/strings.h"
 #include "binkp/binkp_commands.h"
+#include "fmt/format.h"
 #include <chrono>
 #include <cstring>
 #include <iostream>
-#include <memory>
 #include <sstream>
 #include <stdexcept>
 
@@ -36,17 +35,16 @@ using namespace wwiv::strings;
 using namespace wwiv::net;
 
 FakeBinkpPacket::FakeBinkpPacket(const void* data, int size) {
-  auto p = static_cast<const char*>(data);
-  header_ = *p++ << 8;
-  header_ = header_ | *p++;
-  is_command_ = (header_ | 0x8000) != 0;
+  const auto* p = static_cast<const uint8_t*>(data);
+  header_ = static_cast<uint16_t>(p[0] << 8 | p[1]);
+  is_command_ = (header_ & 0x8000) != 0;
   header_ &= 0x7fff;
 
   if (is_command_) {
-    command_ = *p;
+    command_ = p[2];
   }
   // size doesn't include the uint16_t header.
-  data_ = std::string(p, size - 2);  
+  data_ = std::string(reinterpret_cast<const char*>(p + 2), size - 2);
 }
 
 FakeBinkpPacket::~FakeBinkpPacket() = default;
@@ -54,75 +52,55 @@ FakeBinkpPacket::~FakeBinkpPacket() = default;
 FakeBinkpPacket::FakeBinkpPacket(const FakeBinkpPacket& o)
     : is_command_(o.is_command_), command_(o.command_), header_(o.header_), data_(o.data_) {}
 
+std::string FakeBinkpPacket::command_data() const {
+  return is_command_ && !data_.empty() ? data_.substr(1) : std::string();
+}
 
 std::string FakeBinkpPacket::debug_string() const {
   // since data_ doesn't have a trailing nullptr, use stringstream.
   std::stringstream ss;
   if (is_command_) {
-    const auto s = !data_.empty() ? data_.substr(1) : data_;
-    ss << "[" << BinkpCommands::command_id_to_name(command_) << "] data ='" << s << "'";
+    ss << "[" << BinkpCommands::command_id_to_name(command_) << "] data ='" << command_data() << "'";
   } else {
     ss << "[DATA] data = '" << data_ << "'";
   }
   return ss.str();
 }
 
-FakeConnection::FakeConnection() = default;
+FakeConnection::FakeConnection(bool open) : open_(open) {}
 FakeConnection::~FakeConnection() = default;
 
-uint16_t FakeConnection::read_uint16(std::chrono::duration<double> d) {
-  auto predicate = [&]() { 
+std::string FakeConnection::read(int size, duration<double> d) {
+  auto predicate = [&]() {
     std::lock_guard<std::mutex> lock(mu_);
-    return !receive_queue_.empty();
+    return ssize(receive_buffer_) >= size;
   };
   if (!wait_for(predicate, d)) {
-    throw timeout_error("timedout on read_uint16");
+    throw timeout_error(fmt::format("timedout reading {} bytes", size));
   }
   std::lock_guard<std::mutex> lock(mu_);
-  const auto& packet = receive_queue_.front();
-  auto header = packet.header();
-  if (packet.is_command()) {
-    header |= 0x8000;
-  }
-  return header;
+  auto result = receive_buffer_.substr(0, size);
+  receive_buffer_.erase(0, size);
+  return result;
 }
 
-uint8_t FakeConnection::read_uint8(std::chrono::duration<double> d) {
-  auto predicate = [&]() { 
-    std::lock_guard<std::mutex> lock(mu_);
-    return !receive_queue_.empty();
-  };
-  if (!wait_for(predicate, d)) {
-    throw timeout_error("timedout on read_uint8");
-  }
+uint16_t FakeConnection::read_uint16(std::chrono::duration<double> d) {
+  const auto s = read(2, d);
+  return static_cast<uint16_t>(static_cast<uint8_t>(s[0]) << 8 | static_cast<uint8_t>(s[1]));
+}
 
-  std::lock_guard<std::mutex> lock(mu_);
-  const FakeBinkpPacket& front = receive_queue_.front();
-  if (!front.is_command()) {
-    throw std::logic_error("called read_uint8 on a data packet");
-  }
-  return front.command();
+uint8_t FakeConnection::read_uint8(std::chrono::duration<double> d) {
+  return static_cast<uint8_t>(read(1, d).front());
 }
 
 int FakeConnection::receive(void* data, int size, duration<double> d) {
-  std::string s = receive(size, d);
+  const auto s = read(size, d);
   memcpy(data, s.data(), size);
   return size;
 }
 
-std::string FakeConnection::receive(int, duration<double> d) {
-  auto predicate = [&]() {
-    std::lock_guard<std::mutex> lock(mu_);
-    return !receive_queue_.empty();
-  };
-  if (!wait_for(predicate, d)) {
-    throw timeout_error("timedout on receive");
-  }
-
-  std::lock_guard<std::mutex> lock(mu_);
-  auto on_exit = finally([=] { receive_queue_.pop(); });
-  const FakeBinkpPacket& front = receive_queue_.front();
-  return front.data();
+std::string FakeConnection::receive(int size, duration<double> d) {
+  return read(size, d);
 }
 
 int FakeConnection::send(const void* data, int size, std::chrono::duration<double>) {
@@ -153,23 +131,17 @@ FakeBinkpPacket FakeConnection::GetNextPacket() {
 
 // Reply to the BinkP with a command.
 void FakeConnection::ReplyCommand(int8_t command_id, const std::string& data) {
-  const int size = 3u + data.size(); /* header + command + data + null*/
-  std::unique_ptr<char[]> packet(new char[size]);
   // Actual packet size parameter does not include the size parameter itself.
-  // And for sending a command this will be 2 less than our actual packet size.
   const uint16_t packet_length = static_cast<uint16_t>(data.size() + sizeof(uint8_t)) | 0x8000;
-  const uint8_t b0 = ((packet_length & 0xff00) >> 8) | 0x80;
-  const uint8_t b1 = packet_length & 0x00ff;
-
-  auto* p = packet.get();
-  *p++ = b0;
-  *p++ = b1;
-  *p++ = command_id;
-  memcpy(p, data.data(), data.size());  // NOLINT(bugprone-not-null-terminated-result)
+  std::string packet;
+  packet.push_back(static_cast<char>(packet_length >> 8));
+  packet.push_back(static_cast<char>(packet_length & 0xff));
+  packet.push_back(static_cast<char>(command_id));
+  packet.append(data);
 
   std::lock_guard<std::mutex> lock(mu_);
-  receive_queue_.push(FakeBinkpPacket(packet.get(), size));
+  receive_buffer_.append(packet);
 }
 
 bool FakeConnection::is_open() const { return open_; }
-bool FakeConnection::close() { open_ = false; return true; }
\ No newline at end of file
+bool FakeConnection::close() { open_ = false; return true; }
@@ -34,14 +34,17 @@ public:
   [[nodiscard]] bool is_command() const { return is_command_; }
   [[nodiscard]] uint8_t command() const { return command_; }
   [[nodiscard]] uint16_t header() const { return header_; }
+  // Everything after the header, for commands this starts with the command id.
   [[nodiscard]] std::string data() const { return data_; }
+  // The command's argument string, without the command id.
+  [[nodiscard]] std::string command_data() const;
 
   [[nodiscard]] std::string debug_string() const;
 
 private:
-  bool is_command_;
-  uint8_t command_;
-  uint16_t header_;
+  bool is_command_{false};
+  uint8_t command_{0};
+  uint16_t header_{0};
   std::string data_;
 };
 
@@ -49,7 +52,7 @@ class FakeConnection : public wwiv::core::Connection
 {
 public:
   // Connection implementation.
-  FakeConnection();
+  explicit FakeConnection(bool open = false);
   virtual ~FakeConnection();
 
   int receive(void* data, int size, std::chrono::duration<double> d) override;
@@ -64,15 +67,20 @@ public:
 
   bool has_sent_packets() const;
   FakeBinkpPacket GetNextPacket();
+  // Queues a command frame to be read by the other side.
   void ReplyCommand(int8_t command_id, const std::string& data);
 
-  // GUARDED_BY(mu_)
-  std::queue<FakeBinkpPacket> receive_queue_;
-  // GUARDED_BY(mu_)
-  std::queue<FakeBinkpPacket> send_queue_;
 private:
+  // Waits up to d for size bytes to be in receive_buffer_ and removes them.
+  std::string read(int size, std::chrono::duration<double> d);
+
   mutable std::mutex mu_;
+  // Bytes of the frames queued by ReplyCommand and ReplyData, read like a
+  // socket one field at a time. GUARDED_BY(mu_)
+  std::string receive_buffer_;
+  // Each frame sent. GUARDED_BY(mu_)
+  std::queue<FakeBinkpPacket> send_queue_;
   bool open_{};
 };
 
-#endif
\ No newline at end of file
+#endif
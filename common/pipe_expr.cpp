@@ -23,7 +23,8 @@
 #include "common/value/uservalueprovider.h"
 #include "core/log.h"
 #include "sdk/acs/acs.h"
-#include "sdk/acs/eval.h"
+#include "sdk/acs/compiled_expression.h"
+#include "sdk/acs/eval_error.h"
 #include "sdk/value/valueprovider.h"
 
 using namespace wwiv::core;
@@ -301,21 +302,17 @@ static bool check_acs_pipe(const std::string& expression, const std::vector<std:
     return true;
   }
 
-  acs::Eval eval(expression);
   auto v = make_vector(args...);
-  for (const auto& vp : v) {
-    eval.add(vp);
-  }
-
   for (const auto& m : maps) {
-    eval.add(m.get());
+    v.push_back(m.get());
   }
 
-  const auto res = eval.eval();
-  if (eval.error()) {
-    LOG(WARNING) << eval.error_text();
+  try {
+    return acs::CompiledExpression::Get(expression)->eval_throws(v, nullptr);
+  } catch (const acs::eval_error& e) {
+    LOG(WARNING) << e.what();
   }
-  return res;
+  return false;
 }
 
 
@@ -40,6 +40,8 @@ typedef int socklen_t;
 #include "core/scope_exit.h"
 #include "core/strings.h"
 #include "fmt/printf.h"
+#include <cerrno>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <system_error>
@@ -54,6 +56,27 @@ using namespace wwiv::strings;
 
 // N.B. mutex and yield are defines in Solaris.
 
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif  // MSG_NOSIGNAL
+
+// Send buffered output once it reaches this size.
+static constexpr std::string::size_type OUTPUT_FLUSH_SIZE = 4096;
+// Most unsent output kept for a retry; anything past this is dropped.
+static constexpr std::string::size_type MAX_UNSENT_OUTPUT = 64 * 1024;
+
+// True if the last send failed because the connection is gone, rather than
+// something a later send may get past.
+static bool is_connection_lost() {
+#ifdef _WIN32
+  const auto err = WSAGetLastError();
+  return err == WSAECONNRESET || err == WSAECONNABORTED || err == WSAENOTCONN ||
+         err == WSAESHUTDOWN || err == WSAENOTSOCK;
+#else
+  return errno == EPIPE || errno == ECONNRESET || errno == ENOTCONN || errno == EBADF;
+#endif
+}
+
 struct socket_error final : std::runtime_error {
   explicit socket_error(const std::string& message) : std::runtime_error(message) {}
 };
@@ -131,9 +154,15 @@ void RemoteSocketIO::close(bool temporary) {
     // Early return on invalid sockets.
     return;
   }
-  if (!temporary) {
-    // this will stop the threads
-    closesocket(socket_);
+  {
+    // Hold out_mu_ so the write thread isn't sending while the socket closes.
+    std::lock_guard<std::mutex> lock(out_mu_);
+    // Anything still buffered must go out before a door takes over the socket.
+    flush_locked();
+    if (!temporary) {
+      // this will stop the threads
+      closesocket(socket_);
+    }
   }
   StopThreads();
 }
@@ -144,22 +173,15 @@ unsigned int RemoteSocketIO::put(unsigned char ch) {
     return 0;
   }
 
-  unsigned char szBuffer[3] = {ch, 0, 0};
-  if (ch == TELNET_OPTION_IAC) {
-    szBuffer[1] = ch;
-  }
-
-  const auto num_sent = send(socket_, reinterpret_cast<char*>(szBuffer), ssize(szBuffer), 0);
-  if (num_sent == SOCKET_ERROR) {
-    return 0;
-  }
-  return num_sent;
+  const auto c = static_cast<char>(ch);
+  return buffer_output(&c, 1, true);
 }
 
 unsigned char RemoteSocketIO::getW() {
   if (!valid_socket()) {
     return 0;
   }
+  flush();
   char ch = 0;
   std::lock_guard<std::mutex> lock(mu_);
   if (!queue_.empty()) {
@@ -175,8 +197,9 @@ bool RemoteSocketIO::disconnect() {
     return false;
   }
 
-  closesocket(socket_);
-  socket_ = INVALID_SOCKET;
+  std::lock_guard<std::mutex> lock(out_mu_);
+  flush_locked();
+  close_socket_locked();
   return true;
 }
 
@@ -196,6 +219,7 @@ unsigned int RemoteSocketIO::read(char* buffer, unsigned int count) {
     return 0;
   }
 
+  flush();
   unsigned int num_read = 0;
   auto* temp = buffer;
 
@@ -217,35 +241,87 @@ unsigned int RemoteSocketIO::write(const char* buffer, unsigned int count, bool
   if (!valid_socket()) {
     return 0;
   }
+  return buffer_output(buffer, count, !no_translation);
+}
 
-  const auto tmp_buffer = std::make_unique<char[]>(count * 2 + 100);
-  memset(tmp_buffer.get(), 0, count * 2 + 100);
-  int nCount = count;
+void RemoteSocketIO::flush() {
+  std::lock_guard<std::mutex> lock(out_mu_);
+  flush_locked();
+}
 
-  if (no_translation || !memchr(buffer, CHAR_TELNET_OPTION_IAC, count)) {
-    memcpy(tmp_buffer.get(), buffer, count);
-  } else {
+unsigned int RemoteSocketIO::buffer_output(const char* data, unsigned int count,
+                                           bool escape_iac) {
+  std::lock_guard<std::mutex> lock(out_mu_);
+  const auto start = out_.size();
+  if (escape_iac && memchr(data, CHAR_TELNET_OPTION_IAC, count)) {
     // If there is a #255 then escape the #255's
-    const auto* p = buffer;
-    auto* p2 = tmp_buffer.get();
     for (unsigned int i = 0; i < count; i++) {
-      if (*p == CHAR_TELNET_OPTION_IAC && !no_translation) {
-        *p2++ = CHAR_TELNET_OPTION_IAC;
-        *p2++ = CHAR_TELNET_OPTION_IAC;
-        nCount++;
-      } else {
-        *p2++ = *p;
+      if (data[i] == CHAR_TELNET_OPTION_IAC) {
+        out_.push_back(CHAR_TELNET_OPTION_IAC);
       }
-      p++;
+      out_.push_back(data[i]);
     }
-    *p2 = '\0';
+  } else {
+    out_.append(data, count);
   }
+  const auto num = static_cast<unsigned int>(out_.size() - start);
 
-  const auto num_sent = send(socket_, tmp_buffer.get(), nCount, 0);
-  if (num_sent == SOCKET_ERROR) {
-    return 0;
+  if (!delayed_flush_.load() || out_.size() >= OUTPUT_FLUSH_SIZE ||
+      (!binary_mode() && memchr(data, '\n', count))) {
+    // Anything not sent stays buffered for the next flush.
+    flush_locked();
+  }
+  if (start == 0) {
+    // Start the clock on sending this output.
+    out_cv_.notify_one();
+  }
+  return num;
+}
+
+bool RemoteSocketIO::flush_locked() {
+  std::string::size_type num_sent = 0;
+  while (num_sent < out_.size() && valid_socket()) {
+    const auto result =
+        send(socket_, out_.data() + num_sent, static_cast<int>(out_.size() - num_sent),
+             MSG_NOSIGNAL);
+    if (result == SOCKET_ERROR && is_connection_lost()) {
+      LOG(ERROR) << "Connection lost; dropping " << out_.size() - num_sent
+                 << " bytes of output.";
+      out_.clear();
+      send_failed_ = false;
+      return false;
+    }
+    if (result == SOCKET_ERROR || result == 0) {
+      break;
+    }
+    num_sent += result;
+  }
+  out_.erase(0, num_sent);
+  if (out_.empty()) {
+    send_failed_ = false;
+    return true;
+  }
+  if (!valid_socket()) {
+    // There's nowhere left to send it.
+    out_.clear();
+    return false;
+  }
+  if (out_.size() > MAX_UNSENT_OUTPUT) {
+    LOG(ERROR) << "Dropping " << out_.size() - MAX_UNSENT_OUTPUT << " bytes of unsent output.";
+    out_.resize(MAX_UNSENT_OUTPUT);
+  }
+  // Keep what wasn't sent so the next flush tries it again, and only log
+  // the first failure since the write thread retries every flush delay.
+  if (!send_failed_) {
+    LOG(ERROR) << "Unable to send " << out_.size() << " bytes of output; will retry.";
+    send_failed_ = true;
   }
-  return num_sent;
+  return false;
+}
+
+void RemoteSocketIO::set_output_flush_delay(std::chrono::milliseconds d) {
+  std::lock_guard<std::mutex> lock(out_mu_);
+  output_flush_delay_ = d;
 }
 
 bool RemoteSocketIO::connected() {
@@ -261,6 +337,9 @@ bool RemoteSocketIO::incoming() {
   if (!valid_socket()) {
     return false;
   }
+  // Callers poll this while waiting for input, so make sure the remote
+  // side has everything we have written before it replies.
+  flush();
 
   std::lock_guard<std::mutex> lock(mu_);
   return !queue_.empty();
@@ -272,11 +351,22 @@ void RemoteSocketIO::StopThreads() {
     if (!threads_started_) {
       return;
     }
-    stop_.store(true);
     threads_started_ = false;
   }
+  {
+    // Hold out_mu_ so that the write thread can not miss the wakeup.
+    std::lock_guard<std::mutex> lock(out_mu_);
+    stop_.store(true);
+    out_cv_.notify_all();
+  }
   os::yield();
 
+  if (write_thread_.joinable()) {
+    write_thread_.join();
+  }
+  delayed_flush_.store(false);
+  flush();
+
   // Wait for read thread to exit.
   if (!read_thread_.joinable()) {
     LOG(ERROR) << "read_thread_ is not JOINABLE.  Should not happen.";
@@ -301,6 +391,8 @@ void RemoteSocketIO::StartThreads() {
 
   stop_.store(false);
   read_thread_ = std::thread(&RemoteSocketIO::InboundTelnetProc, this);
+  delayed_flush_.store(true);
+  write_thread_ = std::thread(&RemoteSocketIO::OutboundProc, this);
 }
 
 RemoteSocketIO::~RemoteSocketIO() {
@@ -365,22 +457,42 @@ void RemoteSocketIO::InboundTelnetProc() {
       const auto num_read = recv(socket_, data.get(), size, 0);
       if (num_read == SOCKET_ERROR) {
         // Got Socket error.
-        closesocket(socket_);
-        socket_ = INVALID_SOCKET;
+        close_socket();
         return;
       }
       if (num_read == 0) {
         // The other side has gracefully closed the socket.
-        closesocket(socket_);
-        socket_ = INVALID_SOCKET;
+        close_socket();
         return;
       }
       AddStringToInputBuffer(0, num_read, data.get());
     }
   } catch (const socket_error& e) {
     LOG(ERROR) << "InboundTelnetProc exiting. Caught socket_error: " << e.what();
-    closesocket(socket_);
-    socket_ = INVALID_SOCKET;
+    close_socket();
+  }
+}
+
+void RemoteSocketIO::close_socket() {
+  std::lock_guard<std::mutex> lock(out_mu_);
+  close_socket_locked();
+}
+
+void RemoteSocketIO::close_socket_locked() {
+  closesocket(socket_);
+  socket_ = INVALID_SOCKET;
+}
+
+void RemoteSocketIO::OutboundProc() {
+  std::unique_lock<std::mutex> lock(out_mu_);
+  while (!stop_.load()) {
+    out_cv_.wait(lock, [this] { return stop_.load() || !out_.empty(); });
+    if (stop_.load()) {
+      return;
+    }
+    // Give the caller a moment to add more output before sending it.
+    out_cv_.wait_for(lock, output_flush_delay_, [this] { return stop_.load(); });
+    flush_locked();
   }
 }
 
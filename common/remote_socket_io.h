@@ -23,9 +23,12 @@
 #include "core/net.h" // INVALID_SOCKET
 #include "common/remote_io.h"
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <mutex>
 #include <deque>
+#include <string>
 #include <thread>
 
 #if defined( _WIN32 )
@@ -79,6 +82,10 @@ class RemoteSocketIO final : public RemoteIO {
   bool incoming() override;
   void StopThreads();
   void StartThreads();
+  /** Sends any buffered output to the socket now. */
+  void flush();
+  /** Sets how long output may wait in the buffer for more to be added. */
+  void set_output_flush_delay(std::chrono::milliseconds d);
   unsigned int GetHandle() const override;
   bool valid_socket() const { return (socket_ != INVALID_SOCKET); }
 
@@ -92,12 +99,40 @@ class RemoteSocketIO final : public RemoteIO {
 private:
   void HandleTelnetIAC(unsigned char nCmd, unsigned char nParam);
   void InboundTelnetProc();
+  void OutboundProc();
+  /**
+   * Adds count bytes from data to the output buffer (doubling any IACs when
+   * escape_iac is true), and sends the buffer if it is due to be sent.
+   */
+  unsigned int buffer_output(const char* data, unsigned int count, bool escape_iac);
+  /**
+   * Sends the output buffer, out_mu_ must be held. Returns false if it could
+   * not all be sent, in which case the rest (up to 64K) is kept for the next
+   * flush, unless the connection was lost and it is dropped.
+   */
+  bool flush_locked();
+  /** Closes the socket while holding out_mu_, so no send is in progress. */
+  void close_socket();
+  /** Closes the socket, out_mu_ must be held. */
+  void close_socket_locked();
 
   std::deque<char> queue_;
   mutable std::mutex mu_;
   mutable std::mutex threads_started_mu_;
   SOCKET socket_{INVALID_SOCKET};
   std::thread read_thread_;
+  // Output not yet sent. Written when it contains a newline, is large enough,
+  // before waiting for input, or by write_thread_ after a short delay.
+  std::string out_;
+  std::mutex out_mu_;
+  std::condition_variable out_cv_;
+  // How long write_thread_ lets output wait in out_ for more to be added.
+  std::chrono::milliseconds output_flush_delay_{10};
+  // True after a flush failed to send everything, until one succeeds.
+  bool send_failed_{false};
+  std::thread write_thread_;
+  // True while write_thread_ is running, otherwise output is sent right away.
+  std::atomic<bool> delayed_flush_{false};
   std::atomic<bool> stop_;
   bool threads_started_{false};
   bool telnet_{true};
@@ -21,9 +21,15 @@
 #include "gtest/gtest.h"
 #include "common/remote_socket_io.h"
 
+#include <chrono>
 #include <deque>
 #include <string>
 
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <unistd.h>
+#endif  // _WIN32
+
 using namespace wwiv::common;
 using namespace testing;
 
@@ -90,3 +96,98 @@ TEST(RemoteSocketIOTest, TwoFFAtEnd) {
 //  EXPECT_EQ(21, pos.value().x);
 //  EXPECT_EQ(12, pos.value().y);
 //}
+
+#ifndef _WIN32
+
+class RemoteSocketIOOutputTest : public testing::Test {
+public:
+  void SetUp() override { ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sv_)); }
+  void TearDown() override {
+    ::close(sv_[0]);
+    ::close(sv_[1]);
+  }
+
+  /** Returns whatever the remote side has received so far. */
+  std::string Received(int timeout_ms = 0) {
+    timeval tv{timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(sv_[1], &fds);
+    if (select(sv_[1] + 1, &fds, nullptr, nullptr, &tv) != 1) {
+      return {};
+    }
+    char buf[100];
+    const auto n = recv(sv_[1], buf, sizeof(buf), 0);
+    return n > 0 ? std::string(buf, n) : std::string();
+  }
+
+  int sv_[2]{};
+};
+
+TEST_F(RemoteSocketIOOutputTest, Put_SendsOneCharacter) {
+  RemoteSocketIO io(sv_[0], true);
+  io.put('a');
+  EXPECT_EQ("a", Received(1000));
+}
+
+TEST_F(RemoteSocketIOOutputTest, Put_EscapesIAC) {
+  RemoteSocketIO io(sv_[0], true);
+  io.put(0xff);
+  EXPECT_EQ("\xff\xff", Received(1000));
+}
+
+TEST_F(RemoteSocketIOOutputTest, Buffered_FlushOnNewline) {
+  RemoteSocketIO io(sv_[0], true);
+  // Long enough that only the newline can send the output.
+  io.set_output_flush_delay(std::chrono::hours(1));
+  io.StartThreads();
+  io.put('a');
+  EXPECT_EQ("", Received());
+  io.write("b\r\n", 3);
+  EXPECT_EQ("ab\r\n", Received(1000));
+  io.StopThreads();
+}
+
+TEST_F(RemoteSocketIOOutputTest, Buffered_FlushOnTimer) {
+  RemoteSocketIO io(sv_[0], true);
+  io.set_output_flush_delay(std::chrono::milliseconds(0));
+  io.StartThreads();
+  io.write("abc", 3);
+  EXPECT_EQ("abc", Received(1000));
+  io.StopThreads();
+}
+
+TEST_F(RemoteSocketIOOutputTest, Buffered_FlushOnStop) {
+  RemoteSocketIO io(sv_[0], true);
+  io.StartThreads();
+  io.set_binary_mode(true);
+  io.write("a\nb", 3, true);
+  io.StopThreads();
+  EXPECT_EQ("a\nb", Received());
+}
+
+TEST_F(RemoteSocketIOOutputTest, PeerClosed_DropsOutput) {
+  RemoteSocketIO io(sv_[0], true);
+  ::close(sv_[1]);
+  sv_[1] = -1;
+  // Each write fails with EPIPE, which drops the output instead of keeping it.
+  for (auto i = 0; i < 100; i++) {
+    io.write("abc\r\n", 5);
+  }
+  io.flush();
+  EXPECT_TRUE(io.disconnect());
+}
+
+TEST_F(RemoteSocketIOOutputTest, Disconnect_WhileBuffered) {
+  RemoteSocketIO io(sv_[0], true);
+  io.set_output_flush_delay(std::chrono::milliseconds(0));
+  io.StartThreads();
+  io.write("abc", 3);
+  EXPECT_TRUE(io.disconnect());
+  // disconnect closed the socket.
+  sv_[0] = -1;
+  EXPECT_EQ("abc", Received(1000));
+  io.StopThreads();
+}
+
+#endif  // _WIN32
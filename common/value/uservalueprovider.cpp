@@ -42,89 +42,103 @@ template <typename T> static std::optional<sdk::value::Value> val(T&& v) {
 
 UserValueProvider::UserValueProvider(Context& c, int effective_sl)
   : UserValueProvider(c.config(), c.u(), effective_sl, c.config().sl(effective_sl)) {
-  fns_.try_emplace("editorname", [&]() {
-    const auto editor_num = user_.default_editor();
+  has_editorname_ = true;
+}
+
+UserValueProvider::UserValueProvider(const sdk::Config& config, const sdk::User& user, int effective_sl,
+                                     slrec sl)
+  : ValueProvider("user"), config_(config), user_(user), effective_sl_(effective_sl), sl_(sl) {}
+
+// static
+const UserValueProvider::fns_t& UserValueProvider::fns() {
+  // Built once and shared by all instances, so that creating a provider for
+  // each ACS check is cheap.
+  static const auto fns = make_fns();
+  return fns;
+}
+
+// static
+UserValueProvider::fns_t UserValueProvider::make_fns() {
+  fns_t fns;
+  fns.try_emplace("editorname", [](const UserValueProvider& p) {
+    const auto editor_num = p.user_.default_editor();
     if (editor_num == 0xff) {
       return val("Full Screen");
     }
-    if (editor_num > 0 && editor_num <= stl::size_int(editors_)) {
-      return val(editors_[editor_num - 1].description);
+    if (editor_num > 0 && editor_num <= stl::size_int(p.editors_)) {
+      return val(p.editors_[editor_num - 1].description);
     }
     return val("Line");
   });
-}
-
-UserValueProvider::UserValueProvider(const sdk::Config& config, const sdk::User& user, int effective_sl,
-                                     slrec sl)
-  : ValueProvider("user"), config_(config), user_(user), effective_sl_(effective_sl), sl_(sl) {
-  fns_.try_emplace("sl", [&]() { return val(user_.sl()); });
-  fns_.try_emplace("dsl", [&]() { return val(user_.dsl()); });
-  fns_.try_emplace("age", [&]() { return val(user_.age()); });
-  fns_.try_emplace("ar", [&]() { return val(Ar(user_.ar_int(), true)); });
-  fns_.try_emplace("dar", [&]() { return val(Ar(user_.dar_int(), true)); });
-  fns_.try_emplace("name", [&]() { return val(user_.name()); });
-  fns_.try_emplace("real_name", [&]() { return val(user_.real_name_or_empty()); });
-  fns_.try_emplace("regnum", [&]() { return val(static_cast<int>(user_.wwiv_regnum())); });
-  fns_.try_emplace("registered", [&]() { return val(user_.wwiv_regnum() != 0); });
-  fns_.try_emplace("sysop", [&]() { return val(user_.sl() == 255); });
-  fns_.try_emplace("cosysop", [&]() {
-    const auto so = user_.sl() == 255;
-    const auto cs = (sl_.ability & ability_cosysop) != 0;
+  fns.try_emplace("sl", [](const UserValueProvider& p) { return val(p.user_.sl()); });
+  fns.try_emplace("dsl", [](const UserValueProvider& p) { return val(p.user_.dsl()); });
+  fns.try_emplace("age", [](const UserValueProvider& p) { return val(p.user_.age()); });
+  fns.try_emplace("ar", [](const UserValueProvider& p) { return val(Ar(p.user_.ar_int(), true)); });
+  fns.try_emplace("dar", [](const UserValueProvider& p) { return val(Ar(p.user_.dar_int(), true)); });
+  fns.try_emplace("name", [](const UserValueProvider& p) { return val(p.user_.name()); });
+  fns.try_emplace("real_name", [](const UserValueProvider& p) { return val(p.user_.real_name_or_empty()); });
+  fns.try_emplace("regnum", [](const UserValueProvider& p) { return val(static_cast<int>(p.user_.wwiv_regnum())); });
+  fns.try_emplace("registered", [](const UserValueProvider& p) { return val(p.user_.wwiv_regnum() != 0); });
+  fns.try_emplace("sysop", [](const UserValueProvider& p) { return val(p.user_.sl() == 255); });
+  fns.try_emplace("cosysop", [](const UserValueProvider& p) {
+    const auto so = p.user_.sl() == 255;
+    const auto cs = (p.sl_.ability & ability_cosysop) != 0;
     return val(so || cs);
   });
-  fns_.try_emplace("guest", [&]() { return val(user_.guest_user()); });
-  fns_.try_emplace("validated", [&]() { return val(effective_sl_ >= config_.validated_sl()); });
-  fns_.try_emplace("screenlines", [&]() { return val(user_.screen_lines()); });
-  fns_.try_emplace("screenwidth", [&]() { return val(user_.screen_width()); });
-  fns_.try_emplace("ansi", [&]() { return val(user_.ansi()); });
-  fns_.try_emplace("color", [&]() { return val(user_.color()); });
-  fns_.try_emplace("ansistr", [&]() { return val(
-    user_.ansi() ? (user_.color() ? "Color" : "Monochrome") : "No ANSI");
+  fns.try_emplace("guest", [](const UserValueProvider& p) { return val(p.user_.guest_user()); });
+  fns.try_emplace("validated", [](const UserValueProvider& p) { return val(p.effective_sl_ >= p.config_.validated_sl()); });
+  fns.try_emplace("screenlines", [](const UserValueProvider& p) { return val(p.user_.screen_lines()); });
+  fns.try_emplace("screenwidth", [](const UserValueProvider& p) { return val(p.user_.screen_width()); });
+  fns.try_emplace("ansi", [](const UserValueProvider& p) { return val(p.user_.ansi()); });
+  fns.try_emplace("color", [](const UserValueProvider& p) { return val(p.user_.color()); });
+  fns.try_emplace("ansistr", [](const UserValueProvider& p) { return val(
+    p.user_.ansi() ? (p.user_.color() ? "Color" : "Monochrome") : "No ANSI");
   });
-  fns_.try_emplace("pause", [&]() { return val(user_.pause()); });
-  fns_.try_emplace("mailbox_state", [&]() { return val(user_.mailbox_state()); });
-  fns_.try_emplace("extcolors", [&]() { return val(user_.extra_color()); });
-  fns_.try_emplace("optional_lines", [&]() { return val(user_.optional_val()); });
-  fns_.try_emplace("conferencing", [&]() { return val(user_.use_conference()); });
-  fns_.try_emplace("fs_reader", [&]()
+  fns.try_emplace("pause", [](const UserValueProvider& p) { return val(p.user_.pause()); });
+  fns.try_emplace("mailbox_state", [](const UserValueProvider& p) { return val(p.user_.mailbox_state()); });
+  fns.try_emplace("extcolors", [](const UserValueProvider& p) { return val(p.user_.extra_color()); });
+  fns.try_emplace("optional_lines", [](const UserValueProvider& p) { return val(p.user_.optional_val()); });
+  fns.try_emplace("conferencing", [](const UserValueProvider& p) { return val(p.user_.use_conference()); });
+  fns.try_emplace("fs_reader", [](const UserValueProvider& p)
   {
-    return val(user_.has_flag(User::fullScreenReader));
+    return val(p.user_.has_flag(User::fullScreenReader));
   });
-  fns_.try_emplace("email", [&]() { return val(user_.email_address()); });
-  fns_.try_emplace("ignore_msgs", [&]() { return val(user_.ignore_msgs()); });
-  fns_.try_emplace("clear_screen", [&]() { return val(user_.clear_screen()); });
-  fns_.try_emplace("auto_quote", [&]() { return val(user_.auto_quote()); });
-  fns_.try_emplace("protocol", [&]() { return val(user_.default_protocol()); });
-  fns_.try_emplace("callsign", [&]() { return val(user_.callsign()); });
-  fns_.try_emplace("street", [&]() { return val(user_.street()); });
-  fns_.try_emplace("city", [&]() { return val(user_.city()); });
-  fns_.try_emplace("state", [&]() { return val(user_.state()); });
-  fns_.try_emplace("zip_code", [&]() { return val(user_.zip_code()); });
-  fns_.try_emplace("last_ipaddress", [&]() { return val(user_.last_address().to_string()); });
-  fns_.try_emplace("last_bps", [&]() { return val(user_.last_bps()); });
-  fns_.try_emplace("laston", [&]() { return val(user_.laston()); });
-  fns_.try_emplace("voice_phone", [&]() { return val(user_.voice_phone()); });
-  fns_.try_emplace("data_phone", [&]() { return val(user_.data_phone()); });
-  fns_.try_emplace("gender", [&]() { return val(user_.gender()); });
-  fns_.try_emplace("menuset", [&]() { return val(user_.menu_set()); });
-  fns_.try_emplace("birthday_mmddyy", [&]() { return val(user_.birthday_mmddyy()); });
-  fns_.try_emplace("email_waiting", [&]() { return val(user_.email_waiting()); });
-  fns_.try_emplace("messages_posted", [&]() { return val(user_.messages_posted()); });
-  fns_.try_emplace("posts_today", [&]() { return val(user_.posts_today()); });
-  fns_.try_emplace("posts_net", [&]() { return val(user_.posts_net()); });
-  fns_.try_emplace("messages_read", [&]() { return val(user_.messages_read()); });
-  fns_.try_emplace("email_today", [&]() { return val(user_.email_today()); });
-  fns_.try_emplace("email_sent_local", [&]() { return val(user_.email_sent()); });
-  fns_.try_emplace("feedback_sent", [&]() { return val(user_.feedback_sent()); });
-  fns_.try_emplace("email_sent_net", [&]() { return val(user_.email_net()); });
-  fns_.try_emplace("chains_run", [&]() { return val(user_.chains_run()); });
-  fns_.try_emplace("uploaded", [&]() { return val(user_.uploaded()); });
-  fns_.try_emplace("uk", [&]() { return val(user_.uk()); });
-  fns_.try_emplace("downloaded", [&]() { return val(user_.downloaded()); });
-  fns_.try_emplace("dk", [&]() { return val(user_.dk()); });
-  fns_.try_emplace("show_controlcodes", [&]() { return val(user_.has_flag(User::msg_show_controlcodes)); });
-  fns_.try_emplace("twentyfour_clock", [&]() { return val(user_.twentyfour_clock()); });
+  fns.try_emplace("email", [](const UserValueProvider& p) { return val(p.user_.email_address()); });
+  fns.try_emplace("ignore_msgs", [](const UserValueProvider& p) { return val(p.user_.ignore_msgs()); });
+  fns.try_emplace("clear_screen", [](const UserValueProvider& p) { return val(p.user_.clear_screen()); });
+  fns.try_emplace("auto_quote", [](const UserValueProvider& p) { return val(p.user_.auto_quote()); });
+  fns.try_emplace("protocol", [](const UserValueProvider& p) { return val(p.user_.default_protocol()); });
+  fns.try_emplace("callsign", [](const UserValueProvider& p) { return val(p.user_.callsign()); });
+  fns.try_emplace("street", [](const UserValueProvider& p) { return val(p.user_.street()); });
+  fns.try_emplace("city", [](const UserValueProvider& p) { return val(p.user_.city()); });
+  fns.try_emplace("state", [](const UserValueProvider& p) { return val(p.user_.state()); });
+  fns.try_emplace("zip_code", [](const UserValueProvider& p) { return val(p.user_.zip_code()); });
+  fns.try_emplace("last_ipaddress", [](const UserValueProvider& p) { return val(p.user_.last_address().to_string()); });
+  fns.try_emplace("last_bps", [](const UserValueProvider& p) { return val(p.user_.last_bps()); });
+  fns.try_emplace("laston", [](const UserValueProvider& p) { return val(p.user_.laston()); });
+  fns.try_emplace("voice_phone", [](const UserValueProvider& p) { return val(p.user_.voice_phone()); });
+  fns.try_emplace("data_phone", [](const UserValueProvider& p) { return val(p.user_.data_phone()); });
+  fns.try_emplace("gender", [](const UserValueProvider& p) { return val(p.user_.gender()); });
+  fns.try_emplace("menuset", [](const UserValueProvider& p) { return val(p.user_.menu_set()); });
+  fns.try_emplace("birthday_mmddyy", [](const UserValueProvider& p) { return val(p.user_.birthday_mmddyy()); });
+  fns.try_emplace("email_waiting", [](const UserValueProvider& p) { return val(p.user_.email_waiting()); });
+  fns.try_emplace("messages_posted", [](const UserValueProvider& p) { return val(p.user_.messages_posted()); });
+  fns.try_emplace("posts_today", [](const UserValueProvider& p) { return val(p.user_.posts_today()); });
+  fns.try_emplace("posts_net", [](const UserValueProvider& p) { return val(p.user_.posts_net()); });
+  fns.try_emplace("messages_read", [](const UserValueProvider& p) { return val(p.user_.messages_read()); });
+  fns.try_emplace("email_today", [](const UserValueProvider& p) { return val(p.user_.email_today()); });
+  fns.try_emplace("email_sent_local", [](const UserValueProvider& p) { return val(p.user_.email_sent()); });
+  fns.try_emplace("feedback_sent", [](const UserValueProvider& p) { return val(p.user_.feedback_sent()); });
+  fns.try_emplace("email_sent_net", [](const UserValueProvider& p) { return val(p.user_.email_net()); });
+  fns.try_emplace("chains_run", [](const UserValueProvider& p) { return val(p.user_.chains_run()); });
+  fns.try_emplace("uploaded", [](const UserValueProvider& p) { return val(p.user_.uploaded()); });
+  fns.try_emplace("uk", [](const UserValueProvider& p) { return val(p.user_.uk()); });
+  fns.try_emplace("downloaded", [](const UserValueProvider& p) { return val(p.user_.downloaded()); });
+  fns.try_emplace("dk", [](const UserValueProvider& p) { return val(p.user_.dk()); });
+  fns.try_emplace("show_controlcodes", [](const UserValueProvider& p) { return val(p.user_.has_flag(User::msg_show_controlcodes)); });
+  fns.try_emplace("twentyfour_clock", [](const UserValueProvider& p) { return val(p.user_.twentyfour_clock()); });
 
+  return fns;
 }
 
 UserValueProvider::UserValueProvider(Context& c)
@@ -134,8 +148,11 @@ UserValueProvider::UserValueProvider(Context& c)
 
 
 std::optional<Value> UserValueProvider::value(const std::string& name) const {
-  if (const auto it = fns_.find(name); it != std::end(fns_)) {
-    return it->second();
+  if (name == "editorname" && !has_editorname_) {
+    throw eval_error(fmt::format("No user attribute named 'user.{}' exists.", name));
+  }
+  if (const auto it = fns().find(name); it != std::end(fns())) {
+    return it->second(*this);
   }
   throw eval_error(fmt::format("No user attribute named 'user.{}' exists.", name));
 }
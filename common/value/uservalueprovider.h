@@ -44,14 +44,19 @@ public:
   [[nodiscard]] std::optional<sdk::value::Value> value(const std::string& name) const override;
 
 private:
-  typedef std::function<std::optional<sdk::value::Value>()> makeval_fn;
-  std::map<const std::string, makeval_fn> fns_;
+  typedef std::function<std::optional<sdk::value::Value>(const UserValueProvider&)> makeval_fn;
+  typedef std::map<const std::string, makeval_fn> fns_t;
+  static const fns_t& fns();
+  static fns_t make_fns();
+
   const sdk::Config& config_;
   const sdk::User& user_;
   int effective_sl_;
   slrec sl_;
   std::vector<editorrec> editors_;
   sdk::Chains chains_;
+  // Only available when created from a Context.
+  bool has_editorname_{false};
 };
 
 }
@@ -21,7 +21,11 @@
 #include "core/file.h"
 #include "core/stl.h"
 #include "core/wwivport.h"
+#include <algorithm>
 #include <filesystem>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace wwiv::core {
@@ -87,6 +91,45 @@ public:
     return Read(record);
   }
 
+  /**
+   * Reads the records numbered record_numbers into records, in the same order.
+   * Runs of adjacent record numbers are read with a single Read.
+   */
+  bool ReadRecords(const std::vector<size_type>& record_numbers, std::vector<RECORD>& records) {
+    records.resize(record_numbers.size());
+    std::vector<RECORD> run;
+    return for_each_run(record_numbers, [&](size_type start, const auto& first, const auto& last) {
+      run.resize(static_cast<size_t>(std::prev(last)->first - start + 1));
+      if (!Seek(start) || !Read(&run[0], stl::ssize(run))) {
+        return false;
+      }
+      for (auto it = first; it != last; ++it) {
+        records[it->second] = run[static_cast<size_t>(it->first - start)];
+      }
+      return true;
+    });
+  }
+
+  /**
+   * Writes records[i] to record number record_numbers[i]. Runs of adjacent
+   * record numbers are written with a single Write.
+   */
+  bool WriteRecords(const std::vector<size_type>& record_numbers,
+                    const std::vector<RECORD>& records) {
+    if (record_numbers.size() != records.size()) {
+      return false;
+    }
+    std::vector<RECORD> run;
+    return for_each_run(record_numbers, [&](size_type start, const auto& first, const auto& last) {
+      run.resize(static_cast<size_t>(std::prev(last)->first - start + 1));
+      // When a record number is repeated, the last one wins like separate writes would.
+      for (auto it = first; it != last; ++it) {
+        run[static_cast<size_t>(it->first - start)] = records[it->second];
+      }
+      return Seek(start) && Write(&run[0], stl::ssize(run));
+    });
+  }
+
   bool WriteVector(const std::vector<RECORD>& records, size_type max_records = 0) {
     if (records.empty()) {
       return true;
@@ -130,7 +173,103 @@ public:
   explicit operator bool() const noexcept { return file_.IsOpen(); }
 
 private:
+  /**
+   * Sorts record_numbers and calls fn(start, first, last) for each run of
+   * adjacent (or repeated) record numbers, where [first, last) are the
+   * (record number, position in record_numbers) pairs in the run.
+   */
+  template <typename F>
+  static bool for_each_run(const std::vector<size_type>& record_numbers, F fn) {
+    std::vector<std::pair<size_type, size_t>> order;
+    order.reserve(record_numbers.size());
+    for (size_t i = 0; i < record_numbers.size(); i++) {
+      if (record_numbers[i] < 0) {
+        return false;
+      }
+      order.emplace_back(record_numbers[i], i);
+    }
+    // Stable, so that later positions come last for repeated record numbers.
+    std::stable_sort(std::begin(order), std::end(order),
+                     [](const auto& l, const auto& r) { return l.first < r.first; });
+    for (auto first = std::begin(order); first != std::end(order);) {
+      auto last = std::next(first);
+      while (last != std::end(order) && last->first <= std::prev(last)->first + 1) {
+        ++last;
+      }
+      if (!fn(first->first, first, last)) {
+        return false;
+      }
+      first = last;
+    }
+    return true;
+  }
+
+  File file_;
+};
+
+/**
+ * Read only, random access view of all of the records in a data file,
+ * memory mapped where possible.
+ *
+ * The view holds the file open for as long as it exists. File::Open takes
+ * an exclusive lock even when opening read only, so other opens of the file
+ * (including ones from this process) block until the view is destroyed.
+ * Keep it short lived. It does not see records added after it was created.
+ *
+ * Example:
+ *   DataFileView<mailrec> emails(FilePath("/opt/wwiv/bbs/data", "email.dat"));
+ *   if (!emails) { LOG(FATAL) << "unable to map email.dat"; }
+ *   for (const auto& m : emails) { ... }
+ */
+template <typename RECORD> class DataFileView final {
+  static_assert(std::is_trivially_copyable<RECORD>::value,
+                "DataFileView requires a trivially copyable record.");
+
+public:
+  using size_type = ssize_t;
+  using const_iterator = const RECORD*;
+
+  /** Opens full_file_name read only and maps it. */
+  explicit DataFileView(const std::filesystem::path& full_file_name) : file_(full_file_name) {
+    if (file_.Open(File::modeBinary | File::modeReadOnly)) {
+      mapping_ = FileMapping(file_);
+    }
+  }
+
+  /**
+   * Maps a data file that is already open, which must stay open while this
+   * view is used. Use this when already holding the file open, since opening
+   * it again may block on our own lock.
+   */
+  explicit DataFileView(DataFile<RECORD>& file) : file_(file.file().path()) {
+    mapping_ = FileMapping(file.file());
+  }
+
+  [[nodiscard]] size_type size() const noexcept {
+    return mapping_.size() / static_cast<size_type>(sizeof(RECORD));
+  }
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  [[nodiscard]] const RECORD* data() const noexcept {
+    return reinterpret_cast<const RECORD*>(mapping_.data());
+  }
+  [[nodiscard]] const RECORD& operator[](size_type n) const noexcept { return data()[n]; }
+  [[nodiscard]] const RECORD& at(size_type n) const {
+    if (n < 0 || n >= size()) {
+      throw std::out_of_range("DataFileView::at");
+    }
+    return data()[n];
+  }
+
+  [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+  [[nodiscard]] const_iterator end() const noexcept { return data() + size(); }
+
+  explicit operator bool() const noexcept { return static_cast<bool>(mapping_); }
+
+private:
+  // Only opened when this view opened the file itself.
   File file_;
+  FileMapping mapping_;
 };
 
 }
@@ -21,7 +21,9 @@
 #include "core/strings.h"
 #include "core/test/file_helper.h"
 #include "gtest/gtest.h"
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 using namespace wwiv::core;
 using namespace wwiv::strings;
@@ -313,3 +315,88 @@ TEST(DataFileTest, Read_DoesNotExist) {
   }
   EXPECT_FALSE(datafile);
 }
+
+TEST(DataFileTest, ReadRecords) {
+  struct T {
+    int a;
+  };
+  const wwiv::core::test::FileHelper file;
+  const auto path = FilePath(file.TempDir(), "ReadRecords");
+  {
+    DataFile<T> datafile(path, File::modeCreateFile | File::modeBinary | File::modeReadWrite);
+    ASSERT_TRUE(datafile.WriteVector({{0}, {10}, {20}, {30}, {40}, {50}}));
+  }
+
+  DataFile<T> datafile(path, File::modeBinary | File::modeReadOnly);
+  std::vector<T> t;
+  ASSERT_TRUE(datafile.ReadRecords({4, 1, 2, 5, 1}, t));
+  ASSERT_EQ(5u, t.size());
+  EXPECT_EQ(40, t[0].a);
+  EXPECT_EQ(10, t[1].a);
+  EXPECT_EQ(20, t[2].a);
+  EXPECT_EQ(50, t[3].a);
+  EXPECT_EQ(10, t[4].a);
+
+  EXPECT_FALSE(datafile.ReadRecords({1, 6}, t));
+}
+
+TEST(DataFileTest, WriteRecords) {
+  struct T {
+    int a;
+  };
+  const wwiv::core::test::FileHelper file;
+  const auto path = FilePath(file.TempDir(), "WriteRecords");
+  {
+    DataFile<T> datafile(path, File::modeCreateFile | File::modeBinary | File::modeReadWrite);
+    ASSERT_TRUE(datafile.WriteVector({{0}, {10}, {20}, {30}}));
+    ASSERT_TRUE(datafile.WriteRecords({3, 1, 2, 1}, {{33}, {11}, {22}, {111}}));
+  }
+
+  DataFile<T> datafile(path, File::modeBinary | File::modeReadOnly);
+  std::vector<T> t;
+  ASSERT_TRUE(datafile.ReadVector(t));
+  ASSERT_EQ(4u, t.size());
+  EXPECT_EQ(0, t[0].a);
+  EXPECT_EQ(111, t[1].a);
+  EXPECT_EQ(22, t[2].a);
+  EXPECT_EQ(33, t[3].a);
+}
+
+TEST(DataFileTest, DataFileView) {
+  struct T {
+    int a;
+    int b;
+  };
+  const wwiv::core::test::FileHelper file;
+  const auto path = FilePath(file.TempDir(), "DataFileView");
+  {
+    DataFile<T> datafile(path, File::modeCreateFile | File::modeBinary | File::modeReadWrite);
+    ASSERT_TRUE(datafile.WriteVector({{1, 2}, {3, 4}, {5, 6}}));
+  }
+
+  const DataFileView<T> view(path);
+  ASSERT_TRUE(view);
+  ASSERT_EQ(3, view.size());
+  EXPECT_EQ(3, view[1].a);
+  EXPECT_EQ(6, view.at(2).b);
+  EXPECT_THROW((void)view.at(3), std::out_of_range);
+  auto sum = 0;
+  for (const auto& t : view) {
+    sum += t.a;
+  }
+  EXPECT_EQ(9, sum);
+}
+
+TEST(DataFileTest, DataFileView_Empty) {
+  struct T {
+    int a;
+  };
+  const wwiv::core::test::FileHelper file;
+  const auto path = FilePath(file.TempDir(), "DataFileView_Empty");
+  DataFile<T> datafile(path, File::modeCreateFile | File::modeBinary | File::modeReadWrite);
+
+  const DataFileView<T> view(datafile);
+  ASSERT_TRUE(view);
+  EXPECT_TRUE(view.empty());
+  EXPECT_EQ(view.begin(), view.end());
+}
@@ -312,14 +312,21 @@ void DateTime::update_tm() noexcept {
   if (t_ < 0) {
     t_ = 1;
   }
-  if (const auto * tm = localtime(&t_);tm) {
-    tm_ = *tm;
-  } else {
+  // Use the reentrant versions of localtime since DateTime is used from
+  // more than one thread.
+#ifdef _WIN32
+  if (localtime_s(&tm_, &t_) != 0) {
     LOG(ERROR) << "Invalid Time passed to update_tm";    
-    auto tnow = time(nullptr);
-    const auto* nowtm = localtime(&tnow);
-    tm_ = *nowtm;
+    const auto tnow = time(nullptr);
+    localtime_s(&tm_, &tnow);
   }
+#else
+  if (!localtime_r(&t_, &tm_)) {
+    LOG(ERROR) << "Invalid Time passed to update_tm";    
+    const auto tnow = time(nullptr);
+    localtime_r(&tnow, &tm_);
+  }
+#endif
 }
 
 system_clock::time_point DateTime::to_system_clock() const noexcept {
@@ -49,6 +49,9 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <utime.h>
+#ifndef __OS2__
+#include <sys/mman.h>
+#endif // __OS2__
 #endif // _WIN32
 
 
@@ -295,6 +298,44 @@ File::size_type File::Write(const void* buffer, File::size_type size) {
 }
 
 // ReSharper disable once CppMemberFunctionMayBeConst
+File::size_type File::ReadAt(size_type offset, void* buffer, size_type size) {
+#if defined(_WIN32) || defined(__OS2__)
+  const auto pos = current_position();
+  if (Seek(offset, Whence::begin) != offset) {
+    return -1;
+  }
+  const auto ret = Read(buffer, size);
+  Seek(pos, Whence::begin);
+  return ret;
+#else
+  const auto ret = pread(handle_, buffer, static_cast<size_t>(size), static_cast<off_t>(offset));
+  if (ret == -1) {
+    LOG(ERROR) << "ReadAt errno: " << errno << " filename: " << full_path_name_
+               << " offset: " << offset << " size: " << size << "; " << strerror(errno);
+  }
+  return static_cast<size_type>(ret);
+#endif
+}
+
+File::size_type File::WriteAt(size_type offset, const void* buffer, size_type size) {
+#if defined(_WIN32) || defined(__OS2__)
+  const auto pos = current_position();
+  if (Seek(offset, Whence::begin) != offset) {
+    return -1;
+  }
+  const auto ret = Write(buffer, size);
+  Seek(pos, Whence::begin);
+  return ret;
+#else
+  const auto ret = pwrite(handle_, buffer, static_cast<size_t>(size), static_cast<off_t>(offset));
+  if (ret == -1) {
+    LOG(ERROR) << "WriteAt errno: " << errno << " filename: " << full_path_name_
+               << " offset: " << offset << " size: " << size << "; " << strerror(errno);
+  }
+  return static_cast<size_type>(ret);
+#endif
+}
+
 File::size_type File::Seek(size_type offset, Whence whence) {
   CHECK(File::IsFileHandleValid(handle_));
   CHECK(whence == File::Whence::begin || whence == File::Whence::current ||
@@ -615,4 +656,88 @@ long File::freespace_for_path(const std::filesystem::path& p) {
   return static_cast<long>(devi.available / 1024);
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// FileMapping
+
+FileMapping::FileMapping(File& file) {
+  if (!file.IsOpen()) {
+    return;
+  }
+  size_ = file.length();
+  if (size_ <= 0) {
+    // There's nothing to map in an empty file.
+    size_ = 0;
+    ok_ = true;
+    return;
+  }
+#if defined(_WIN32)
+  auto* fh = reinterpret_cast<HANDLE>(_get_osfhandle(file.handle()));
+  if (auto* m = CreateFileMapping(fh, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+    if (auto* v = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0)) {
+      mapping_handle_ = m;
+      data_ = static_cast<const char*>(v);
+      ok_ = true;
+      return;
+    }
+    CloseHandle(m);
+  }
+#elif !defined(__OS2__)
+  if (auto* v = mmap(nullptr, static_cast<size_t>(size_), PROT_READ, MAP_SHARED, file.handle(), 0);
+      v != MAP_FAILED) {
+    data_ = static_cast<const char*>(v);
+    ok_ = true;
+    return;
+  }
+#endif
+  VLOG(1) << "Unable to map: " << file.path() << "; reading it instead.";
+  // Fall back to reading the whole file.
+  buffer_ = std::make_unique<char[]>(size_);
+  if (file.Seek(0, File::Whence::begin) != 0 || file.Read(buffer_.get(), size_) != size_) {
+    buffer_.reset();
+    size_ = 0;
+    return;
+  }
+  data_ = buffer_.get();
+  ok_ = true;
+}
+
+FileMapping::FileMapping(FileMapping&& other) noexcept
+    : data_(other.data_), size_(other.size_), ok_(other.ok_), buffer_(std::move(other.buffer_)),
+      mapping_handle_(other.mapping_handle_) {
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.ok_ = false;
+  other.mapping_handle_ = nullptr;
+}
+
+FileMapping& FileMapping::operator=(FileMapping&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    ok_ = std::exchange(other.ok_, false);
+    buffer_ = std::move(other.buffer_);
+    mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+  }
+  return *this;
+}
+
+FileMapping::~FileMapping() { Unmap(); }
+
+void FileMapping::Unmap() noexcept {
+  if (data_ && !buffer_) {
+#if defined(_WIN32)
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_handle_);
+#elif !defined(__OS2__)
+    munmap(const_cast<char*>(data_), static_cast<size_t>(size_));
+#endif
+  }
+  buffer_.reset();
+  data_ = nullptr;
+  size_ = 0;
+  ok_ = false;
+  mapping_handle_ = nullptr;
+}
+
 } // namespace wwiv
@@ -112,6 +112,17 @@ public:
 
   size_type Write(const std::string& s) { return this->Write(s.data(), s.length()); }
 
+  /**
+   * Reads size bytes at offset without using or moving the current position,
+   * in a single call where the platform supports it (pread).
+   */
+  size_type ReadAt(size_type offset, void* buffer, size_type size);
+  /**
+   * Writes size bytes at offset without using or moving the current position,
+   * in a single call where the platform supports it (pwrite).
+   */
+  size_type WriteAt(size_type offset, const void* buffer, size_type size);
+
   size_type Writeln(const void* buffer, size_type count) {
     auto ret = this->Write(buffer, count);
     ret += this->Write("\r\n", 2);
@@ -236,7 +247,7 @@ public:
   [[nodiscard]] static long freespace_for_path(const std::filesystem::path& p);
   [[nodiscard]] static bool is_directory(const std::filesystem::path& path) noexcept;
 
-  /** For debugging and testing only */
+  /** The underlying file descriptor, or -1 if the file is not open */
   [[nodiscard]] int handle() const noexcept { return handle_; }
 
 private:
@@ -249,6 +260,40 @@ private:
   std::string error_text_;
 };
 
+/**
+ * Read only view of the contents of an open File. The file is memory mapped
+ * where the platform supports it, otherwise the contents are read into memory.
+ *
+ * The File must stay open while the mapping is in use, and the mapping sees
+ * the length of the file at the time it was created.
+ */
+class FileMapping final {
+public:
+  FileMapping() = default;
+  explicit FileMapping(File& file);
+  FileMapping(const FileMapping&) = delete;
+  FileMapping& operator=(const FileMapping&) = delete;
+  FileMapping(FileMapping&& other) noexcept;
+  FileMapping& operator=(FileMapping&& other) noexcept;
+  ~FileMapping();
+
+  /** Start of the file contents, or nullptr if the file is empty. */
+  [[nodiscard]] const char* data() const noexcept { return data_; }
+  [[nodiscard]] File::size_type size() const noexcept { return size_; }
+  explicit operator bool() const noexcept { return ok_; }
+
+private:
+  void Unmap() noexcept;
+
+  const char* data_{nullptr};
+  File::size_type size_{0};
+  bool ok_{false};
+  // Holds the contents when they were read instead of mapped.
+  std::unique_ptr<char[]> buffer_;
+  // Platform handle to the mapping (only used on Windows).
+  void* mapping_handle_{nullptr};
+};
+
 /** Makes a backup of path using a custom suffix with the time and date */
 bool backup_file(const std::filesystem::path& from, int max_backups = 0);
 
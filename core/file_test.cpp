@@ -382,6 +382,28 @@ TEST(FileTest, CurrentPosition) {
   EXPECT_EQ(static_cast<int>(kContents.size()), file.current_position());
 }
 
+TEST(FileTest, ReadAt_WriteAt) {
+  static const std::string kContents = "0123456789";
+  wwiv::core::test::FileHelper helper;
+  const auto path = helper.CreateTempFile(test_info_->name(), kContents);
+  File file(path);
+  ASSERT_TRUE(file.Open(File::modeBinary | File::modeReadWrite));
+
+  EXPECT_EQ(2, file.Seek(2, File::Whence::begin));
+  char buf[3]{};
+  EXPECT_EQ(3, file.ReadAt(5, buf, 3));
+  EXPECT_EQ("567", std::string(buf, 3));
+  EXPECT_EQ(2, file.current_position());
+
+  EXPECT_EQ(2, file.WriteAt(8, "ab", 2));
+  EXPECT_EQ(2, file.current_position());
+  EXPECT_EQ(2, file.ReadAt(8, buf, 2));
+  EXPECT_EQ("ab", std::string(buf, 2));
+
+  // Reading past the end returns a short count.
+  EXPECT_EQ(0, file.ReadAt(10, buf, 3));
+}
+
 TEST(FileTest, FsCopyFile) {
   wwiv::core::test::FileHelper file;
   auto tmp = file.TempDir();
@@ -17,6 +17,7 @@
 /**************************************************************************/
 #include "core/socket_connection.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <chrono>
 #include <cstring>
@@ -32,6 +33,7 @@
 #include <fcntl.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -54,16 +56,15 @@ using std::chrono::duration;
 using std::chrono::duration_cast;
 using std::chrono::milliseconds;
 using std::chrono::seconds;
-using std::chrono::system_clock;
-using std::chrono::time_point;
-using wwiv::os::sleep_for;
+using std::chrono::steady_clock;
 using namespace wwiv::strings;
 
 namespace wwiv::core {
 
 namespace {
 
-const auto SLEEP_MS = milliseconds(100);
+// How much to read from the socket at once when reading ahead.
+constexpr int READ_BUFFER_SIZE = 16 * 1024;
 
 bool SetBlockingMode(SOCKET sock, bool blocking_mode) {
   if (sock == INVALID_SOCKET) {
@@ -216,51 +217,88 @@ SocketConnection::~SocketConnection() {
   }
 }
 
-template <typename TYPE, std::size_t SIZE = sizeof(TYPE)>
-static int read_TYPE(const SOCKET sock, TYPE* data, const duration<double> d, bool throw_on_timeout,
-                     std::size_t size = SIZE) {
-  const auto end = system_clock::now() + d;
-  auto* p = reinterpret_cast<char*>(data);
+bool SocketConnection::wait_for_event(bool write, duration<double> d) const {
+  const auto ms = std::max<int64_t>(0, std::chrono::ceil<milliseconds>(d).count());
+#ifdef _WIN32
+  WSAPOLLFD fds{};
+  fds.fd = sock_;
+  fds.events = write ? POLLWRNORM : POLLRDNORM;
+  return WSAPoll(&fds, 1, static_cast<int>(ms)) > 0;
+#else
+  pollfd fds{};
+  fds.fd = sock_;
+  fds.events = write ? POLLOUT : POLLIN;
+  return ::poll(&fds, 1, static_cast<int>(ms)) > 0;
+#endif // _WIN32
+}
+
+void SocketConnection::unread(const char* data, int size) {
+  // Only called once read_buffer_ has been drained.
+  if (read_buffer_.size() < static_cast<std::size_t>(size)) {
+    read_buffer_.resize(size);
+  }
+  memcpy(&read_buffer_[0], data, size);
+  read_pos_ = 0;
+  read_end_ = size;
+}
+
+int SocketConnection::read(void* data, int size, duration<double> d, bool throw_on_timeout) {
+  const auto end = steady_clock::now() + duration_cast<steady_clock::duration>(d);
+  const auto read_ahead = exit_mode_ == ExitMode::CLOSE_SOCKET;
+  auto* p = static_cast<char*>(data);
   auto total_read = 0;
-  auto remaining = static_cast<int>(size);
-  bool first = true;
-  while (true) {
-    if (!first && system_clock::now() > end) {
-      if (throw_on_timeout) {
-        throw timeout_error("timeout error reading from socket.");
+  while (total_read < size) {
+    if (read_pos_ < read_end_) {
+      const auto n = std::min<int>(size - total_read, static_cast<int>(read_end_ - read_pos_));
+      memcpy(p + total_read, &read_buffer_[read_pos_], n);
+      read_pos_ += n;
+      total_read += n;
+      continue;
+    }
+    const auto remaining = size - total_read;
+    // Small reads go through read_buffer_ so the following ones don't need a recv.
+    const auto use_buffer = read_ahead && remaining < READ_BUFFER_SIZE;
+    if (use_buffer && read_buffer_.size() < READ_BUFFER_SIZE) {
+      read_buffer_.resize(READ_BUFFER_SIZE);
+    }
+    auto* dest = use_buffer ? &read_buffer_[0] : p + total_read;
+    const auto result = recv(sock_, dest, use_buffer ? READ_BUFFER_SIZE : remaining, 0);
+    if (result > 0) {
+      if (use_buffer) {
+        read_pos_ = 0;
+        read_end_ = result;
+      } else {
+        total_read += result;
       }
+      continue;
+    }
+    if (result == 0) {
+      // The other side closed the socket.
       return total_read;
     }
-    first = false;
-    const auto result = recv(sock, p, remaining, 0);
-    if (result == SOCKET_ERROR) {
+    if (!WouldSocketBlock()) {
       const auto saved_errno = errno;
-      const auto saved_errno_text = GetLastErrorText();
-      if (WouldSocketBlock()) {
-        sleep_for(SLEEP_MS);
-        continue;
-      }
       if (saved_errno != ECONNRESET) {
         // This happens normally as the other side disconnects.
-        LOG(ERROR) << "Got Socket Error on recv: " << saved_errno_text;
+        LOG(ERROR) << "Got Socket Error on recv: " << GetLastErrorText();
       }
       return total_read;
     }
-    if (result <= 0) {
+    const auto now = steady_clock::now();
+    if (now >= end || !wait_for_event(false, end - now)) {
+      if (throw_on_timeout) {
+        // Put back what we have so far, a timed out read consumes nothing.
+        unread(p, total_read);
+        throw timeout_error("timeout error reading from socket.");
+      }
       return total_read;
     }
-    total_read += result;
-    if (total_read < static_cast<int>(size)) {
-      p += result;
-      remaining -= result;
-      continue;
-    }
-    return total_read;
   }
+  return total_read;
 }
 
 int SocketConnection::receive(void* data, const int size, duration<double> d) {
-  const auto num_read = read_TYPE<void, 0>(sock_, data, d, true, size);
+  const auto num_read = read(data, size, d, true);
   if (open_ && num_read == 0) {
     throw socket_closed_error(fmt::sprintf("receive: got zero read from socket. expected: ", size));
   }
@@ -268,7 +306,7 @@ int SocketConnection::receive(void* data, const int size, duration<double> d) {
 }
 
 int SocketConnection::receive_upto(void* data, const int size, duration<double> d) {
-  return read_TYPE<void, 0>(sock_, data, d, false, size);
+  return read(data, size, d, false);
 }
 
 std::string SocketConnection::receive(int size, duration<double> d) {
@@ -289,7 +327,7 @@ std::string SocketConnection::read_line(int max_size, duration<double> d) {
   try {
     while (true) {
       char data = 0;
-      const auto num_read = read_TYPE<char>(sock_, &data, d, true);
+      const auto num_read = read(&data, 1, d, true);
       if (!open_) {
         throw socket_closed_error("read_line: socket not open");
       }
@@ -314,14 +352,26 @@ std::string SocketConnection::read_line(int max_size, duration<double> d) {
 #define MSG_NOSIGNAL 0
 #endif  // MSG_NOSIGNAL 
 
-int SocketConnection::send(const void* data, int size, duration<double>) {
-  const auto sent = ::send(sock_, static_cast<const char*>(data), size, MSG_NOSIGNAL);
-  if (open_ && sent != size) {
-    if (sent == -1) {
+int SocketConnection::send(const void* data, int size, duration<double> d) {
+  const auto end = steady_clock::now() + duration_cast<steady_clock::duration>(d);
+  const auto* p = static_cast<const char*>(data);
+  auto total_sent = 0;
+  while (open_ && total_sent < size) {
+    const auto sent = ::send(sock_, p + total_sent, size - total_sent, MSG_NOSIGNAL);
+    if (sent > 0) {
+      total_sent += sent;
+      continue;
+    }
+    if (sent == -1 && !WouldSocketBlock()) {
       throw socket_closed_error(
           StrCat("Socket Closed; errno: ", strerror(errno)));
     }
-    LOG(ERROR) << "ERROR: send != packet size.  size: " << size << "; sent: " << sent;
+    // The socket's send buffer is full, wait for the other side to catch up.
+    const auto now = steady_clock::now();
+    if (now >= end || !wait_for_event(true, end - now)) {
+      throw timeout_error(
+          fmt::format("timeout error writing to socket. size: {}; sent: {}", size, total_sent));
+    }
   }
   return size;
 }
@@ -336,7 +386,7 @@ int SocketConnection::send_line(const std::string& s, duration<double> d) {
 
 uint16_t SocketConnection::read_uint16(duration<double> d) {
   uint16_t data = 0;
-  const auto num_read = read_TYPE<uint16_t>(sock_, &data, d, true);
+  const auto num_read = read(&data, sizeof(uint16_t), d, true);
   if (open_ && num_read == 0) {
     throw socket_closed_error(
         StrCat("read_uint16: got zero read from socket. expected: ", sizeof(uint16_t)));
@@ -346,7 +396,7 @@ uint16_t SocketConnection::read_uint16(duration<double> d) {
 
 uint8_t SocketConnection::read_uint8(duration<double> d) {
   uint8_t data = 0;
-  const auto num_read = read_TYPE<uint8_t>(sock_, &data, d, true);
+  const auto num_read = read(&data, sizeof(uint8_t), d, true);
   if (open_ && num_read == 0) {
     throw socket_closed_error(
         StrCat("read_uint8: got zero read from socket. expected: ", sizeof(uint8_t)));
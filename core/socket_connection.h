@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #ifdef _WIN32
 #include <WinSock2.h>
@@ -57,6 +58,10 @@ public:
   std::string receive_upto(int size, std::chrono::duration<double> d);
 
   std::string read_line(int max_size, std::chrono::duration<double> d);
+  /**
+   * Sends all size bytes of data, waiting up to d for room in the socket's
+   * send buffer. Throws timeout_error if it could not all be sent in time.
+   */
   int send(const void* data, int size, std::chrono::duration<double> d) override;
   int send(const std::string& s, std::chrono::duration<double> d) override;
 
@@ -72,9 +77,28 @@ public:
   SOCKET socket() const { return sock_; }
 
 private:
+  /**
+   * Reads size bytes into data, waiting up to d for them to arrive. Returns
+   * the number of bytes read, which is less than size if the socket was
+   * closed, or on timeout when throw_on_timeout is false. When it throws
+   * timeout_error, nothing has been consumed from the socket.
+   */
+  int read(void* data, int size, std::chrono::duration<double> d, bool throw_on_timeout);
+  /** Pushes size bytes back to be returned by the next read. */
+  void unread(const char* data, int size);
+  /** Waits up to d for the socket to be writable (write) or readable */
+  [[nodiscard]] bool wait_for_event(bool write, std::chrono::duration<double> d) const;
+
   SOCKET sock_;
   bool open_;
   ExitMode exit_mode_ = ExitMode::LEAVE_SOCKET_OPEN;
+  // Data received ahead of being asked for, in [read_pos_, read_end_).
+  // Only read ahead when we own the socket (CLOSE_SOCKET), since otherwise the
+  // socket is handed to someone else who expects to see that data. The
+  // remains of a timed out read are kept here in every mode.
+  std::vector<char> read_buffer_;
+  std::size_t read_pos_{0};
+  std::size_t read_end_{0};
 };
 
 
@@ -0,0 +1,120 @@
+/**************************************************************************/
+/*                                                                        */
+/*                              WWIV Version 5.x                          */
+/*                   Copyright (C)2023, WWIV Software Services            */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+#include "gtest/gtest.h"
+
+#include "core/socket_connection.h"
+#include "core/socket_exceptions.h"
+#include <chrono>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+using namespace wwiv::core;
+
+class SocketConnectionTest : public ::testing::Test {
+public:
+  void SetUp() override { ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sv_)); }
+  void TearDown() override { ::close(sv_[1]); }
+
+  void Send(const std::string& s) const {
+    ASSERT_EQ(static_cast<ssize_t>(s.size()), ::send(sv_[1], s.data(), s.size(), 0));
+  }
+
+  int sv_[2]{};
+};
+
+TEST_F(SocketConnectionTest, ReadLine) {
+  SocketConnection conn(sv_[0]);
+  Send("hello\r\nworld\r\n");
+  EXPECT_EQ("hello\r\n", conn.read_line(80, 1s));
+  EXPECT_EQ("world\r\n", conn.read_line(80, 1s));
+}
+
+TEST_F(SocketConnectionTest, ReadLine_ThenReceive) {
+  SocketConnection conn(sv_[0]);
+  std::string s("line\n");
+  s.push_back(1);
+  s.push_back(2);
+  s.push_back(3);
+  Send(s);
+  EXPECT_EQ("line\n", conn.read_line(80, 1s));
+  EXPECT_EQ(0x0102, conn.read_uint16(1s));
+  EXPECT_EQ(3, conn.read_uint8(1s));
+}
+
+TEST_F(SocketConnectionTest, Receive_Timeout) {
+  SocketConnection conn(sv_[0]);
+  Send("ab");
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_THROW(conn.receive(3, 100ms), timeout_error);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 100ms);
+}
+
+TEST_F(SocketConnectionTest, Receive_TimeoutConsumesNothing) {
+  SocketConnection conn(sv_[0]);
+  Send("ab");
+  EXPECT_THROW(conn.receive(3, 10ms), timeout_error);
+  Send("c");
+  EXPECT_EQ("abc", conn.receive(3, 1s));
+}
+
+TEST_F(SocketConnectionTest, Send_WaitsForRoom) {
+  SocketConnection conn(sv_[0]);
+  // Larger than the socket buffer, so send has to wait for the reader.
+  const std::string s(1024 * 1024, 'x');
+  std::string received;
+  std::thread reader([&] {
+    char buf[4096];
+    while (received.size() < s.size()) {
+      const auto n = ::recv(sv_[1], buf, sizeof(buf), 0);
+      if (n <= 0) {
+        break;
+      }
+      received.append(buf, n);
+    }
+  });
+  EXPECT_EQ(static_cast<int>(s.size()), conn.send(s, 10s));
+  reader.join();
+  EXPECT_EQ(s, received);
+}
+
+TEST_F(SocketConnectionTest, Send_Timeout) {
+  SocketConnection conn(sv_[0]);
+  const std::string s(1024 * 1024, 'x');
+  EXPECT_THROW(conn.send(s, 10ms), timeout_error);
+}
+
+TEST_F(SocketConnectionTest, ReceiveUpto_Partial) {
+  SocketConnection conn(sv_[0]);
+  Send("ab");
+  EXPECT_EQ("ab", conn.receive_upto(10, 10ms));
+}
+
+TEST_F(SocketConnectionTest, LeaveSocketOpen_DoesNotReadAhead) {
+  {
+    SocketConnection conn(sv_[0], SocketConnection::ExitMode::LEAVE_SOCKET_OPEN);
+    Send("a\nb");
+    EXPECT_EQ("a\n", conn.read_line(80, 1s));
+  }
+  char ch = 0;
+  EXPECT_EQ(1, ::recv(sv_[0], &ch, 1, 0));
+  EXPECT_EQ('b', ch);
+  ::close(sv_[0]);
+}
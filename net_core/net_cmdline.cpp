@@ -99,6 +99,11 @@ NetworkCommandLine::NetworkCommandLine(wwiv::core::CommandLine& cmdline, char ne
   }
   network_ = nws[network_number_];
   network_name_ = ToStringLowerCase(network_.name);
+  // Now that the network name is known, load net.ini again so the settings in
+  // the network specific section (i.e. [networkb-wwivnet]) are used.
+  if (!LoadNetIni(net_cmd, cmdline.bbsdir())) {
+    LOG(ERROR) << "Error loading INI file for network: " << network_name_;
+  }
   LOG(STARTUP) << cmdline.program_name() << " [" << full_version() << "]"
                << " for network: " << network_name_;
   if (!quiet()) {
@@ -133,6 +138,7 @@ bool NetworkCommandLine::LoadNetIni(char net_cmd, const std::string& bbsdir) {
   SetNewBooleanDefault(cmdline_, *ini, "skip_net");
   SetNewBooleanDefault(cmdline_, *ini, "crc");
   SetNewBooleanDefault(cmdline_, *ini, "cram_md5");
+  SetNewBooleanDefault(cmdline_, *ini, "nr");
   SetNewBooleanDefault(cmdline_, *ini, "quiet");
   SetNewIntDefault(cmdline_, *ini, "semaphore_timeout");
   SetNewIntDefault(cmdline_, *ini, "v", [](int v) { Logger::set_cmdline_verbosity(v); });
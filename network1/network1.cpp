@@ -36,10 +36,13 @@
 #include "sdk/net/packets.h"
 
 #include <cstdlib>
+#include <deque>
+#include <future>
 #include <iostream>
 #include <map>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace wwiv::core;
@@ -69,11 +72,12 @@ Network1::Network1(const NetworkCommandLine& cmdline, const BbsListNet& bbslist,
 
 /**
  * Determines the filename for each of the nodes in list to forward to
- * and writes packets (calling write_wwivnet_packet) to each of them.
+ * and adds a packet for each of them to out.
  */
-bool Network1::write_multiple_wwivnet_packets(const net_header_rec& orig_header,
+void Network1::route_multiple_wwivnet_packets(const net_header_rec& orig_header,
                                               const std::vector<uint16_t>& list,
-                                              const std::string& text) {
+                                              const std::string& text,
+                                              std::vector<routed_packet_t>& out) const {
   std::map<uint16_t, std::set<uint16_t>> forsys_to_all;
   for (const auto& node : list) {
     auto forsys = get_forsys(bbslist_, node);
@@ -86,7 +90,6 @@ bool Network1::write_multiple_wwivnet_packets(const net_header_rec& orig_header,
     LOG(ERROR) << "write_multiple_wwivnet_packets called to a tosys != 0; got; " << orig_header.tosys;
   }
 
-  auto result = true;
   for (const auto& fa : forsys_to_all) {
     net_header_rec nh{ orig_header };
     std::vector<uint16_t> nplist(fa.second.begin(), fa.second.end());
@@ -99,21 +102,16 @@ bool Network1::write_multiple_wwivnet_packets(const net_header_rec& orig_header,
       np.list.clear();
     }
     const auto forsys = fa.first;
-    netdat_.add_file_bytes(forsys, np.length());
-    if (!write_wwivnet_packet(NetPacket::wwivnet_packet_path(net_, forsys), np)) {
-      result = false;
-    }
+    out.push_back({NetPacket::wwivnet_packet_path(net_, forsys), forsys, std::move(np)});
   }
-  return result;
 }
 
-// returns true on success, false on error.
-bool Network1::handle_packet(NetPacket& p) {
+void Network1::route_packet(NetPacket& p, std::vector<routed_packet_t>& out) const {
 
   if (p.nh.main_type == 65535) {
-    // Deleted message. return true since ignoring it *is* handling it appropriately.
+    // Deleted message. Ignoring it *is* handling it appropriately.
     LOG(INFO) << "Skipping deleted message of type: " << main_type_name(p.nh.main_type);
-    return true;
+    return;
   }
 
   // Update the routing information on this packet since
@@ -122,37 +120,90 @@ bool Network1::handle_packet(NetPacket& p) {
 
   if (p.nh.tosys == net_.sysnum) {
     // Local Packet.
-    netdat_.add_file_bytes(net_.sysnum, p.length());
-    return write_wwivnet_packet(FilePath(net_.dir, LOCAL_NET), p);
+    out.push_back({FilePath(net_.dir, LOCAL_NET), net_.sysnum, std::move(p)});
+    return;
   }
   if (p.list.empty()) {
     // Network packet, single destination
     const auto forsys = get_forsys(bbslist_, p.nh.tosys);
-    netdat_.add_file_bytes(forsys, p.length());
-    return write_wwivnet_packet(NetPacket::wwivnet_packet_path(net_, forsys), p);
+    out.push_back({NetPacket::wwivnet_packet_path(net_, forsys), forsys, std::move(p)});
+    return;
   }
   // Network packet, multiple destinations.
-  return write_multiple_wwivnet_packets(p.nh, p.list, p.text());
+  route_multiple_wwivnet_packets(p.nh, p.list, p.text(), out);
 }
 
-bool Network1::handle_file(const std::string& name) {
-  File f(FilePath(net_.dir, name));
-  if (!f.Open(File::modeBinary | File::modeReadOnly)) {
+Network1::routed_file_t Network1::route_file(const std::string& name) const {
+  routed_file_t routed;
+  routed.name = name;
+  NetMailFileView file(FilePath(net_.dir, name), false);
+  if (!file) {
     LOG(ERROR) << "Unable to open file: " << net_.dir << name;
-    return false;
+    return routed;
   }
 
-  for (;;) {
-    auto [packet, response] = read_packet(f, false);
-    if (response == ReadNetPacketResponse::END_OF_FILE) {
-      return true;
+  for (const auto& view : file) {
+    // Routing is updated on every packet, so each one needs a copy.
+    auto packet = view.ToNetPacket();
+    route_packet(packet, routed.packets);
+  }
+  routed.ok = file.last_read_response() == ReadNetPacketResponse::END_OF_FILE;
+  return routed;
+}
+
+bool Network1::write_file(const routed_file_t& routed) {
+  // Malformed packets are skipped, but the file is kept if any write fails,
+  // even one done by the writer before the final Flush.
+  const auto write_errors = writer_.write_errors();
+  for (const auto& r : routed.packets) {
+    netdat_.add_file_bytes(r.forsys, r.packet.length());
+    if (!writer_.Write(r.path, r.packet)) {
+      LOG(ERROR) << "error handing packet: type: " << r.packet.nh.main_type;
     }
-    if (response == ReadNetPacketResponse::ERROR) {
-      return false;
+  }
+  // Everything from this file needs to be written before it is deleted.
+  const auto flushed = writer_.Flush();
+  if (!flushed || writer_.write_errors() != write_errors) {
+    LOG(ERROR) << "Unable to write all of the packets from: " << routed.name << "; keeping it.";
+    return false;
+  }
+  return routed.ok;
+}
+
+void Network1::file_done(const std::string& name, bool handled) const {
+  if (!handled) {
+    return;
+  }
+  VLOG(1) << "Deleting: " << net_.dir.string() << name;
+  if (net_cmdline_.skip_delete()) {
+    backup_file(FilePath(net_.dir, name));
+  }
+  File::Remove(FilePath(net_.dir, name));
+}
+
+void Network1::handle_files(const std::vector<std::string>& names, int workers) {
+  if (workers <= 1) {
+    for (const auto& name : names) {
+      VLOG(1) << "Processing: " << net_.dir.string() << name;
+      file_done(name, write_file(route_file(name)));
     }
-    if (!handle_packet(packet)) {
-      LOG(ERROR) << "error handing packet: type: " << packet.nh.main_type;
+    return;
+  }
+
+  // Read and route up to workers files at once, while writing the results
+  // here in the same order as they would have been written one at a time.
+  std::deque<std::future<routed_file_t>> pending;
+  auto it = std::begin(names);
+  while (it != std::end(names) || !pending.empty()) {
+    while (it != std::end(names) && ssize(pending) < workers) {
+      VLOG(1) << "Processing: " << net_.dir.string() << *it;
+      pending.push_back(
+          std::async(std::launch::async, [this, name = *it] { return route_file(name); }));
+      ++it;
     }
+    const auto routed = pending.front().get();
+    pending.pop_front();
+    file_done(routed.name, write_file(routed));
   }
 }
 
@@ -160,16 +211,15 @@ bool Network1::Run() {
   try {
     LOG(INFO) << " * Analyzing " << net_.name << " pending files...";
     FindFiles ff(FilePath(net_.dir, "p*.net"), FindFiles::FindFilesType::files);
+    std::vector<std::string> names;
     for (const auto& f : ff) {
-      VLOG(1) << "Processing: " << net_.dir.string() << f.name;
-      if (handle_file(f.name)) {
-        VLOG(1) << "Deleting: " << net_.dir.string() << f.name;
-        if (net_cmdline_.skip_delete()) {
-          backup_file(FilePath(net_.dir, f.name));
-        }
-        File::Remove(FilePath(net_.dir, f.name));
-      }
+      names.push_back(f.name);
+    }
+    auto workers = net_cmdline_.cmdline().iarg("workers");
+    if (workers == 0) {
+      workers = static_cast<int>(std::thread::hardware_concurrency());
     }
+    handle_files(names, workers);
 
     // Update contact record.
     LOG(INFO) << " * Updating " << net_.name << " contact.net...";
@@ -217,6 +267,9 @@ int main(int argc, char** argv) {
 
   auto at_exit = finally(Logger::ExitLogger);
   CommandLine cmdline(argc, argv, "net");
+  cmdline.add_argument({"workers",
+                        "Number of inbound files to read and route at once (0 for one per CPU).",
+                        "1"});
   const NetworkCommandLine net_cmdline(cmdline, '1');
   if (!net_cmdline.IsInitialized() || net_cmdline.cmdline().help_requested()) {
     ShowHelp(net_cmdline);
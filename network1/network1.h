@@ -22,7 +22,9 @@
 #include "net_core/net_cmdline.h"
 #include "net_core/netdat.h"
 #include "sdk/net/packets.h"
+#include <filesystem>
 #include <string>
+#include <vector>
 
 
 namespace wwiv::sdk {
@@ -40,15 +42,41 @@ public:
   bool Run();
 
 private:
-  bool write_multiple_wwivnet_packets(const net_header_rec& nh, const std::vector<uint16_t>& list,
-                                      const std::string& text);
-  bool handle_packet(wwiv::sdk::net::NetPacket& p);
-  bool handle_file(const std::string& name);
+  // A packet to append to the outbound file path for system forsys.
+  struct routed_packet_t {
+    std::filesystem::path path;
+    uint16_t forsys;
+    wwiv::sdk::net::NetPacket packet;
+  };
+  // All of the routed packets from the inbound file name.
+  struct routed_file_t {
+    std::string name;
+    std::vector<routed_packet_t> packets;
+    // True if the whole file was read.
+    bool ok{false};
+  };
+
+  // Routing only reads the network configuration, so it is safe to call from
+  // more than one thread at once.
+  void route_multiple_wwivnet_packets(const net_header_rec& nh, const std::vector<uint16_t>& list,
+                                      const std::string& text,
+                                      std::vector<routed_packet_t>& out) const;
+  void route_packet(wwiv::sdk::net::NetPacket& p, std::vector<routed_packet_t>& out) const;
+  [[nodiscard]] routed_file_t route_file(const std::string& name) const;
+
+  // Writes the packets from an inbound file, returns true if it may be deleted.
+  bool write_file(const routed_file_t& routed);
+  void file_done(const std::string& name, bool handled) const;
+  // Handles the inbound files names, routing up to workers of them at once.
+  void handle_files(const std::vector<std::string>& names, int workers);
+
   const wwiv::net::NetworkCommandLine& net_cmdline_;
   const wwiv::sdk::BbsListNet& bbslist_;
   wwiv::core::Clock& clock_;
   const wwiv::sdk::net::Network& net_;
   wwiv::net::NetDat netdat_;
+  // Outbound packets, flushed after each inbound file.
+  wwiv::sdk::net::NetPacketWriter writer_;
 };
 
 #endif // INCLUDED_NET_NETWORK1_H
\ No newline at end of file
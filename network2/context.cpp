@@ -17,10 +17,15 @@
 /**************************************************************************/
 #include "network2/context.h"
 
+#include "core/stl.h"
+#include "core/strings.h"
+#include <algorithm>
 
 namespace wwiv::net::network2 {
 
 using namespace wwiv::sdk::net;
+using namespace wwiv::stl;
+using namespace wwiv::strings;
 
 Context::Context(const sdk::Config& c, const Network& n, sdk::UserManager& u,
                  const std::vector<Network>& ns, NetDat& netdat)
@@ -43,5 +48,69 @@ sdk::msgapi::MessageApi& Context::api(int type) {
 
 sdk::msgapi::WWIVMessageApi& Context::email_api() const { return *email_api_; }
 
+sdk::msgapi::MessageArea* Context::area(const sdk::subboard_t& sub) {
+  ++area_uses_;
+  if (const auto it = areas_.find(sub.filename); it != areas_.end()) {
+    it->second.last_used = area_uses_;
+    return it->second.area.get();
+  }
+  auto area = api(sub.storage_type).Open(sub, -1);
+  if (!area) {
+    return nullptr;
+  }
+  if (ssize(areas_) >= MAX_OPEN_AREAS) {
+    // Close the least recently used area, along with its cached posts.
+    const auto lru = std::min_element(
+        std::begin(areas_), std::end(areas_),
+        [](const auto& a, const auto& b) { return a.second.last_used < b.second.last_used; });
+    areas_.erase(lru);
+  }
+  auto* result = area.get();
+  areas_.emplace(sub.filename, open_area_t{std::move(area), area_uses_});
+  return result;
+}
+
+int Context::num_open_areas() const noexcept { return size_int(areas_); }
+
+const Context::subtype_entry_t* Context::find_subtype(const std::string& subtype) {
+  if (!subs_index_) {
+    subs_index_.emplace();
+    auto current = 0;
+    for (const auto& x : subs.subs()) {
+      for (const auto& n : x.nets) {
+        if (n.net_num != network_number) {
+          continue;
+        }
+        auto it = subs_index_->try_emplace(ToStringLowerCase(n.stype), subtype_entry_t{current}).first;
+        if (n.host == 0) {
+          it->second.hosted_here = true;
+        }
+      }
+      ++current;
+    }
+  }
+  const auto it = subs_index_->find(ToStringLowerCase(subtype));
+  return it == subs_index_->end() ? nullptr : &it->second;
+}
+
+std::optional<int> Context::find_sub(const std::string& subtype) {
+  if (const auto* e = find_subtype(subtype)) {
+    return e->subnum;
+  }
+  return std::nullopt;
+}
+
+bool Context::is_hosted_here(const std::string& subtype) {
+  const auto* e = find_subtype(subtype);
+  return e && e->hosted_here;
+}
+
+const sdk::Names& Context::names() {
+  if (!names_) {
+    names_ = std::make_unique<sdk::Names>(config);
+  }
+  return *names_;
+}
+
 
 }
@@ -20,12 +20,18 @@
 
 #include "net_core/netdat.h"
 #include "sdk/config.h"
+#include "sdk/names.h"
 #include "sdk/ssm.h"
 #include "sdk/msgapi/message_api_wwiv.h"
 #include "sdk/net/net.h"
 #include "sdk/subxtr.h"
 #include "sdk/usermanager.h"
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace wwiv::net::network2 {
@@ -56,6 +62,36 @@ public:
   [[nodiscard]] sdk::msgapi::MessageApi& api(int type);
   [[nodiscard]] sdk::msgapi::WWIVMessageApi& email_api() const;
 
+  /**
+   * Returns the message area for sub, opening it the first time it is used.
+   * Areas stay open so that their caches of post records and duplicate keys
+   * are reused for every inbound post. At most MAX_OPEN_AREAS are kept open,
+   * the least recently used one is closed to make room for another.
+   */
+  [[nodiscard]] sdk::msgapi::MessageArea* area(const sdk::subboard_t& sub);
+
+  /** Returns the number of message areas currently held open by area(). */
+  [[nodiscard]] int num_open_areas() const noexcept;
+
+  /** The most message areas area() keeps open at once. */
+  static constexpr int MAX_OPEN_AREAS = 32;
+
+  /**
+   * Returns the number of the first sub carrying subtype on this network,
+   * ignoring case. The index used is built from subs the first time it is
+   * needed, so invalidate_subs_index must be called when subs changes.
+   */
+  [[nodiscard]] std::optional<int> find_sub(const std::string& subtype);
+
+  /** Returns true if any sub carrying subtype on this network is hosted here. */
+  [[nodiscard]] bool is_hosted_here(const std::string& subtype);
+
+  /** Drops the subtype index so that it is rebuilt from subs when next used. */
+  void invalidate_subs_index() { subs_index_.reset(); }
+
+  /** Returns NAMES.LST, loading it the first time it is used. */
+  [[nodiscard]] const sdk::Names& names();
+
   [[nodiscard]] const std::vector<sdk::net::Network>& networks() const noexcept { return networks_; }
   [[nodiscard]] NetDat& netdat() const { return netdat_; }
 
@@ -75,6 +111,29 @@ public:
   sdk::SSM ssm;
   std::unique_ptr<std::vector<external_programs_t>> external_programs;
   std::set<int> external_programs_saved;
+
+private:
+  struct subtype_entry_t {
+    // Number of the first sub carrying the subtype.
+    int subnum{0};
+    // Any sub carrying it is hosted here.
+    bool hosted_here{false};
+  };
+  const subtype_entry_t* find_subtype(const std::string& subtype);
+
+  // Lower cased subtypes on this network. See find_sub().
+  std::optional<std::unordered_map<std::string, subtype_entry_t>> subs_index_;
+  struct open_area_t {
+    std::unique_ptr<sdk::msgapi::MessageArea> area;
+    // Value of area_uses_ when this area was last returned by area().
+    int64_t last_used{0};
+  };
+  // Open message areas keyed by sub filename. See area().
+  std::map<std::string, open_area_t> areas_;
+  // Number of calls to area(), used to find the least recently used area.
+  int64_t area_uses_{0};
+  // NAMES.LST. See names().
+  std::unique_ptr<sdk::Names> names_;
 };
 
 } // namespace wwiv::net::network2
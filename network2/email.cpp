@@ -47,23 +47,30 @@ using namespace wwiv::strings;
 namespace wwiv::net::network2 {
 
 // Gets the user number or 0 if it is not found.
-static int GetUserNumber(const std::string& name, UserManager& um) {
-  const auto max = um.num_user_records();
+static int GetUserNumber(const std::string& name, Context& context) {
+  // Handles are unique and all in NAMES.LST.
+  if (const auto user_number = context.names().FindUser(name); user_number > 0) {
+    return user_number;
+  }
+  // Real names are not in NAMES.LST, so those still need every user read.
+  // Also check the handle here in case NAMES.LST is out of date.
+  auto handle_pos = 0;
   auto realname_pos = 0;
-  for (auto i = 0; i <= max; i++) {
-    auto u = um.readuser(i);
-    if (!u) {
-      continue;
-    }
-    if (iequals(name, u->name())) {
-      return i;
+  context.user_manager.for_each_user([&](const User& u) {
+    if (iequals(name, u.name())) {
+      handle_pos = u.usernum();
+      return false;
     }
-    if (const auto matches_realname = iequals(name, u->real_name());
+    if (const auto matches_realname = iequals(name, u.real_name());
         matches_realname && realname_pos == 0) {
-      realname_pos = i;
+      realname_pos = u.usernum();
     } else if (matches_realname && realname_pos != 0) {
       LOG(WARNING) << "Duplicate real names";
     }
+    return true;
+  });
+  if (handle_pos != 0) {
+    return handle_pos;
   }
   // If we didn't find a handle, use the first known position
   // of the real name.  These are not guaranteed to be unique
@@ -79,7 +86,7 @@ bool handle_email_byname(Context& context, NetPacket& p) {
   // Rest of the message is the text.
   const auto text = std::string(iter, std::end(p.text()));
 
-  const auto user_number = GetUserNumber(to_name, context.user_manager);
+  const auto user_number = GetUserNumber(to_name, context);
   if (user_number == 0) {
     // Not found.
     LOG(ERROR) << "    ! ERROR Received email to user: '" << to_name << "' who is not found on this system; writing to dead.net";
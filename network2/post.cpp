@@ -49,24 +49,6 @@ using namespace wwiv::strings;
 
 namespace wwiv::net::network2 {
 
-static bool find_sub(const Subs& subs, int network_number, const std::string& netname, subboard_t& sub) {
-  auto current = 0;
-  for (const auto& x : subs.subs()) {
-    for (const auto& n : x.nets) {
-      if (n.net_num == network_number) {
-        if (iequals(netname, n.stype)) {
-          // Since the subtype matches, we need to find the subboard base filename.
-          // and return that.
-          sub = subs.sub(current);
-          return true;
-        }
-      }
-    }
-    ++current;
-  }
-  return false;
-}
-
 // Creates a single element vector of the echotag's info from the backbone list
 static std::vector<backbone_t> single_echo_backbone_list(std::vector<backbone_t> backbone,
                                                          std::string echotag) {
@@ -94,6 +76,8 @@ static bool attempt_auto_add(Context& context, const ParsedNetPacketText& ppt) {
   const auto echo = single_echo_backbone_list(backbone_echos, ppt.subtype());
   const auto r = ImportSubsFromBackbone(context.subs, context.net,
                                         static_cast<int16_t>(context.network_number), ini, echo);
+  // The import may have added a sub even if it then failed.
+  context.invalidate_subs_index();
   if (r.subs_dirty && r.success) {
     return context.subs.Save();
   } 
@@ -124,14 +108,13 @@ bool handle_inbound_post(Context& context, NetPacket& p) {
     VLOG(1) << "  Date:    " << ppt.date();
   }
 
-  subboard_t sub;
   const auto can_auto_add =
       context.net.settings.auto_add && context.net.type == network_type_t::ftn;
-  auto found = find_sub(context.subs, context.network_number, ppt.subtype(), sub);
-  if (!found && can_auto_add) {
+  auto subnum = context.find_sub(ppt.subtype());
+  if (!subnum && can_auto_add) {
     LOG(INFO) << "      Attempting to auto add area: " << ppt.subtype();
-    found = attempt_auto_add(context, ppt);
-    if (found) {
+    if (attempt_auto_add(context, ppt)) {
+      subnum = context.find_sub(ppt.subtype());
       // Log that we added this both in log file and netdat.
       const auto msg = fmt::format("Auto added sub for type: '{}'", ppt.subtype());
       LOG(INFO) << "      " << msg;
@@ -139,13 +122,14 @@ bool handle_inbound_post(Context& context, NetPacket& p) {
     }
   }
 
-  if (!found) {
+  if (!subnum) {
     LOG(INFO) << "    ! ERROR: Unable to find message of subtype: " << ppt.subtype();
     LOG(INFO) << "      title: " << ppt.title() << "; writing to dead.net.";
     const auto msg = fmt::format("Unable to find message of subtype: '{}'; writing to dead.net", ppt.subtype());
     context.netdat().add_message(NetDat::netdat_msgtype_t::error, msg);
     return write_deadnet_packet(context.net.dir, p);
   }
+  const auto& sub = context.subs.sub(*subnum);
 
   if (!context.api(sub.storage_type).Exist(sub)) {
     // Since the area does not exist, let's create it automatically like WWIV always does.
@@ -159,7 +143,7 @@ bool handle_inbound_post(Context& context, NetPacket& p) {
     }
   }
 
-  std::unique_ptr<MessageArea> area(context.api(sub.storage_type).Open(sub, -1));
+  auto* area = context.area(sub);
   if (!area) {
     const auto msg = fmt::format("Failed to open message area: '{}'; writing to dead.net", sub.filename);
     context.netdat().add_message(NetDat::netdat_msgtype_t::error, msg);
@@ -232,14 +216,15 @@ bool send_post_to_subscribers(Context& context, NetPacket& template_packet,
     return false;
   }
 
-  subboard_t sub;
-  if (!find_sub(context.subs, context.network_number, original_subtype, sub)) {
+  const auto subnum = context.find_sub(original_subtype);
+  if (!subnum) {
     const auto msg = fmt::format("Unable to find message of subtype: '{}'; writing to dead.net", original_subtype);
     context.netdat().add_message(NetDat::netdat_msgtype_t::error, msg);
     LOG(INFO) << msg;
     NetPacket p(template_packet.nh, {}, template_packet.text());
     return write_deadnet_packet(context.net.dir, p);
   }
+  const auto& sub = context.subs.sub(*subnum);
   VLOG(1) << "DEBUG: Found sub: " << sub.name;
 
   return send_post_to_subscribers(context.networks(), context.network_number, original_subtype, sub,
@@ -153,19 +153,6 @@ static bool send_sub_add_drop_resp(Context& context,
   return write_wwivnet_packet(FilePath(context.net.dir, pendfile), packet);
 }
 
-static bool IsHostedHere(Context& context, const std::string& subtype) {
-  for (const auto& x : context.subs.subs()) {
-    for (const auto& n : x.nets) {
-      if (iequals(subtype, n.stype) 
-          && n.host == 0
-          && n.net_num == context.network_number) {
-        return true;
-      }
-    }
-  }
-  return false;
-}
-
 bool handle_sub_add_req(Context& context, NetPacket& p) {
   const auto subtype = SubTypeFromText(p.text());
   const auto resp = [&](uint8_t code) -> bool {
@@ -183,7 +170,7 @@ bool handle_sub_add_req(Context& context, NetPacket& p) {
   if (subtype.empty()) {
     return resp(sub_adddrop_error);
   }
-  if (!IsHostedHere(context, subtype)) {
+  if (!context.is_hosted_here(subtype)) {
     const auto msg = fmt::format("Can't add system @{} to subtype: {}, it's not hosted here",p.nh.fromsys, subtype);
     context.ssm.send_local(1, msg);
     LOG(ERROR) << msg;
@@ -223,7 +210,7 @@ bool handle_sub_drop_req(Context& context, NetPacket& p) {
   if (subtype.empty()) {
     return resp(sub_adddrop_error);
   }
-  if (!IsHostedHere(context, subtype)) {
+  if (!context.is_hosted_here(subtype)) {
     return resp(sub_adddrop_not_host);
   }
   const auto filename = StrCat("n", subtype, ".net");
@@ -63,6 +63,8 @@ static void RegisterNetworkBCommands(CommandLine& cmdline) {
   cmdline.add_argument({"port", "Port number to use (receiving only)", "24554"});
   cmdline.add_argument(BooleanCommandLineArgument(
       "daemon", "Run continually as a daemon until stopped  (only used when receiving)", true));
+  cmdline.add_argument(BooleanCommandLineArgument(
+      "nr", "Use binkp non-reliable (NR) mode when the remote supports it", true));
 }
 
 static void ShowHelp(const NetworkCommandLine& cmdline) {
@@ -183,6 +185,7 @@ static int Main(const NetworkCommandLine& net_cmdline) {
     bink_config.set_skip_net(skip_net);
     bink_config.set_verbose(net_cmdline.cmdline().verbose());
     bink_config.set_network_version(status->status_net_version());
+    bink_config.set_nr(net_cmdline.cmdline().barg("nr"));
 
     for (const auto& n : bink_config.networks().networks()) {
       auto domain = ToStringLowerCase(n.name);
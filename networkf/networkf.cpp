@@ -165,10 +165,15 @@ bool NetworkF::import_packet_file(const std::filesystem::path& path) {
     return false;
   }
 
+  // All of the messages in this packet are written to LOCAL_NET with one
+  // write, and their dupe records appended to MSGDUPE_DAT once, after the
+  // whole packet has been read.
+  std::vector<NetPacket> wwiv_packets;
+  dupe().BeginBatch();
   while (true) {
     auto [response, msg] = packet.Read();
     if (response != ReadNetPacketResponse::OK) {
-      return true;
+      break;
     }
 
     const auto is_email = (msg.nh.attribute & MSGPRIVATE) != 0;
@@ -247,17 +252,26 @@ bool NetworkF::import_packet_file(const std::filesystem::path& path) {
     text.append(FidoToWWIVText(msg.vh.text));
 
     nh.length = size_uint32(text);
-    // Create file, write to local.net_ for network2 to import.
-    NetPacket wwiv_packet(nh, {}, text);
-    if (!write_wwivnet_packet(FilePath(net_.dir, LOCAL_NET), wwiv_packet)) {
-      LOG(ERROR) << "ERROR Writing WWIV packet for message: " << wwiv_packet.nh.main_type << "/"
-                 << wwiv_packet.nh.minor_type;
-    } else {
-      std::string itype = is_email ? "Email" : "Post";
-      LOG(INFO) << fmt::format("Imported FTN {} '{}' to '{}'", itype, msg.vh.subject, s1);
-    }
+    // Queue it to be written to local.net_ for network2 to import.
+    wwiv_packets.emplace_back(nh, std::vector<uint16_t>{}, text);
+    std::string itype = is_email ? "Email" : "Post";
+    LOG(INFO) << fmt::format("Imported FTN {} '{}' to '{}'", itype, msg.vh.subject, s1);
   }
 
+  // Write the messages before the dupe records. If we die in between, the
+  // next run will import them again and network2 discards the duplicates.
+  if (!write_wwivnet_packets(FilePath(net_.dir, LOCAL_NET), wwiv_packets)) {
+    LOG(ERROR) << "ERROR Writing " << wwiv_packets.size() << " WWIV packets for: " << path;
+    // Forget the dupe records so this packet is imported on the next run.
+    dupe().Rollback();
+    return false;
+  }
+  if (!dupe().Flush()) {
+    // Keep the packet so that it is imported again on the next run, network2
+    // discards the messages that were already written to local.net.
+    LOG(ERROR) << "ERROR Writing dupe records for: " << path;
+    return false;
+  }
   return true;
 }
 
@@ -600,14 +614,14 @@ std::optional<std::string> NetworkF::create_ftn_packet(const FidoAddress& dest,
       vh.to_user_name = "All";
     }
 
-    FtnMessageDupe dupe(datadir_, true);
+    auto& dupes = dupe();
     auto msgid = FtnMessageDupe::GetMessageIDFromWWIVText(raw_text);
     auto needs_msgid = false;
     if (msgid.empty()) {
       // Create a new MSGID if the BBS didn't put one in there already.
       // We'll do this for emails too since Mystic needs this for a proper
       // reply to address. Otherwise we'd just do it for conference mail.
-      msgid = dupe.CreateMessageID(from_address);
+      msgid = dupes.CreateMessageID(from_address);
       needs_msgid = true;
     }
 
@@ -701,7 +715,7 @@ std::optional<std::string> NetworkF::create_ftn_packet(const FidoAddress& dest,
     // Since we wrote the packed message, let's add it to the
     // duplicate message database if it's a post.
     if (!is_email) {
-      dupe.add(p);
+      dupes.add(p);
     }
     return file.path().filename().string();
   }
@@ -971,7 +985,7 @@ bool NetworkF::DoExport() {
     return false;
   }
 
-  NetMailFile file(path, true);
+  NetMailFileView file(path, true);
   if (!file) {
     LOG(ERROR) << "Unable to open file: " << path.string();
     return false;
@@ -979,7 +993,8 @@ bool NetworkF::DoExport() {
 
   std::set<std::string> bundles;
   auto num_packets_processed = 0;
-  for (auto p : file) {
+  for (const auto& view : file) {
+    auto p = view.ToNetPacket();
     // If we got here, we had a packet to process.
     ++num_packets_processed;
 
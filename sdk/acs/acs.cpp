@@ -19,6 +19,7 @@
 #include "sdk/acs/acs.h"
 
 #include "core/stl.h"
+#include "sdk/acs/compiled_expression.h"
 #include "sdk/acs/eval.h"
 #include "sdk/acs/eval_error.h"
 #include "common/value/uservalueprovider.h"
@@ -37,18 +38,26 @@ namespace wwiv::sdk::acs {
 std::tuple<bool, std::vector<std::string>>
 check_acs(const Config&, const std::string& expression,
   const std::vector<const ValueProvider*>& providers) {
+  std::vector<std::string> debug_lines;
+  const auto result = eval_acs(expression, providers, &debug_lines);
+  return std::make_tuple(result, debug_lines);
+}
+
+bool eval_acs(const std::string& expression, const std::vector<const ValueProvider*>& providers,
+              std::vector<std::string>* debug_lines) {
   if (StringTrim(expression).empty()) {
     // Empty expression is always allowed.
-    std::vector<std::string> debug_lines;
-    return std::make_tuple(true, debug_lines);
+    return true;
   }
 
-  Eval eval(expression);
-  for (const auto* p : providers) {
-    eval.add(p);
+  try {
+    return CompiledExpression::Get(expression)->eval_throws(providers, debug_lines);
+  } catch (const eval_error& error) {
+    if (debug_lines) {
+      debug_lines->emplace_back(error.what());
+    }
   }
-  const auto result = eval.eval();
-  return std::make_tuple(result, eval.debug_info());  
+  return false;
 }
 
 std::tuple<bool, std::string, std::vector<std::string>>
@@ -40,6 +40,12 @@ std::tuple<bool, std::vector<std::string>>
 check_acs(const Config& config, const std::string& expression,
           const std::vector<const value::ValueProvider*>& providers);
 
+// Same as check_acs, but only collects debug lines when debug_lines is not null.
+// Both use the process wide cache of compiled expressions.
+bool eval_acs(const std::string& expression,
+              const std::vector<const value::ValueProvider*>& providers,
+              std::vector<std::string>* debug_lines);
+
 template <typename... Args>
 std::tuple<bool, std::vector<std::string>>
 check_acs(const Config& config, const std::string& expression, Args... args) {
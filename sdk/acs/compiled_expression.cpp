@@ -0,0 +1,204 @@
+/**************************************************************************/
+/*                                                                        */
+/*                            WWIV Version 5                              */
+/*           Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/**************************************************************************/
+#include "sdk/acs/compiled_expression.h"
+
+#include "core/parser/ast.h"
+#include "core/parser/lexer.h"
+#include "core/stl.h"
+#include "core/strings.h"
+#include "fmt/format.h"
+#include "sdk/acs/eval_error.h"
+#include <mutex>
+#include <tuple>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace wwiv::core;
+using namespace wwiv::core::parser;
+using namespace wwiv::strings;
+using namespace wwiv::sdk::value;
+
+namespace wwiv::sdk::acs {
+
+// Expressions come from the BBS configuration, so this is only here to
+// bound the cache if something keeps evaluating new ones.
+static constexpr std::size_t MAX_CACHED_EXPRESSIONS = 4096;
+
+CompiledExpression::CompiledExpression(const std::string& expression) : expression_(expression) {
+  Lexer l(expression_);
+  if (!l.ok()) {
+    std::string error_token;
+    for (const auto& t : l.tokens()) {
+      if (t.type == TokenType::error) {
+        error_token += to_string(t);
+      }
+    }
+    error_ = fmt::format("Failed to lex expression: '{}'; \r\nError {}: ", expression_, error_token);
+    return;
+  }
+
+  Ast ast{};
+  if (!ast.parse(l)) {
+    parse_failed_ = true;
+    return;
+  }
+  const auto* root = ast.root();
+  if (!root) {
+    error_ = fmt::format("Failed to parse expression: '{}'.", expression_);
+    return;
+  }
+  if (root->ast_type() == AstType::AST_ERROR) {
+    error_ = dynamic_cast<const ErrorNode*>(root)->message;
+    return;
+  }
+  const auto* expr = dynamic_cast<const Expression*>(root);
+  if (!expr) {
+    error_ = fmt::format("Failed to parse expression: '{}'.", expression_);
+    return;
+  }
+  const auto id = compile(expr);
+  if (steps_.size() == 1 && steps_.front().type == step_type_t::constant) {
+    // A lone literal never has a value stored for it by Eval.
+    error_ = fmt::format("Unable to find expression id: '{}'.", id);
+  }
+}
+
+int CompiledExpression::compile(const Expression* n) {
+  if (const auto* f = dynamic_cast<const Factor*>(n)) {
+    step_t step{};
+    step.id = ++next_id_;
+    switch (f->factor_type()) {
+    case FactorType::int_value:
+      step.type = step_type_t::constant;
+      step.index = stl::size_int(constants_);
+      constants_.emplace_back(f->int_value());
+      break;
+    case FactorType::string_val:
+      step.type = step_type_t::constant;
+      step.index = stl::size_int(constants_);
+      constants_.emplace_back(f->value());
+      break;
+    case FactorType::variable: {
+      const auto name = f->value();
+      variable_t v{name, "", name};
+      if (name.find('.') != std::string::npos) {
+        std::tie(v.prefix, v.member) = SplitOnceLast(name, ".");
+      }
+      step.type = step_type_t::variable;
+      step.index = stl::size_int(variables_);
+      variables_.emplace_back(std::move(v));
+    } break;
+    }
+    steps_.push_back(step);
+    return step.id;
+  }
+
+  step_t step{};
+  step.type = step_type_t::op;
+  step.op = n->op();
+  step.left_id = compile(n->left());
+  step.right_id = compile(n->right());
+  step.id = ++next_id_;
+  steps_.push_back(step);
+  return step.id;
+}
+
+Value CompiledExpression::variable_value(const variable_t& v,
+                                         const std::vector<const ValueProvider*>& providers) const {
+  // Like Eval, the last provider added for a prefix wins.
+  for (auto it = providers.rbegin(); it != providers.rend(); ++it) {
+    if ((*it)->prefix() == v.prefix) {
+      if (auto o = (*it)->value(v.member)) {
+        return o.value();
+      }
+      break;
+    }
+  }
+  if (v.prefix.empty()) {
+    // Eval's DefaultValueProvider.
+    if (v.member == "true") {
+      return Value(true);
+    }
+    if (v.member == "false") {
+      return Value(false);
+    }
+  }
+  if (steps_.size() == 1) {
+    throw eval_error(fmt::format("Unable to find expression id: '{}'.", steps_.front().id));
+  }
+  throw eval_error(fmt::format("No object named '{}' exists.", v.name));
+}
+
+bool CompiledExpression::eval_throws(const std::vector<const ValueProvider*>& providers,
+                                     std::vector<std::string>* debug_info) const {
+  if (!error_.empty()) {
+    throw eval_error(error_);
+  }
+  if (parse_failed_) {
+    return false;
+  }
+
+  std::vector<Value> stack;
+  stack.reserve(steps_.size());
+  for (const auto& step : steps_) {
+    switch (step.type) {
+    case step_type_t::constant:
+      stack.push_back(constants_[step.index]);
+      break;
+    case step_type_t::variable:
+      stack.push_back(variable_value(variables_[step.index], providers));
+      break;
+    case step_type_t::op: {
+      auto right = std::move(stack.back());
+      stack.pop_back();
+      auto& left = stack.back();
+      auto result = Value::eval(left, step.op, right);
+      if (debug_info && result.is_boolean()) {
+        const auto eval_expr = fmt::format("{}(id:{}) {} {}(id:{})", left, step.left_id,
+                                           to_symbol(step.op), right, step.right_id);
+        debug_info->emplace_back(fmt::format("Expression '{}' evaluated to {}. Stored as id: '{}'",
+                                             eval_expr, result.as_boolean() ? "true" : "false",
+                                             step.id));
+      }
+      left = std::move(result);
+    } break;
+    }
+  }
+  return stack.back().as_boolean();
+}
+
+// static
+std::shared_ptr<const CompiledExpression> CompiledExpression::Get(const std::string& expression) {
+  static std::mutex mu;
+  static std::unordered_map<std::string, std::shared_ptr<const CompiledExpression>> cache;
+
+  std::lock_guard<std::mutex> lock(mu);
+  if (const auto it = cache.find(expression); it != std::end(cache)) {
+    return it->second;
+  }
+  if (cache.size() >= MAX_CACHED_EXPRESSIONS) {
+    cache.clear();
+  }
+  auto compiled = std::make_shared<const CompiledExpression>(expression);
+  cache.emplace(expression, compiled);
+  return compiled;
+}
+
+} // namespace wwiv::sdk::acs
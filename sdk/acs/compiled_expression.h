@@ -0,0 +1,91 @@
+/**************************************************************************/
+/*                                                                        */
+/*                            WWIV Version 5                              */
+/*           Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/**************************************************************************/
+#ifndef INCLUDED_SDK_ACS_COMPILED_EXPRESSION_H
+#define INCLUDED_SDK_ACS_COMPILED_EXPRESSION_H
+
+#include "core/parser/ast.h"
+#include "sdk/value/value.h"
+#include "sdk/value/valueprovider.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace wwiv::sdk::acs {
+
+/**
+ * An expression which has been lexed and parsed once into a flat list of
+ * steps in evaluation (postfix) order, with literals already converted to
+ * values and variable names already split into the provider prefix and
+ * attribute. Evaluating it does not touch the lexer or parser.
+ *
+ * Gives the same results as Eval.
+ */
+class CompiledExpression final {
+public:
+  explicit CompiledExpression(const std::string& expression);
+
+  /**
+   * Returns the compiled form of expression, compiling it only the first time
+   * it is seen by this process.
+   */
+  static std::shared_ptr<const CompiledExpression> Get(const std::string& expression);
+
+  /**
+   * Evaluates the expression against providers, throwing eval_error on
+   * failure. Debug lines are only created when debug_info is not null.
+   */
+  bool eval_throws(const std::vector<const value::ValueProvider*>& providers,
+                   std::vector<std::string>* debug_info) const;
+
+private:
+  enum class step_type_t { constant, variable, op };
+  struct step_t {
+    step_type_t type;
+    // Index into constants_ or variables_.
+    int index;
+    core::parser::Operator op;
+    // Ids used for debug_info.
+    int id;
+    int left_id;
+    int right_id;
+  };
+  struct variable_t {
+    std::string name;
+    std::string prefix;
+    std::string member;
+  };
+
+  int compile(const core::parser::Expression* n);
+  [[nodiscard]] value::Value
+  variable_value(const variable_t& v,
+                 const std::vector<const value::ValueProvider*>& providers) const;
+
+  const std::string expression_;
+  std::vector<step_t> steps_;
+  std::vector<value::Value> constants_;
+  std::vector<variable_t> variables_;
+  // Set when the expression will always fail with this error.
+  std::string error_;
+  // Set when the expression will always evaluate to false.
+  bool parse_failed_{false};
+  int next_id_{0};
+};
+
+} // namespace wwiv::sdk::acs
+
+#endif
@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*                                                                        */
+/*                              WWIV Version 5.x                          */
+/*               Copyright (C)2020-2022, WWIV Software Services           */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+#include "gtest/gtest.h"
+
+#include "sdk/acs/compiled_expression.h"
+#include "sdk/acs/eval.h"
+#include "sdk/acs/eval_error.h"
+#include "sdk/value/valueprovider.h"
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace wwiv::sdk::acs;
+using namespace wwiv::sdk::value;
+
+class TestValueProvider final : public ValueProvider {
+public:
+  TestValueProvider() : ValueProvider("user") {}
+  [[nodiscard]] std::optional<Value> value(const std::string& name) const override {
+    if (const auto it = values_.find(name); it != std::end(values_)) {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+  std::map<std::string, Value> values_;
+};
+
+class CompiledExpressionTest : public testing::Test {
+public:
+  CompiledExpressionTest() {
+    user_.values_.emplace("sl", Value(50));
+    user_.values_.emplace("name", Value("Rushfan"));
+    user_.values_.emplace("sysop", Value(false));
+    providers_.push_back(&user_);
+  }
+
+  // Returns the result from CompiledExpression after checking it matches Eval.
+  bool eval(const std::string& expression) {
+    Eval e(expression);
+    e.add(&user_);
+    const auto expected = e.eval();
+    bool actual = false;
+    try {
+      actual = CompiledExpression(expression).eval_throws(providers_, nullptr);
+    } catch (const eval_error&) {
+      EXPECT_TRUE(e.error()) << expression;
+    }
+    EXPECT_EQ(expected, actual) << expression;
+    return actual;
+  }
+
+  TestValueProvider user_;
+  std::vector<const ValueProvider*> providers_;
+};
+
+TEST_F(CompiledExpressionTest, Compare) {
+  EXPECT_TRUE(eval("user.sl > 20"));
+  EXPECT_FALSE(eval("user.sl < 20"));
+  EXPECT_TRUE(eval("user.name == \"Rushfan\""));
+  EXPECT_TRUE(eval("user.sysop == false"));
+}
+
+TEST_F(CompiledExpressionTest, Groups) {
+  EXPECT_TRUE(eval("(user.sl > 200 || user.sl > 20) && user.sysop == false"));
+  EXPECT_FALSE(eval("user.sl > 200 || (user.sl > 20 && user.sysop == true)"));
+}
+
+TEST_F(CompiledExpressionTest, Errors) {
+  EXPECT_FALSE(eval("user.foo > 20"));
+  EXPECT_FALSE(eval("foo == ~ foo"));
+  EXPECT_FALSE(eval("20"));
+}
+
+TEST_F(CompiledExpressionTest, DebugInfo) {
+  std::vector<std::string> debug_info;
+  EXPECT_TRUE(CompiledExpression("user.sl > 20").eval_throws(providers_, &debug_info));
+  EXPECT_EQ(1u, debug_info.size());
+}
+
+TEST_F(CompiledExpressionTest, Get_Caches) {
+  const auto a = CompiledExpression::Get("user.sl > 20");
+  EXPECT_EQ(a, CompiledExpression::Get("user.sl > 20"));
+  EXPECT_NE(a, CompiledExpression::Get("user.sl > 21"));
+}
+
+TEST_F(CompiledExpressionTest, Get_UsesCurrentValues) {
+  const auto c = CompiledExpression::Get("user.sl >= 100");
+  EXPECT_FALSE(c->eval_throws(providers_, nullptr));
+  user_.values_.insert_or_assign("sl", Value(100));
+  EXPECT_TRUE(c->eval_throws(providers_, nullptr));
+}
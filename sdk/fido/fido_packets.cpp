@@ -25,6 +25,7 @@
 #include "sdk/fido/fido_util.h"
 #include "sdk/net/packets.h"
 #include <algorithm>
+#include <cstring>
 #include <optional>
 #include <string>
 
@@ -34,14 +35,6 @@ using namespace wwiv::sdk::net;
 
 namespace wwiv::sdk::fido {
 
-static char ReadCharFromFile(File& f) {
-  char buf[1];
-  if (const auto num_read = f.Read(buf, 1); num_read == 0) {
-    return 0;
-  }
-  return buf[0];
-}
-
 static std::string ReadRestOfFile(File& f, int max_size) {
   auto current = f.current_position();
   const auto size = f.length();
@@ -76,16 +69,52 @@ static std::string ReadFixedLengthField(File& f, int len) {
  */
 static std::string ReadVariableLengthField(File& f, int max_len) {
   std::string s;
-  for (auto i = 0; i < max_len; i++) {
-    const auto ch = ReadCharFromFile(f);
-    if (ch == 0) {
+  char buf[256];
+  while (ssize(s) < max_len) {
+    const auto to_read = std::min<File::size_type>(sizeof(buf), max_len - ssize(s));
+    const auto num_read = f.Read(buf, to_read);
+    if (num_read <= 0) {
       return s;
     }
-    s.push_back(ch);
+    if (const auto* end = static_cast<const char*>(memchr(buf, 0, num_read))) {
+      s.append(buf, end - buf);
+      // Put back what was read past the end of the field.
+      f.Seek((end - buf) + 1 - num_read, File::Whence::current);
+      return s;
+    }
+    s.append(buf, num_read);
   }
   return s;
 }
 
+/**
+ * Returns the field of length {len} at the start of data, less any trailing
+ * nulls, and removes it from data.
+ */
+static std::string_view NextFixedLengthField(std::string_view& data, std::size_t len) {
+  auto s = data.substr(0, len);
+  data.remove_prefix(s.size());
+  while (!s.empty() && s.back() == '\0') {
+    // Remove trailing null characters.
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+/**
+ * Returns the null-terminated field of up to length {len} at the start of
+ * data, and removes it (and the null) from data.
+ */
+static std::string_view NextVariableLengthField(std::string_view& data, std::size_t max_len) {
+  auto s = data.substr(0, max_len);
+  if (const auto end = s.find('\0'); end != std::string_view::npos) {
+    data.remove_prefix(end + 1);
+    return s.substr(0, end);
+  }
+  data.remove_prefix(s.size());
+  return s;
+}
+
 FidoStoredMessage::~FidoStoredMessage()  = default;
 
 bool write_fido_packet_header(File& f, const packet_header_2p_t& header) {
@@ -164,6 +193,38 @@ ReadNetPacketResponse read_packed_message(File& f, FidoPackedMessage& packet) {
   return ReadNetPacketResponse::OK;
 }
 
+ReadNetPacketResponse read_packed_message(std::string_view& data, FidoPackedMessage& packet) {
+  const auto num_read = std::min(data.size(), sizeof(fido_packed_message_t));
+  memcpy(&packet.nh, data.data(), num_read);
+  data.remove_prefix(num_read);
+  if (num_read == 0) {
+    // at the end of the packet.
+    return ReadNetPacketResponse::END_OF_FILE;
+  }
+  if (num_read == 2) {
+    // FIDO packets have 2 bytes of NULL at the end;
+    if (packet.nh.message_type == 0) {
+      return ReadNetPacketResponse::END_OF_FILE;
+    }
+  }
+
+  if (num_read != sizeof(fido_packed_message_t)) {
+    LOG(INFO) << "error reading header, got short read of size: " << num_read
+              << "; expected: " << sizeof(fido_packed_message_t);
+    return ReadNetPacketResponse::ERROR;
+  }
+
+  if (packet.nh.message_type != 2) {
+    LOG(INFO) << "invalid message_type: " << packet.nh.message_type << "; expected: 2";
+  }
+  packet.vh.date_time = NextFixedLengthField(data, 20);
+  packet.vh.to_user_name = NextVariableLengthField(data, 36);
+  packet.vh.from_user_name = NextVariableLengthField(data, 36);
+  packet.vh.subject = NextVariableLengthField(data, 72);
+  packet.vh.text = NextVariableLengthField(data, 256 * 1024);
+  return ReadNetPacketResponse::OK;
+}
+
 ReadNetPacketResponse read_stored_message(File& f, FidoStoredMessage& packet) {
   if (const auto num_read = f.Read(&packet.nh, sizeof(fido_stored_message_t)); num_read == 0) {
     // at the end of the packet.
@@ -226,12 +287,18 @@ std::optional<FidoPacket> FidoPacket::Open(const std::filesystem::path& path) {
   }
 
   FidoPacket packet(std::move(f), true);
-  auto num_header_read = packet.file_.Read(&packet.header_, sizeof(packet_header_2p_t));
-  if (num_header_read < static_cast<int>(sizeof(packet_header_2p_t))) {
+  packet.mapping_ = FileMapping(packet.file_);
+  if (!packet.mapping_) {
+    LOG(ERROR) << "Unable to read packet: " << path.string();
+    return std::nullopt;
+  }
+  packet.data_ = std::string_view(packet.mapping_.data(), packet.mapping_.size());
+  if (packet.data_.size() < sizeof(packet_header_2p_t)) {
     LOG(ERROR) << "Read less than packet header";
     return std::nullopt;
   }
-
+  memcpy(&packet.header_, packet.data_.data(), sizeof(packet_header_2p_t));
+  packet.data_.remove_prefix(sizeof(packet_header_2p_t));
   return packet;
 }
 
@@ -286,6 +353,10 @@ bool FidoPacket::Write(const FidoPackedMessage& packet) {
 
 std::tuple<wwiv::sdk::net::ReadNetPacketResponse, FidoPackedMessage> FidoPacket::Read() {
   FidoPackedMessage msg;
+  if (mapping_) {
+    auto response = read_packed_message(data_, msg);
+    return std::make_tuple(response, msg);
+  }
   auto response = read_packed_message(file_, msg);
   return std::make_tuple(response, msg);
 }
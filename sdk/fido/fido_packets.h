@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -232,6 +233,10 @@ public:
 
 /**
  * Represents a .PKT file in FidoNET.
+ *
+ * Packets opened with Open are read from a memory mapping of the whole file
+ * (see core::FileMapping), so reading the messages does not need a system
+ * call per field.
  */
 class FidoPacket {
 public:
@@ -245,7 +250,8 @@ public:
   static std::optional<FidoPacket> Open(const std::filesystem::path& path);
 
   FidoPacket(FidoPacket&& o) noexcept
-      : file_(std::move(o.file_)), writable_(o.writable_), header_(o.header_) {}
+      : file_(std::move(o.file_)), writable_(o.writable_), header_(o.header_),
+        mapping_(std::move(o.mapping_)), data_(o.data_) {}
 
   bool Write(const FidoPackedMessage& packet);
   [[nodiscard]] std::tuple<wwiv::sdk::net::ReadNetPacketResponse, FidoPackedMessage> Read();
@@ -262,6 +268,10 @@ private:
   wwiv::core::File file_;
   bool writable_{false};
   packet_header_2p_t header_{};
+  // Contents of the packet when opened for reading.
+  wwiv::core::FileMapping mapping_;
+  // The unread part of mapping_.
+  std::string_view data_;
 };
   
 bool write_fido_packet_header(wwiv::core::File& f, const packet_header_2p_t& header);
@@ -270,6 +280,11 @@ bool write_stored_message(wwiv::core::File& f, FidoStoredMessage& packet);
 
 wwiv::sdk::net::ReadNetPacketResponse read_packed_message(wwiv::core::File& file,
                                                        FidoPackedMessage& packet);
+/**
+ * Reads a packed message from the start of data, and removes it from data.
+ */
+wwiv::sdk::net::ReadNetPacketResponse read_packed_message(std::string_view& data,
+                                                       FidoPackedMessage& packet);
 wwiv::sdk::net::ReadNetPacketResponse read_stored_message(wwiv::core::File& file,
                                                        FidoStoredMessage& packet);
 packet_header_2p_t CreateType2PlusPacketHeader(const FidoAddress& from_address,
@@ -97,4 +97,61 @@ TEST_F(FidoPacketsTestDataTest, ThreeMessages) {
     auto [result, msg] = packet.Read();
     ASSERT_EQ(ReadNetPacketResponse::END_OF_FILE, result);
   }
-}
\ No newline at end of file
+}
+
+static std::string PackedMessage(const std::string& to, const std::string& subject,
+                                 const std::string& text) {
+  fido_packed_message_t nh{};
+  nh.message_type = 2;
+  std::string s(reinterpret_cast<const char*>(&nh), sizeof(fido_packed_message_t));
+  s.append("01 Jan 22  00:00:00");
+  s.push_back('\0');
+  s.append(to).push_back('\0');
+  s.append("Sysop").push_back('\0');
+  s.append(subject).push_back('\0');
+  s.append(text).push_back('\0');
+  return s;
+}
+
+TEST(FidoPacketsTest, ReadPackedMessage_StringView) {
+  auto contents = PackedMessage("All", "test 1", "Hello") + PackedMessage("Bob", "test 2", "World");
+  contents.append(2, '\0');
+  std::string_view data{contents};
+
+  FidoPackedMessage msg;
+  ASSERT_EQ(ReadNetPacketResponse::OK, read_packed_message(data, msg));
+  EXPECT_EQ("01 Jan 22  00:00:00", msg.vh.date_time);
+  EXPECT_EQ("All", msg.vh.to_user_name);
+  EXPECT_EQ("Sysop", msg.vh.from_user_name);
+  EXPECT_EQ("test 1", msg.vh.subject);
+  EXPECT_EQ("Hello", msg.vh.text);
+
+  ASSERT_EQ(ReadNetPacketResponse::OK, read_packed_message(data, msg));
+  EXPECT_EQ("Bob", msg.vh.to_user_name);
+  EXPECT_EQ("World", msg.vh.text);
+
+  EXPECT_EQ(ReadNetPacketResponse::END_OF_FILE, read_packed_message(data, msg));
+  EXPECT_TRUE(data.empty());
+}
+
+TEST(FidoPacketsTest, ReadPackedMessage_File) {
+  FileHelper helper;
+  const auto path = helper.CreateTempFilePath("test.pkt");
+  {
+    File w(path);
+    ASSERT_TRUE(w.Open(File::modeBinary | File::modeCreateFile | File::modeWriteOnly));
+    w.Write(PackedMessage("All", "test 1", "Hello") + PackedMessage("Bob", "test 2", "World"));
+  }
+  File f(path);
+  ASSERT_TRUE(f.Open(File::modeBinary | File::modeReadOnly));
+
+  FidoPackedMessage msg;
+  ASSERT_EQ(ReadNetPacketResponse::OK, read_packed_message(f, msg));
+  EXPECT_EQ("All", msg.vh.to_user_name);
+  EXPECT_EQ("Hello", msg.vh.text);
+  ASSERT_EQ(ReadNetPacketResponse::OK, read_packed_message(f, msg));
+  EXPECT_EQ("Bob", msg.vh.to_user_name);
+  EXPECT_EQ("test 2", msg.vh.subject);
+  EXPECT_EQ("World", msg.vh.text);
+  EXPECT_EQ(ReadNetPacketResponse::END_OF_FILE, read_packed_message(f, msg));
+}
@@ -80,6 +80,7 @@ constexpr auto CHAINS_JSON = "chains.json";
 #define EDITOR_INF "editor.inf"
 #define EDITOR_NOEXT "editor"
 #define EMAIL_DAT "email.dat"
+#define EMAIL_IDX "email.idx"
 #define EMAIL_NOEXT "email"
 #define EPROGS_NET "eprogs.net"
 
@@ -175,6 +176,7 @@ constexpr auto CHAINS_JSON = "chains.json";
 #define SUBS_JSON "subs.json"
 #define SUBS_LST "subs.lst"
 #define SUBS_NOEXT "subs"
+#define SUBS_QSCAN_DAT "subsqscn.dat"
 #define SUBS_XTR "subs.xtr"
 #define SWFC_NOEXT "swfc"
 #define SYSTEM_NOEXT "system"
@@ -289,15 +289,13 @@ Instance Instances::at(size_type pos) {
 
 // ReSharper disable once CppMemberFunctionMayBeConst
 std::vector<Instance> Instances::all() {
-  if (auto file = DataFile<instancerec>(path_, File::modeBinary | File::modeReadOnly)) {
-    std::vector<instancerec> ir;
-    if (file.ReadVector(ir)) {
-      std::vector<Instance> r;
-      for (const auto& i : ir) {
-        r.emplace_back(root_dir_, data_dir_, i);
-      }
-      return r;
+  if (const DataFileView<instancerec> view(path_); view) {
+    std::vector<Instance> r;
+    r.reserve(view.size());
+    for (const auto& i : view) {
+      r.emplace_back(root_dir_, data_dir_, i);
     }
+    return r;
   }
   return {};
 }
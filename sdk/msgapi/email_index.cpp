@@ -0,0 +1,316 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*             Copyright (C)2015-2022, WWIV Software Services             */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/**************************************************************************/
+#include "sdk/msgapi/email_index.h"
+
+#include "core/datafile.h"
+#include "core/file.h"
+#include "core/log.h"
+#include "core/stl.h"
+#include "sdk/filenames.h"
+#include "sdk/vardec.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace wwiv::sdk::msgapi {
+
+using namespace wwiv::core;
+
+static constexpr char EMAIL_INDEX_SIGNATURE[] = "WWIVEIDX";
+static constexpr uint32_t EMAIL_INDEX_REVISION = 1;
+
+static email_index_entry_t to_entry(const mailrec& m) {
+  email_index_entry_t e{};
+  e.touser = m.touser;
+  e.tosys = m.tosys;
+  e.fromuser = m.fromuser;
+  e.fromsys = m.fromsys;
+  e.status = m.status;
+  e.deleted = (m.tosys == 0 && m.touser == 0 && m.daten == 0xffffffff) ? 1 : 0;
+  return e;
+}
+
+EmailIndex::EmailIndex(const std::filesystem::path& email_dat)
+    : email_dat_(email_dat), path_(email_dat.parent_path() / EMAIL_IDX) {}
+
+bool EmailIndex::Load() {
+  const auto stamp = email_stamp();
+  if (!stamp) {
+    return false;
+  }
+  if (LoadIndexFile(stamp.value())) {
+    return true;
+  }
+  return Rebuild();
+}
+
+bool EmailIndex::Load(DataFile<mailrec>& email_file) {
+  const auto stamp = email_stamp();
+  if (!stamp) {
+    return false;
+  }
+  if (LoadIndexFile(stamp.value())) {
+    return true;
+  }
+  return Rebuild(email_file);
+}
+
+bool EmailIndex::Rebuild() {
+  DataFile<mailrec> email_file(email_dat_, File::modeBinary | File::modeReadOnly);
+  if (!email_file) {
+    return false;
+  }
+  return Rebuild(email_file);
+}
+
+bool EmailIndex::Rebuild(DataFile<mailrec>& email_file) {
+  if (!email_file) {
+    return false;
+  }
+  const DataFileView<mailrec> records(email_file);
+  if (!records) {
+    LOG(ERROR) << "Unable to read: " << email_dat_;
+    return false;
+  }
+  Build(records);
+  VLOG(1) << "Rebuilt " << path_ << " with " << records.size() << " records.";
+
+  // Write the index while email_file is still open, so nobody can change
+  // EMAIL.DAT between reading it and stamping the index.
+  if (const auto stamp = email_stamp(); !stamp || !Save(stamp.value())) {
+    // The index in memory is still good, it'll just be rebuilt next time.
+    LOG(WARNING) << "Unable to write: " << path_;
+  }
+  return true;
+}
+
+bool EmailIndex::Update(int recno, const mailrec& m) {
+  if (recno < 0) {
+    return false;
+  }
+  if (const auto old_size = stl::size_int(entries_); recno >= old_size) {
+    // Any records skipped over are all zeros, which is not a deleted mailrec.
+    num_messages_ += recno - old_size;
+    entries_.resize(recno + 1);
+  } else {
+    remove_from_user(recno);
+    if (!entries_[recno].deleted) {
+      --num_messages_;
+    }
+  }
+  entries_[recno] = to_entry(m);
+  add_to_user(recno);
+  if (!entries_[recno].deleted) {
+    ++num_messages_;
+  }
+
+  const auto stamp = email_stamp();
+  if (!stamp) {
+    return false;
+  }
+  if (!saved_) {
+    return Save(stamp.value());
+  }
+  File file(path_);
+  if (!file.Open(File::modeBinary | File::modeReadWrite)) {
+    saved_ = false;
+    return false;
+  }
+  const auto header = make_header(stamp.value());
+  const auto offset = static_cast<File::size_type>(sizeof(email_index_header_t) +
+                                                   recno * sizeof(email_index_entry_t));
+  if (file.Seek(offset, File::Whence::begin) != offset ||
+      file.Write(&entries_[recno], sizeof(email_index_entry_t)) != sizeof(email_index_entry_t) ||
+      file.Seek(0, File::Whence::begin) != 0 ||
+      file.Write(&header, sizeof(email_index_header_t)) != sizeof(email_index_header_t)) {
+    // The header no longer matches EMAIL.DAT, so the next Load will rebuild it.
+    saved_ = false;
+    return false;
+  }
+  return true;
+}
+
+int EmailIndex::number_of_records() const noexcept {
+  return stl::size_int(entries_);
+}
+
+int EmailIndex::next_free_record() const noexcept {
+  for (auto recno = stl::ssize(entries_) - 1; recno >= 0; recno--) {
+    if (const auto& e = entries_[recno]; e.tosys || e.touser) {
+      return static_cast<int>(recno + 1);
+    }
+  }
+  return 0;
+}
+
+int EmailIndex::unread(int user_number) const {
+  const auto it = to_user_.find(static_cast<uint16_t>(user_number));
+  if (it == std::end(to_user_)) {
+    return 0;
+  }
+  return static_cast<int>(std::count_if(std::begin(it->second), std::end(it->second),
+                                        [this](int recno) {
+                                          return !(entries_[recno].status & status_seen);
+                                        }));
+}
+
+std::vector<int> EmailIndex::mail_to(int user_number) const {
+  if (const auto it = to_user_.find(static_cast<uint16_t>(user_number));
+      it != std::end(to_user_)) {
+    return it->second;
+  }
+  return {};
+}
+
+std::vector<int> EmailIndex::mail_to_or_from(int user_number) const {
+  std::vector<int> result;
+  for (auto recno = 0; recno < stl::ssize(entries_); recno++) {
+    if (const auto& e = entries_[recno];
+        (e.tosys == 0 && e.touser == user_number) ||
+        (e.fromsys == 0 && e.fromuser == user_number)) {
+      result.push_back(recno);
+    }
+  }
+  return result;
+}
+
+// Implementation Details
+
+std::optional<EmailIndex::email_stamp_t> EmailIndex::email_stamp() const {
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(email_dat_, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  const auto last_write_time = std::filesystem::last_write_time(email_dat_, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return email_stamp_t{static_cast<int64_t>(size),
+                       static_cast<int64_t>(last_write_time.time_since_epoch().count())};
+}
+
+email_index_header_t EmailIndex::make_header(const email_stamp_t& stamp) const {
+  email_index_header_t h{};
+  memcpy(h.signature, EMAIL_INDEX_SIGNATURE, sizeof(h.signature));
+  h.revision = EMAIL_INDEX_REVISION;
+  h.num_records = static_cast<uint32_t>(entries_.size());
+  h.email_size = stamp.size;
+  h.email_last_write_time = stamp.last_write_time;
+  return h;
+}
+
+bool EmailIndex::LoadIndexFile(const email_stamp_t& stamp) {
+  File file(path_);
+  if (!File::Exists(path_) || !file.Open(File::modeBinary | File::modeReadOnly)) {
+    return false;
+  }
+  email_index_header_t h{};
+  if (file.Read(&h, sizeof(email_index_header_t)) != sizeof(email_index_header_t)) {
+    return false;
+  }
+  if (memcmp(h.signature, EMAIL_INDEX_SIGNATURE, sizeof(h.signature)) != 0 ||
+      h.revision != EMAIL_INDEX_REVISION || h.email_size != stamp.size ||
+      h.email_last_write_time != stamp.last_write_time ||
+      h.num_records != static_cast<uint32_t>(stamp.size / sizeof(mailrec))) {
+    VLOG(1) << path_ << " is out of date.";
+    return false;
+  }
+  const auto entries_size = static_cast<File::size_type>(h.num_records * sizeof(email_index_entry_t));
+  if (file.length() != static_cast<File::size_type>(sizeof(email_index_header_t)) + entries_size) {
+    return false;
+  }
+  std::vector<email_index_entry_t> entries(h.num_records);
+  if (!entries.empty() && file.Read(&entries[0], entries_size) != entries_size) {
+    return false;
+  }
+  entries_ = std::move(entries);
+  IndexEntries();
+  saved_ = true;
+  return true;
+}
+
+void EmailIndex::Build(const DataFileView<mailrec>& records) {
+  entries_.clear();
+  entries_.reserve(static_cast<size_t>(records.size()));
+  for (const auto& m : records) {
+    entries_.push_back(to_entry(m));
+  }
+  IndexEntries();
+  saved_ = false;
+}
+
+void EmailIndex::IndexEntries() {
+  to_user_.clear();
+  num_messages_ = 0;
+  for (auto recno = 0; recno < stl::ssize(entries_); recno++) {
+    add_to_user(recno);
+    if (!entries_[recno].deleted) {
+      ++num_messages_;
+    }
+  }
+}
+
+bool EmailIndex::Save(const email_stamp_t& stamp) {
+  saved_ = false;
+  File file(path_);
+  if (!file.Open(File::modeBinary | File::modeReadWrite | File::modeCreateFile)) {
+    return false;
+  }
+  const auto header = make_header(stamp);
+  const auto entries_size = static_cast<File::size_type>(entries_.size() * sizeof(email_index_entry_t));
+  if (file.Write(&header, sizeof(email_index_header_t)) != sizeof(email_index_header_t)) {
+    return false;
+  }
+  if (!entries_.empty() && file.Write(&entries_[0], entries_size) != entries_size) {
+    return false;
+  }
+  if (!file.set_length(static_cast<File::size_type>(sizeof(email_index_header_t)) + entries_size)) {
+    return false;
+  }
+  saved_ = true;
+  return true;
+}
+
+void EmailIndex::add_to_user(int recno) {
+  const auto& e = entries_[recno];
+  if (e.tosys != 0 || e.touser == 0) {
+    return;
+  }
+  auto& v = to_user_[e.touser];
+  v.insert(std::upper_bound(std::begin(v), std::end(v), recno), recno);
+}
+
+void EmailIndex::remove_from_user(int recno) {
+  const auto& e = entries_[recno];
+  const auto it = to_user_.find(e.touser);
+  if (it == std::end(to_user_)) {
+    return;
+  }
+  auto& v = it->second;
+  if (const auto r = std::lower_bound(std::begin(v), std::end(v), recno);
+      r != std::end(v) && *r == recno) {
+    v.erase(r);
+  }
+  if (v.empty()) {
+    to_user_.erase(it);
+  }
+}
+
+}  // namespace
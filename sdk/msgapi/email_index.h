@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*                                                                        */
+/*                            WWIV Version 5                              */
+/*             Copyright (C)2015-2022, WWIV Software Services             */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/**************************************************************************/
+#ifndef INCLUDED_SDK_MSGAPI_EMAIL_INDEX_H
+#define INCLUDED_SDK_MSGAPI_EMAIL_INDEX_H
+
+#include "core/datafile.h"
+#include "sdk/vardec.h"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace wwiv::sdk::msgapi {
+
+#pragma pack(push, 1)
+struct email_index_header_t {
+  // "WWIVEIDX"
+  char signature[8];
+  uint32_t revision;
+  // Number of entries, one per mailrec in EMAIL.DAT.
+  uint32_t num_records;
+  // Size of EMAIL.DAT when this index was written.
+  int64_t email_size;
+  // Last write time of EMAIL.DAT (in file clock ticks) when this index was written.
+  int64_t email_last_write_time;
+};
+
+struct email_index_entry_t {
+  uint16_t touser;
+  uint16_t tosys;
+  uint16_t fromuser;
+  uint16_t fromsys;
+  uint8_t status;
+  // 1 if this mailrec has been deleted.
+  uint8_t deleted;
+  uint16_t reserved;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(email_index_header_t) == 32);
+static_assert(sizeof(email_index_entry_t) == 12);
+
+/**
+ * Mailbox index for EMAIL.DAT, stored next to it as EMAIL_IDX.
+ *
+ * Holds one small entry per mailrec (who it is to and from, and the
+ * status), so that counting or finding the mail for a single user does not
+ * need to read every mailrec.
+ *
+ * The BBS still writes to EMAIL.DAT directly in many places, so the index
+ * remembers the size and last write time of EMAIL.DAT it was built from, and
+ * is rebuilt from EMAIL.DAT whenever those no longer match.
+ */
+class EmailIndex final {
+public:
+  /** email_dat is the full path to EMAIL.DAT */
+  explicit EmailIndex(const std::filesystem::path& email_dat);
+
+  /**
+   * Loads EMAIL_IDX, rebuilding it from EMAIL.DAT if it is missing or out
+   * of date. Returns false if EMAIL.DAT does not exist or can not be read.
+   */
+  bool Load();
+  /**
+   * Same as Load, but reads EMAIL.DAT through email_file. Use this when
+   * already holding EMAIL.DAT open, since opening it again would block on
+   * our own lock.
+   */
+  bool Load(core::DataFile<mailrec>& email_file);
+  /** Rebuilds the index from EMAIL.DAT and writes EMAIL_IDX */
+  bool Rebuild();
+  bool Rebuild(core::DataFile<mailrec>& email_file);
+
+  /**
+   * Records that email record recno now contains m. Call this right after
+   * writing m to EMAIL.DAT, while still holding it open.
+   */
+  bool Update(int recno, const mailrec& m);
+
+  /** Number of records in EMAIL.DAT, including deleted ones */
+  [[nodiscard]] int number_of_records() const noexcept;
+  /** Number of email messages that are not deleted */
+  [[nodiscard]] int number_of_messages() const noexcept { return num_messages_; }
+  /**
+   * Returns the record number following the last record in use, which
+   * is where new email is written.
+   */
+  [[nodiscard]] int next_free_record() const noexcept;
+  /** Number of local email messages to user_number that have not been seen */
+  [[nodiscard]] int unread(int user_number) const;
+  /** Record numbers of local email to user_number, lowest first */
+  [[nodiscard]] std::vector<int> mail_to(int user_number) const;
+  /** Record numbers of local email to or from user_number, lowest first */
+  [[nodiscard]] std::vector<int> mail_to_or_from(int user_number) const;
+
+private:
+  struct email_stamp_t {
+    int64_t size;
+    int64_t last_write_time;
+  };
+  [[nodiscard]] std::optional<email_stamp_t> email_stamp() const;
+  [[nodiscard]] email_index_header_t make_header(const email_stamp_t& stamp) const;
+  bool LoadIndexFile(const email_stamp_t& stamp);
+  void Build(const core::DataFileView<mailrec>& records);
+  /** Recreates to_user_ and num_messages_ from entries_ */
+  void IndexEntries();
+  bool Save(const email_stamp_t& stamp);
+  void add_to_user(int recno);
+  void remove_from_user(int recno);
+
+  const std::filesystem::path email_dat_;
+  const std::filesystem::path path_;
+  // One entry per mailrec, indexed by record number.
+  std::vector<email_index_entry_t> entries_;
+  // Record numbers of local (tosys == 0) email for each touser, sorted.
+  std::unordered_map<uint16_t, std::vector<int>> to_user_;
+  int num_messages_{0};
+  // True when EMAIL_IDX on disk matches entries_, so Update only needs to
+  // rewrite a single entry.
+  bool saved_{false};
+};
+
+}  // namespace
+
+#endif
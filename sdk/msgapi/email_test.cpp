@@ -21,12 +21,14 @@
 #include <memory>
 #include <string>
 
+#include "core/datafile.h"
 #include "core/file.h"
 #include <filesystem>
 #include "core/strings.h"
 #include "sdk/config.h"
 #include "core/datetime.h"
 #include "sdk/filenames.h"
+#include "sdk/msgapi/email_index.h"
 #include "sdk/msgapi/email_wwiv.h"
 #include "sdk/msgapi/msgapi.h"
 #include "sdk/msgapi/message_api_wwiv.h"
@@ -98,3 +100,46 @@ TEST_F(EmailTest, Delete) {
   EXPECT_FALSE(email->read_email_header(1, nm));
   EXPECT_TRUE(email->read_email_header(2, nm));
 }
+
+TEST_F(EmailTest, Index) {
+  ASSERT_TRUE(Add(1, 2, "Title", "Text"));
+  ASSERT_TRUE(Add(1, 2, "Title2", "Text2"));
+  ASSERT_TRUE(Add(2, 3, "Title3", "Text3"));
+  ASSERT_TRUE(email->DeleteMessage(0));
+  EXPECT_TRUE(File::Exists(FilePath(helper.datadir(), EMAIL_IDX)));
+
+  EmailIndex index(FilePath(helper.datadir(), EMAIL_DAT));
+  ASSERT_TRUE(index.Load());
+  EXPECT_EQ(3, index.number_of_records());
+  EXPECT_EQ(2, index.number_of_messages());
+  EXPECT_EQ(1, index.unread(2));
+  EXPECT_EQ(1, index.unread(3));
+  EXPECT_EQ(0, index.unread(1));
+  EXPECT_EQ(std::vector<int>{1}, index.mail_to(2));
+  EXPECT_EQ((std::vector<int>{1, 2}), index.mail_to_or_from(2));
+}
+
+TEST_F(EmailTest, Index_RebuildsWhenStale) {
+  ASSERT_TRUE(Add(1, 2, "Title", "Text"));
+  ASSERT_TRUE(Add(1, 2, "Title2", "Text2"));
+  email.reset();
+
+  // Mark the 2nd email as seen the way the BBS does, writing EMAIL.DAT directly.
+  {
+    DataFile<mailrec> file(FilePath(helper.datadir(), EMAIL_DAT),
+                           File::modeBinary | File::modeReadWrite);
+    ASSERT_TRUE(file);
+    mailrec m{};
+    ASSERT_TRUE(file.Read(1, &m));
+    m.status |= status_seen;
+    ASSERT_TRUE(file.Write(1, &m));
+    // Also grow the file, so the change is seen even within the same file time tick.
+    const mailrec empty{};
+    ASSERT_TRUE(file.Write(2, &empty));
+  }
+
+  EmailIndex index(FilePath(helper.datadir(), EMAIL_DAT));
+  ASSERT_TRUE(index.Load());
+  EXPECT_EQ(3, index.number_of_records());
+  EXPECT_EQ(1, index.unread(2));
+}
@@ -46,7 +46,7 @@ WWIVEmail::WWIVEmail(const Config& config, const std::filesystem::path& data_fil
   : Type2Text(text_filename), 
     config_(config), data_filename_(data_filename),
     mail_file_(data_filename_, File::modeBinary | File::modeReadWrite, File::shareDenyReadWrite),
-    max_net_num_(max_net_num) {
+    index_(data_filename_), max_net_num_(max_net_num) {
   open_ = mail_file_ && File::Exists(data_filename);
 }
 
@@ -133,22 +133,10 @@ static bool is_mailrec_deleted(const mailrec& h) {
 
 /** Total number of email messages in the system. */
 int WWIVEmail::number_of_messages() {
-  if (const auto num = mail_file_.number_of_records(); num == 0) {
-    return 0;
-  }
-  std::vector<mailrec> headers;
-  mail_file_.Seek(0);
-  if (!mail_file_.ReadVector(headers)) {
-    // WTF
-    return false;
+  if (auto* idx = index()) {
+    return idx->number_of_messages();
   }
-  int count = 0;
-  for (const auto& h : headers) {
-    if (!is_mailrec_deleted(h)) {
-      ++count;
-    }
-  }
-  return count;
+  return 0;
 }
 
 int WWIVEmail::number_of_email_records() const {
@@ -208,19 +196,18 @@ bool WWIVEmail::DeleteMessage(int email_number) {
 
   bool rm = true;
   if (m.status & status_multimail) {
-    bool others_found = false;
-    for (auto i = 0; i < num_records; i++) {
-      if (i != email_number) {
-        mailrec m1{};
-        if (!mail_file_.Read(i, &m1)) { continue; }
-        if ((m.msg.stored_as == m1.msg.stored_as) && (m.msg.storage_type == m1.msg.storage_type) && (m1.daten != 0xffffffff)) {
-          others_found = true;
+    std::vector<mailrec> headers;
+    mail_file_.Seek(0);
+    if (mail_file_.ReadVector(headers)) {
+      for (auto i = 0; i < ssize(headers); i++) {
+        if (const auto& m1 = at(headers, i);
+            i != email_number && m.msg.stored_as == m1.msg.stored_as &&
+            m.msg.storage_type == m1.msg.storage_type && m1.daten != 0xffffffff) {
+          rm = false;
+          break;
         }
       }
     }
-    if (others_found) {
-      rm = false;
-    }
   }
   if (rm) {
     (void) remove_link(m.msg);
@@ -237,7 +224,13 @@ bool WWIVEmail::DeleteMessage(int email_number) {
   m.daten = 0xffffffff;
   m.msg.storage_type = 0;
   m.msg.stored_as = 0xffffffff;
-  return mail_file_.Write(email_number, &m);
+  if (!mail_file_.Write(email_number, &m)) {
+    return false;
+  }
+  if (auto* idx = index()) {
+    idx->Update(email_number, m);
+  }
+  return true;
 }
 
 bool WWIVEmail::DeleteAllMailToOrFrom(int user_number) {
@@ -245,17 +238,12 @@ bool WWIVEmail::DeleteAllMailToOrFrom(int user_number) {
     // You can not take command.
     return false;
   }
-  std::vector<mailrec> headers;
-  mail_file_.Seek(0);
-  if (!mail_file_.ReadVector(headers)) {
-    // WTF
+  auto* idx = index();
+  if (!idx) {
     return false;
   }
-  for (auto i = 0; i < ssize(headers); i++) {
-    if (const auto& m = at(headers, i);
-        (m.tosys == 0 && m.touser == user_number) || (m.fromsys == 0 && m.fromuser == user_number)) {
-      DeleteMessage(i);
-    }
+  for (const auto recno : idx->mail_to_or_from(user_number)) {
+    DeleteMessage(recno);
   }
   return true;
 }
@@ -266,21 +254,26 @@ bool WWIVEmail::add_email(const mailrec& m) {
   if (!open_) {
     return false;
   }
-  auto recno = 0;
-  if (const int max_size = mail_file_.number_of_records(); max_size > 0) {
-    mailrec temprec{};
-    recno = max_size - 1;
-    mail_file_.Read(recno, &temprec);
-    while (recno > 0 && temprec.tosys == 0 && temprec.touser == 0) {
-      --recno;
-      mail_file_.Read(recno, &temprec);
-    }
-    if (temprec.tosys || temprec.touser) {
-      ++recno;
-    }
+  auto* idx = index();
+  if (!idx) {
+    return false;
+  }
+  const auto recno = idx->next_free_record();
+  if (!mail_file_.Write(recno, &m)) {
+    return false;
   }
+  idx->Update(recno, m);
+  return true;
+}
 
-  return mail_file_.Write(recno, &m);
+EmailIndex* WWIVEmail::index() {
+  if (!open_) {
+    return nullptr;
+  }
+  if (!index_loaded_) {
+    index_loaded_ = index_.Load(mail_file_);
+  }
+  return index_loaded_ ? &index_ : nullptr;
 }
 
 } // namespace wwiv
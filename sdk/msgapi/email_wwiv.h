@@ -20,6 +20,7 @@
 
 #include "core/datafile.h"
 #include "sdk/config.h"
+#include "sdk/msgapi/email_index.h"
 #include "sdk/msgapi/message.h"
 #include "sdk/msgapi/type2_text.h"
 #include <cstdint>
@@ -82,10 +83,17 @@ public:
 
 private:
   bool add_email(const mailrec& m);
+  /** Returns the mailbox index, loading it on first use. */
+  EmailIndex* index();
+
   const Config& config_;
   const std::filesystem::path data_filename_;
   core::DataFile<mailrec> mail_file_;
   bool open_{false};
+  // Since mail_file_ is held open (and locked) for as long as we are, once
+  // loaded the index stays current as long as we update it on each write.
+  EmailIndex index_;
+  bool index_loaded_{false};
   const int max_net_num_{-1};
 
   static constexpr uint8_t STORAGE_TYPE = 2;
@@ -18,6 +18,8 @@
 #include "sdk/msgapi/message_api.h"
 
 #include "core/log.h"
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <utility>
 
@@ -35,6 +37,26 @@ int MessageArea::max_messages() const {
   return max_messages_;
 }
 
+std::optional<std::vector<int>> MessageArea::FindMessages(const std::string&) {
+  return std::nullopt;
+}
+
+bool MessageArea::Pack() { return false; }
+
+bool MessageArea::DeleteMessages(std::vector<int> message_numbers) {
+  // Delete the highest first so the others keep their numbers.
+  std::sort(std::rbegin(message_numbers), std::rend(message_numbers));
+  message_numbers.erase(std::unique(std::begin(message_numbers), std::end(message_numbers)),
+                        std::end(message_numbers));
+  auto result = true;
+  for (const auto n : message_numbers) {
+    if (!DeleteMessage(n)) {
+      result = false;
+    }
+  }
+  return result;
+}
+
 MessageApi::MessageApi(const MessageApiOptions& options,
                        const std::filesystem::path& root_directory,
                        const std::filesystem::path& subs_directory,
@@ -24,6 +24,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace wwiv::sdk::msgapi {
 
@@ -91,6 +92,11 @@ public:
   [[nodiscard]] virtual std::optional<MessageText> ReadMessageText(int message_number) = 0;
   [[nodiscard]] virtual bool AddMessage(Message& message, const MessageAreaOptions& options) = 0;
   [[nodiscard]] virtual bool DeleteMessage(int message_number) = 0;
+  /**
+   * Deletes all of message_numbers (numbered as before any of them were
+   * deleted). Returns false if any of them could not be deleted.
+   */
+  [[nodiscard]] virtual bool DeleteMessages(std::vector<int> message_numbers);
   /** Updates message_number to point to the */
   virtual bool ResyncMessage(int& message_number) = 0;
   virtual bool ResyncMessage(int& message_number, Message& message) = 0;
@@ -98,6 +104,19 @@ public:
   /** Creates a new empty message for this area. */
   [[nodiscard]] virtual Message CreateMessage() = 0;
   [[nodiscard]] virtual bool Exists(daten_t d, const std::string& title, uint16_t from_system, uint16_t from_user) = 0;
+  /**
+   * Returns the numbers of the messages that may contain text (ignoring case)
+   * in the title or text, lowest first. Callers still need to check each one.
+   * Returns std::nullopt when the area can not narrow down the search, so
+   * every message needs to be checked.
+   */
+  [[nodiscard]] virtual std::optional<std::vector<int>> FindMessages(const std::string& text);
+  /**
+   * Rewrites the message area to remove the space left behind by deleted
+   * messages. Returns false if the area was not packed, including when the
+   * area does not support packing.
+   */
+  virtual bool Pack();
 
   [[nodiscard]] int max_messages() const;
   void set_max_messages(int m) { max_messages_ = m; }
@@ -32,8 +32,11 @@
 #include "sdk/usermanager.h"
 #include "sdk/vardec.h"
 #include "sdk/msgapi/message_api_wwiv.h"
+#include "sdk/msgapi/sub_qscan_table.h"
 #include "sdk/net/packets.h"
 
+#include <algorithm>
+#include <cctype>
 #include <memory>
 #include <string>
 #include <utility>
@@ -57,23 +60,18 @@ static bool WriteHeader(DataFile<postrec>& file, const WWIVMessageAreaHeader& he
   return file.Write(0, reinterpret_cast<const postrec*>(&p));
 }
 
-static std::unique_ptr<WWIVMessageAreaHeader> ReadHeader(DataFile<postrec>& file) {
-  subfile_header_t raw_header{};
-  if (!file.Read(0, reinterpret_cast<postrec*>(&raw_header))) {
-    // Invalid header.
-    auto header = std::make_unique<WWIVMessageAreaHeader>(0, 0);
-    header->set_initialized(false);
-    return header;
-  }
-  if (raw_header.active_message_count > file.number_of_records()) {
+static std::unique_ptr<WWIVMessageAreaHeader>
+MakeHeader(subfile_header_t raw_header, DataFile<postrec>::size_type num_records,
+           const std::filesystem::path& fn) {
+  if (raw_header.active_message_count > num_records) {
     VLOG(1) << "Header claims too many messages, raw_header.active_message_count("
-            << raw_header.active_message_count << ") > file.number_of_records("
-            << file.number_of_records() << ")";
-    raw_header.active_message_count = static_cast<uint16_t>(file.number_of_records());
+            << raw_header.active_message_count << ") > file.number_of_records(" << num_records
+            << ")";
+    raw_header.active_message_count = static_cast<uint16_t>(num_records);
   }
 
   if (strncmp(raw_header.signature, "WWIV\x1A", 5) != 0) {
-    VLOG(3) << "Missing 5.x header on sub: " << file.file();
+    VLOG(3) << "Missing 5.x header on sub: " << fn;
     const auto saved_count = raw_header.active_message_count;
     memset(&raw_header, 0, sizeof(subfile_header_t));
     // We don't have a modern header. Create one now. Next write
@@ -88,6 +86,29 @@ static std::unique_ptr<WWIVMessageAreaHeader> ReadHeader(DataFile<postrec>& file
   return std::make_unique<WWIVMessageAreaHeader>(raw_header);
 }
 
+static std::unique_ptr<WWIVMessageAreaHeader> ReadHeader(DataFile<postrec>& file) {
+  subfile_header_t raw_header{};
+  if (!file.Read(0, reinterpret_cast<postrec*>(&raw_header))) {
+    // Invalid header.
+    auto header = std::make_unique<WWIVMessageAreaHeader>(0, 0);
+    header->set_initialized(false);
+    return header;
+  }
+  return MakeHeader(raw_header, file.number_of_records(), file.file().path());
+}
+
+static std::unique_ptr<WWIVMessageAreaHeader> ReadHeader(const std::vector<postrec>& posts,
+                                                         const std::filesystem::path& fn) {
+  if (posts.empty()) {
+    // Invalid header.
+    auto header = std::make_unique<WWIVMessageAreaHeader>(0, 0);
+    header->set_initialized(false);
+    return header;
+  }
+  subfile_header_t raw_header{};
+  memcpy(&raw_header, &posts.front(), sizeof(subfile_header_t));
+  return MakeHeader(raw_header, stl::ssize(posts), fn);
+}
 
 WWIVMessageAreaHeader::WWIVMessageAreaHeader(int ver, uint32_t num_messages)
     : header_(subfile_header_t()) {
@@ -105,11 +126,10 @@ WWIVMessageArea::WWIVMessageArea(WWIVMessageApi* api, const subboard_t& sub,
     : MessageArea(api), Type2Text(std::move(text_filename)), wwiv_api_(api), sub_(sub),
       sub_filename_(std::move(sub_filename)), header_{}, net_networks_(std::move(net_networks)),
       last_read_(api, subnum) {
-  DataFile<postrec> subfile(sub_filename_, File::modeBinary | File::modeReadOnly);
-  if (!subfile) {
+  if (!LoadPosts()) {
     // TODO: throw exception
   } else {
-    const auto h = ReadHeader(subfile);
+    const auto h = ReadHeader(posts_, sub_filename_);
     header_ = h->raw_header();
   }
   open_ = true;
@@ -119,6 +139,11 @@ WWIVMessageArea::~WWIVMessageArea() { WWIVMessageArea::Close(); }
 
 bool WWIVMessageArea::Close() {
   open_ = false;
+  if (text_index_) {
+    text_index_->Save();
+    text_index_.reset();
+  }
+  InvalidateCache();
   return true;
 }
 
@@ -127,8 +152,8 @@ bool WWIVMessageArea::Lock() { return false; }
 bool WWIVMessageArea::Unlock() { return false; }
 
 std::unique_ptr<MessageAreaHeader> WWIVMessageArea::ReadMessageAreaHeader() {
-  DataFile<postrec> sub(sub_filename_);
-  auto h = ReadHeader(sub);
+  LoadPosts();
+  auto h = ReadHeader(posts_, sub_filename_);
   header_ = h->raw_header();
   return h;
 }
@@ -143,14 +168,13 @@ int WWIVMessageArea::FindUserMessages(const std::string&) {
 }
 
 int WWIVMessageArea::number_of_messages() {
-  DataFile<postrec> sub(sub_filename_);
-  if (!sub) {
+  if (!LoadPosts()) {
     // TODO: throw exception
     return 0;
   }
 
-  const auto file_num_records = static_cast<int>(sub.number_of_records());
-  const auto wwiv_header = ReadHeader(sub);
+  const auto file_num_records = size_int(posts_);
+  const auto wwiv_header = ReadHeader(posts_, sub_filename_);
   if (!wwiv_header->initialized()) {
     // TODO: throw exception
     // This is an invalid header.
@@ -249,13 +273,11 @@ std::optional<Message> WWIVMessageArea::ReadMessage(int message_number) {
     message_number = num_messages;
   }
 
-  DataFile<postrec> sub(sub_filename_);
-  if (!sub) {
-    // TODO: throw exception
+  const auto o = cached_post(message_number);
+  if (!o) {
     return std::nullopt;
   }
-  postrec header{};
-  sub.Read(message_number, &header);
+  const auto& header = o.value();
   if (header.msg.storage_type != 2) {
     // We only support type-2 on the WWIV API.
     return std::nullopt;
@@ -325,42 +347,40 @@ int WWIVMessageArea::DeleteExcess() {
     return 0;
   }
 
-  int result = 0;
-  auto done = false;
-  while (!done) {
-    if (api_->options().overflow_strategy == OverflowStrategy::delete_one) {
-      LOG(INFO) << "overflow_strategy is delete_one.";
-      done = true;
-    }
-    if (const auto num = number_of_messages(); num <= max_messages_) {
-      VLOG(1) << "No overflow messages. " << num << " <= " << max_messages_;
-      return result;
-    }
-    int i = 1;
-    int dm = 0;
-    while (i <= number_of_messages()) {
-      const auto pp = ReadMessageHeader(i);
-      if (!pp) {
-        break;
-      }
-      if (!pp->locked()) {
-        dm = i;
-        break;
-      }
-      ++i;
-    }
-    if (dm == 0) {
-      LOG(INFO) << "DeleteExcess: No message to delete.";
-      return result;
+  // A maximum of 0 means there is no limit.
+  const auto max = max_messages();
+  const auto num = number_of_messages();
+  if (num <= max) {
+    VLOG(1) << "No overflow messages. " << num << " <= " << max;
+    return 0;
+  }
+  auto num_to_delete = num - max;
+  if (api_->options().overflow_strategy == OverflowStrategy::delete_one) {
+    LOG(INFO) << "overflow_strategy is delete_one.";
+    num_to_delete = 1;
+  }
+  // Delete the oldest messages that may be deleted, all at once.
+  std::vector<int> to_delete;
+  for (auto i = 1; i <= num && ssize(to_delete) < num_to_delete; i++) {
+    // Only the post record is needed here, not the message text.
+    const auto pp = cached_post(i);
+    if (!pp) {
+      break;
     }
-    if (!DeleteMessage(dm)) {
-      LOG(WARNING) << "DeleteExcess: Failed to delete message #" << dm;
-      return result;
+    if (!(pp->status & status_no_delete)) {
+      to_delete.push_back(i);
     }
-    VLOG(1) << "DeleteExcess: Deleted message #" << dm;
-    ++result;
   }
-  return result;
+  if (to_delete.empty()) {
+    LOG(INFO) << "DeleteExcess: No message to delete.";
+    return 0;
+  }
+  if (!DeleteMessages(to_delete)) {
+    LOG(WARNING) << "DeleteExcess: Failed to delete " << to_delete.size() << " messages.";
+    return 0;
+  }
+  VLOG(1) << "DeleteExcess: Deleted " << to_delete.size() << " messages.";
+  return size_int(to_delete);
 }
 
 static bool has_ftn_network(const std::vector<subboard_network_data_t>& sub_nets,
@@ -470,19 +490,30 @@ bool WWIVMessageArea::AddMessage(Message& message, const MessageAreaOptions& opt
     return false;
   }
   p.msg = msg.value();
+  const auto text_index_current = IsTextIndexCurrent();
   auto result = add_post(p);
   if (result) {
+    if (const auto stamp = text_index_stamp(); text_index_current && stamp) {
+      text_index_->Add(p, text);
+      text_index_->set_stamp(stamp.value());
+    }
     DeleteExcess();
   }
   return result;
 }
 
 bool WWIVMessageArea::DeleteMessage(int message_number) {
-  const auto num_messages = number_of_messages();
-  if (message_number < 1) {
-    return false;
+  return DeleteMessages({message_number});
+}
+
+bool WWIVMessageArea::DeleteMessages(std::vector<int> message_numbers) {
+  if (message_numbers.empty()) {
+    return true;
   }
-  if (message_number > num_messages) {
+  std::sort(std::begin(message_numbers), std::end(message_numbers));
+  message_numbers.erase(std::unique(std::begin(message_numbers), std::end(message_numbers)),
+                        std::end(message_numbers));
+  if (message_numbers.front() < 1 || message_numbers.back() > number_of_messages()) {
     return false;
   }
 
@@ -492,33 +523,77 @@ bool WWIVMessageArea::DeleteMessage(int message_number) {
     // TODO: throw exception
     return false;
   }
-  postrec post{};
-  sub.Read(message_number, &post);
-  if (post.msg.storage_type != 2) {
-    // We only support type-2 on the WWIV API.
+  // Now that we hold the lock, make sure nobody changed the file since
+  // number_of_messages loaded it.
+  if (!IsCacheCurrent()) {
+    InvalidateCache();
+    if (!sub.ReadVector(posts_)) {
+      InvalidateCache();
+      return false;
+    }
+    stamp_ = sub_file_stamp();
+  }
+  const auto num_messages = number_of_messages();
+  if (message_numbers.back() > num_messages) {
     return false;
   }
+  std::vector<postrec> deleted;
+  std::vector<messagerec> texts;
+  for (const auto n : message_numbers) {
+    const auto post = cached_post(n);
+    if (!post || post->msg.storage_type != 2) {
+      // We only support type-2 on the WWIV API.
+      return false;
+    }
+    deleted.push_back(post.value());
+    texts.push_back(post->msg);
+  }
 
-  // Remove text.  Ignore the return code, try to remove the header anyway.
-  (void)remove_link(post.msg);
+  const auto text_index_current = IsTextIndexCurrent();
 
-  // Remove post record.
-  for (auto cur = message_number + 1; cur <= num_messages; cur++) {
-    postrec tmp{};
-    sub.Read(cur, &tmp);
-    sub.Write(cur - 1, &tmp);
+  // Remove text.  Ignore the return code, try to remove the headers anyway.
+  (void)remove_links(texts);
+  for (const auto& p : deleted) {
+    RemoveDupe(p);
   }
 
-  // Update header.
-  postrec header{};
-  sub.Read(0, &header);
-  // decrement number of posts.
-  // TODO(rushfan): Should we check these?
-  --header.owneruser;
-  header.owneruser = static_cast<uint16_t>(std::max(0, num_messages - 1));
-  sub.Write(0, &header);
+  // Remove the post records, shifting the remaining ones down in a single write.
+  posts_.resize(num_messages + 1);
+  const auto first = message_numbers.front();
+  auto out = first;
+  for (auto i = first, d = 0; i < size_int(posts_); i++) {
+    if (d < ssize(message_numbers) && message_numbers[d] == i) {
+      ++d;
+      continue;
+    }
+    posts_[out++] = posts_[i];
+  }
+  posts_.resize(out);
+  if (first < size_int(posts_)) {
+    sub.Seek(first);
+    sub.Write(&posts_[first], size_int(posts_) - first);
+  }
 
-  return true;
+  // Update header, decrementing the number of posts.
+  auto wwiv_header = ReadHeader(sub);
+  wwiv_header->set_active_message_count(
+      static_cast<uint16_t>(std::max(0, num_messages - size_int(deleted))));
+  const auto result = WriteHeader(sub, *wwiv_header);
+  // Drop the now unused last records so the file size changes too, other
+  // instances use the size and time of the file to see that it changed.
+  sub.file().set_length(stl::ssize(posts_) * static_cast<File::size_type>(sizeof(postrec)));
+  sub.Read(0, &posts_[0]);
+  stamp_ = sub_file_stamp();
+  if (const auto stamp = text_index_stamp(); text_index_current && stamp) {
+    std::vector<uint32_t> qscans;
+    qscans.reserve(deleted.size());
+    for (const auto& p : deleted) {
+      qscans.push_back(p.qscan);
+    }
+    text_index_->Remove(qscans);
+    text_index_->set_stamp(stamp.value());
+  }
+  return result;
 }
 
 bool WWIVMessageArea::ResyncMessage(int& message_number) {
@@ -540,10 +615,10 @@ bool WWIVMessageArea::ResyncMessage(int& message_number) {
   return ResyncMessageImpl(message_number, m.value());
 }
 
-bool WWIVMessageArea::HasSubChanged() const {
+bool WWIVMessageArea::HasSubChanged() {
   const auto last_read_header = this->header_;
-  DataFile<postrec> sub(sub_filename_, File::modeBinary | File::modeReadOnly);
-  const auto h = ReadHeader(sub);
+  LoadPosts();
+  const auto h = ReadHeader(posts_, sub_filename_);
   const auto current_read_header = h->raw_header();
 
   return current_read_header.mod_count > last_read_header.mod_count;
@@ -621,28 +696,144 @@ Message WWIVMessageArea::CreateMessage() {
 
 bool WWIVMessageArea::Exists(daten_t d, const std::string& title, uint16_t from_system,
                              uint16_t from_user) {
-  DataFile<postrec> sub(sub_filename_);
-  if (!sub) {
+  if (!LoadPosts()) {
     return false;
   }
-  std::vector<postrec> headers;
-  if (!sub.ReadVector(headers)) {
-    return false;
+  if (!dupes_loaded_) {
+    LoadDupes();
   }
+  // Since we don't have a global message id, use the combination of
+  // date + title + from system + from user.
+  return dupes_.find(dupe_key(d, title, from_system, from_user)) != dupes_.end();
+}
 
-  for (const auto& h : headers) {
-    if (h.status & status_delete) {
-      continue;
+std::optional<std::vector<int>> WWIVMessageArea::FindMessages(const std::string& text) {
+  if (!LoadPosts()) {
+    return std::nullopt;
+  }
+  if (!text_index_) {
+    auto fn = sub_filename_;
+    text_index_ = std::make_unique<MessageTextIndex>(fn.replace_extension(".fts"));
+    text_index_->Load();
+  }
+  if (posts_.empty()) {
+    return std::vector<int>{};
+  }
+  const auto num = std::min(number_of_messages(), size_int(posts_) - 1);
+  if (!IsTextIndexCurrent()) {
+    const auto stamp = text_index_stamp();
+    if (!stamp) {
+      return std::nullopt;
     }
-    // Since we don't have a global message id, use the combination of
-    // date + title + from system + from user.
-    if (h.daten == d && iequals(h.title, title) && h.ownersys == from_system &&
-        h.owneruser == from_user) {
-      return true;
+    const std::vector<postrec> posts(posts_.begin() + 1, posts_.begin() + 1 + num);
+    text_index_->Sync(posts, [this](const postrec& p) -> std::optional<std::string> {
+      if (p.msg.storage_type != STORAGE_TYPE) {
+        return std::nullopt;
+      }
+      return readfile(p.msg);
+    });
+    text_index_->set_stamp(stamp.value());
+    text_index_->Save();
+  }
+
+  const auto qscans = text_index_->Candidates(text);
+  if (!qscans) {
+    return std::nullopt;
+  }
+  std::vector<int> result;
+  for (auto i = 1; i <= num; i++) {
+    if (std::binary_search(std::begin(qscans.value()), std::end(qscans.value()), posts_[i].qscan)) {
+      result.push_back(i);
     }
   }
+  return result;
+}
+
+bool WWIVMessageArea::Pack() {
+  // Both files are held open (and so locked) until they are packed, in the
+  // same order DeleteMessages locks them. They are rewritten in place rather
+  // than renamed over, since anyone already waiting for the lock has the
+  // original files open and would write to them after a rename.
+  DataFile<postrec> sub(sub_filename_, File::modeBinary | File::modeReadWrite);
+  if (!sub) {
+    return false;
+  }
+  auto dat = OpenMessageFile();
+  if (!dat) {
+    return false;
+  }
+  std::vector<postrec> posts;
+  if (!sub.ReadVector(posts) || posts.empty()) {
+    return false;
+  }
+  auto wwiv_header = ReadHeader(sub);
+  if (!wwiv_header->initialized()) {
+    return false;
+  }
+  const auto num_messages =
+      std::min<int>(wwiv_header->active_message_count(), size_int(posts) - 1);
+  // Drop any records past the last message.
+  posts.resize(num_messages + 1);
+
+  std::vector<messagerec> msgs;
+  msgs.reserve(num_messages);
+  for (auto i = 1; i <= num_messages; i++) {
+    msgs.push_back(posts[i].msg);
+  }
+  // Write a packed copy of both files first, so a failure before copying
+  // them over the originals leaves the sub alone, and a failure while
+  // copying leaves the packed copies behind to restore from.
+  auto packed_dat = text_path();
+  packed_dat += ".tmp";
+  auto packed_sub = sub_filename_;
+  packed_sub += ".tmp";
+  const auto packed = pack(*dat, msgs, packed_dat);
+  if (!packed) {
+    LOG(ERROR) << "Unable to pack message text for: " << sub_.filename;
+    return false;
+  }
+  for (auto i = 1; i <= num_messages; i++) {
+    posts[i].msg = packed->at(i - 1);
+  }
 
-  return false;
+  // Record 0 is the header.
+  wwiv_header->set_active_message_count(static_cast<uint16_t>(num_messages));
+  const auto raw_header = wwiv_header->raw_header();
+  memcpy(&posts[0], &raw_header, sizeof(subfile_header_t));
+  {
+    DataFile<postrec> new_sub(packed_sub, File::modeBinary | File::modeReadWrite |
+                                              File::modeCreateFile | File::modeTruncate);
+    if (!new_sub || !new_sub.WriteVector(posts)) {
+      LOG(ERROR) << "Unable to write: " << packed_sub;
+      new_sub.Close();
+      File::Remove(packed_dat);
+      File::Remove(packed_sub);
+      return false;
+    }
+  }
+  if (!replace_with_packed(*dat, packed_dat)) {
+    LOG(ERROR) << "Unable to copy " << packed_dat << " over " << text_path()
+               << "; restore it and " << packed_sub << " by hand.";
+    InvalidateCache();
+    return false;
+  }
+  if (!sub.Seek(0) || !sub.WriteVector(posts) ||
+      !sub.file().set_length(ssize(posts) * static_cast<File::size_type>(sizeof(postrec)))) {
+    // The text was already replaced, so the old post records no longer
+    // point at it. Leave the packed *.sub file behind so it can be restored.
+    LOG(ERROR) << "Unable to copy " << packed_sub << " over " << sub_filename_;
+    InvalidateCache();
+    return false;
+  }
+  sub.Close();
+  dat->Close();
+  File::Remove(packed_sub);
+
+  // Every stored_as changed, so the full text index needs to be rebuilt.
+  text_index_.reset();
+  InvalidateCache();
+  LoadPosts();
+  return true;
 }
 
 const MessageAreaLastRead& WWIVMessageArea::last_read() const noexcept { return last_read_; }
@@ -675,6 +866,8 @@ bool WWIVMessageArea::add_post(const postrec& post) {
   if (sub.number_of_records() == 0) {
     return false;
   }
+  // Only patch the cache if nobody else changed the file since we read it.
+  const auto cache_current = IsCacheCurrent();
   auto wwiv_header = ReadHeader(sub);
   if (!wwiv_header->initialized()) {
     // This is an invalid header.
@@ -684,12 +877,152 @@ bool WWIVMessageArea::add_post(const postrec& post) {
 
   // add the new post
   if (!sub.Write(msgnum, &post)) {
+    InvalidateCache();
     return false;
   }
   // No reason other than make sure we're not const.
   ++nonce_;
   // Write the header now.
-  return WriteHeader(sub, *wwiv_header);
+  if (!WriteHeader(sub, *wwiv_header)) {
+    InvalidateCache();
+    return false;
+  }
+  // Let new message scans know there is something new here.
+  SubQScanTable(sub_filename_.parent_path()).Update(sub_.filename, post.qscan);
+  if (!cache_current) {
+    InvalidateCache();
+    return true;
+  }
+  if (size_int(posts_) <= static_cast<int>(msgnum)) {
+    posts_.resize(msgnum + 1);
+  }
+  posts_[msgnum] = post;
+  AddDupe(post);
+  sub.Read(0, &posts_[0]);
+  stamp_ = sub_file_stamp();
+  return true;
+}
+
+std::optional<WWIVMessageArea::sub_file_stamp_t> WWIVMessageArea::sub_file_stamp() const {
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(sub_filename_, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  const auto last_write_time = std::filesystem::last_write_time(sub_filename_, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return sub_file_stamp_t{size, last_write_time};
+}
+
+bool WWIVMessageArea::IsCacheCurrent() const {
+  return stamp_.has_value() && sub_file_stamp() == stamp_;
+}
+
+bool WWIVMessageArea::LoadPosts() {
+  // Take the stamp before reading so that a write racing with us makes
+  // the next call reload the file again.
+  const auto stamp = sub_file_stamp();
+  if (!stamp) {
+    InvalidateCache();
+    return false;
+  }
+  if (stamp_ == stamp) {
+    return true;
+  }
+  DataFile<postrec> sub(sub_filename_, File::modeBinary | File::modeReadOnly);
+  if (!sub) {
+    InvalidateCache();
+    return false;
+  }
+  std::vector<postrec> posts;
+  if (!sub.ReadVector(posts)) {
+    InvalidateCache();
+    return false;
+  }
+  InvalidateCache();
+  posts_ = std::move(posts);
+  stamp_ = stamp;
+  return true;
+}
+
+void WWIVMessageArea::InvalidateCache() {
+  posts_.clear();
+  stamp_.reset();
+  dupes_.clear();
+  dupes_loaded_ = false;
+}
+
+std::optional<MessageTextIndex::stamp_t> WWIVMessageArea::text_index_stamp() const {
+  if (!stamp_) {
+    return std::nullopt;
+  }
+  return MessageTextIndex::stamp_t{
+      static_cast<int64_t>(stamp_->size),
+      static_cast<int64_t>(stamp_->last_write_time.time_since_epoch().count())};
+}
+
+bool WWIVMessageArea::IsTextIndexCurrent() const {
+  return text_index_ && text_index_->stamp() && IsCacheCurrent() &&
+         text_index_->stamp() == text_index_stamp();
+}
+
+std::optional<postrec> WWIVMessageArea::cached_post(int message_number) const {
+  if (message_number < 1 || message_number >= size_int(posts_)) {
+    return std::nullopt;
+  }
+  return posts_[message_number];
+}
+
+std::size_t WWIVMessageArea::dupe_key_hash_t::operator()(const dupe_key_t& k) const noexcept {
+  auto h = static_cast<std::size_t>(k.title_hash);
+  h ^= std::hash<daten_t>{}(k.daten) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  h ^= std::hash<uint32_t>{}(static_cast<uint32_t>(k.ownersys) << 16 | k.owneruser) +
+       0x9e3779b9 + (h << 6) + (h >> 2);
+  return h;
+}
+
+WWIVMessageArea::dupe_key_t WWIVMessageArea::dupe_key(daten_t d, std::string_view title,
+                                                      uint16_t from_system, uint16_t from_user) {
+  // 64-bit FNV-1a over the lower cased title, to match how iequals folds case.
+  uint64_t title_hash = 14695981039346656037ULL;
+  for (const auto ch : title) {
+    title_hash ^= static_cast<uint8_t>(std::tolower(static_cast<unsigned char>(ch)));
+    title_hash *= 1099511628211ULL;
+  }
+  return dupe_key_t{d, title_hash, from_system, from_user};
+}
+
+WWIVMessageArea::dupe_key_t WWIVMessageArea::dupe_key(const postrec& p) {
+  const std::string_view title(p.title, strnlen(p.title, sizeof(p.title)));
+  return dupe_key(p.daten, title, p.ownersys, p.owneruser);
+}
+
+void WWIVMessageArea::LoadDupes() {
+  dupes_.clear();
+  const auto num = number_of_messages();
+  dupes_.reserve(num);
+  dupes_loaded_ = true;
+  for (auto i = 1; i <= num && i < size_int(posts_); i++) {
+    AddDupe(posts_[i]);
+  }
+}
+
+void WWIVMessageArea::AddDupe(const postrec& p) {
+  if (!dupes_loaded_ || (p.status & status_delete)) {
+    return;
+  }
+  ++dupes_[dupe_key(p)];
+}
+
+void WWIVMessageArea::RemoveDupe(const postrec& p) {
+  if (!dupes_loaded_ || (p.status & status_delete)) {
+    return;
+  }
+  if (const auto it = dupes_.find(dupe_key(p)); it != dupes_.end() && --it->second <= 0) {
+    dupes_.erase(it);
+  }
 }
 
 } // namespace wwiv::sdk::msgapi
@@ -20,11 +20,16 @@
 
 #include "sdk/msgapi/message.h"
 #include "sdk/msgapi/message_api.h"
+#include "sdk/msgapi/message_text_index.h"
 #include "sdk/msgapi/type2_text.h"
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace wwiv::sdk::msgapi {
 
@@ -83,12 +88,27 @@ public:
   std::optional<MessageText> ReadMessageText(int message_number) override;
   bool AddMessage(Message& message, const MessageAreaOptions& options) override;
   bool DeleteMessage(int message_number) override;
+  /**
+   * Deletes all of message_numbers, removing their post records from the
+   * *.sub file with a single write.
+   */
+  bool DeleteMessages(std::vector<int> message_numbers) override;
   bool ResyncMessage(int& message_number) override;
   bool ResyncMessage(int& message_number, Message& message) override;
 
   [[nodiscard]] Message CreateMessage() override;
   [[nodiscard]] bool Exists(daten_t d, const std::string& title, uint16_t from_system,
                             uint16_t from_user) override;
+  [[nodiscard]] std::optional<std::vector<int>> FindMessages(const std::string& text) override;
+  /**
+   * Rewrites the *.dat file so the text of every post is contiguous and in
+   * post order. Both files stay locked the whole time, so it is safe while
+   * other instances use the sub. The packed *.dat and *.sub files are
+   * written to temporary files and copied over the originals only once both
+   * are written, so nothing is changed if the text of any post can not be
+   * read.
+   */
+  bool Pack() override;
   [[nodiscard]] const MessageAreaLastRead& last_read() const noexcept override;
   [[nodiscard]] message_anonymous_t anonymous_type() const noexcept override;
 
@@ -96,9 +116,55 @@ private:
   int DeleteExcess();
   [[nodiscard]] bool add_post(const postrec& post);
   [[nodiscard]] std::optional<wwiv_parsed_text_fieds> ParseMessageText(const postrec& header, int message_number);
-  [[nodiscard]] [[nodiscard]] bool HasSubChanged() const;
+  [[nodiscard]] bool HasSubChanged();
   [[nodiscard]] bool ResyncMessageImpl(int& message_number, const Message& message);
 
+  // Size and last write time of the *.sub file, used to tell if
+  // the cached post records are still current. The posts counter in
+  // STATUS.DAT is not used: it is shared by every sub, wraps at 256, is
+  // bumped when message text is written rather than the *.sub file, and
+  // network2 only bumps it once when it exits.
+  struct sub_file_stamp_t {
+    std::uintmax_t size{0};
+    std::filesystem::file_time_type last_write_time{};
+    bool operator==(const sub_file_stamp_t& o) const {
+      return size == o.size && last_write_time == o.last_write_time;
+    }
+  };
+  [[nodiscard]] std::optional<sub_file_stamp_t> sub_file_stamp() const;
+  // Returns true if posts_ matches what is on disk right now.
+  [[nodiscard]] bool IsCacheCurrent() const;
+  // Reloads posts_ from disk if the *.sub file has changed since
+  // it was last loaded. Returns false if the file can not be read.
+  bool LoadPosts();
+  void InvalidateCache();
+  [[nodiscard]] std::optional<postrec> cached_post(int message_number) const;
+
+  // Key used by Exists to find duplicate posts without scanning every post.
+  struct dupe_key_t {
+    daten_t daten{0};
+    uint64_t title_hash{0};
+    uint16_t ownersys{0};
+    uint16_t owneruser{0};
+    bool operator==(const dupe_key_t& o) const {
+      return daten == o.daten && title_hash == o.title_hash && ownersys == o.ownersys &&
+             owneruser == o.owneruser;
+    }
+  };
+  struct dupe_key_hash_t {
+    std::size_t operator()(const dupe_key_t& k) const noexcept;
+  };
+  [[nodiscard]] static dupe_key_t dupe_key(daten_t d, std::string_view title, uint16_t from_system,
+                                           uint16_t from_user);
+  [[nodiscard]] static dupe_key_t dupe_key(const postrec& p);
+  void LoadDupes();
+  void AddDupe(const postrec& p);
+  void RemoveDupe(const postrec& p);
+  // Returns stamp_ in the form stored in the full text index.
+  [[nodiscard]] std::optional<MessageTextIndex::stamp_t> text_index_stamp() const;
+  // Returns true if text_index_ is loaded and matches the *.sub file right now.
+  [[nodiscard]] bool IsTextIndexCurrent() const;
+
   static constexpr uint8_t STORAGE_TYPE = 2;
 
   // not owned.  Extra copy of the message API but the
@@ -113,6 +179,17 @@ private:
   const std::vector<net::Network> net_networks_;
   MessageAreaLastRead last_read_;
   int nonce_{0};
+  // Cached copy of every record in the *.sub file, record 0 is the header.
+  std::vector<postrec> posts_;
+  // Stamp of the *.sub file when posts_ was loaded.
+  std::optional<sub_file_stamp_t> stamp_;
+  // Number of posts in posts_ for each dupe key. Built lazily by Exists
+  // and dropped whenever posts_ is reloaded.
+  std::unordered_map<dupe_key_t, int, dupe_key_hash_t> dupes_;
+  bool dupes_loaded_{false};
+  // Full text index, loaded by FindMessages. Once loaded it is kept up to
+  // date by AddMessage and DeleteMessage and written back by Close.
+  std::unique_ptr<MessageTextIndex> text_index_;
 };
 
 } // namespace
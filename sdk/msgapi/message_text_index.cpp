@@ -0,0 +1,378 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "sdk/msgapi/message_text_index.h"
+
+#include "core/file.h"
+#include "core/log.h"
+#include "core/stl.h"
+#include "core/strings.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace wwiv::sdk::msgapi {
+
+using namespace wwiv::core;
+using namespace wwiv::strings;
+
+static constexpr char TEXT_INDEX_SIGNATURE[] = "WWIVTIDX";
+static constexpr uint32_t TEXT_INDEX_REVISION = 1;
+// Letters and digits, so 36 * 36 * 36 trigrams which all fit in a uint16_t.
+static constexpr int TRIGRAM_ALPHABET_SIZE = 36;
+static constexpr int NUM_TRIGRAMS =
+    TRIGRAM_ALPHABET_SIZE * TRIGRAM_ALPHABET_SIZE * TRIGRAM_ALPHABET_SIZE;
+
+static int trigram_value(char ch) {
+  if (ch >= 'A' && ch <= 'Z') {
+    return ch - 'A' + 10;
+  }
+  if (ch >= 'a' && ch <= 'z') {
+    return ch - 'a' + 10;
+  }
+  if (ch >= '0' && ch <= '9') {
+    return ch - '0';
+  }
+  return -1;
+}
+
+static void add_trigrams(std::string_view text, std::vector<uint16_t>& out) {
+  auto key = 0;
+  auto run = 0;
+  for (const auto ch : text) {
+    const auto v = trigram_value(ch);
+    if (v < 0) {
+      run = 0;
+      continue;
+    }
+    key = (key * TRIGRAM_ALPHABET_SIZE + v) % NUM_TRIGRAMS;
+    if (++run >= 3) {
+      out.push_back(static_cast<uint16_t>(key));
+    }
+  }
+}
+
+static void sort_unique(std::vector<uint16_t>& v) {
+  std::sort(std::begin(v), std::end(v));
+  v.erase(std::unique(std::begin(v), std::end(v)), std::end(v));
+}
+
+static void put_varint(uint32_t n, std::string& out) {
+  while (n >= 0x80) {
+    out.push_back(static_cast<char>((n & 0x7f) | 0x80));
+    n >>= 7;
+  }
+  out.push_back(static_cast<char>(n));
+}
+
+static std::optional<uint32_t> get_varint(const char*& p, const char* end) {
+  uint32_t n = 0;
+  for (auto shift = 0; p < end && shift < 35; shift += 7) {
+    const auto b = static_cast<uint8_t>(*p++);
+    n |= static_cast<uint32_t>(b & 0x7f) << shift;
+    if (!(b & 0x80)) {
+      return n;
+    }
+  }
+  return std::nullopt;
+}
+
+MessageTextIndex::MessageTextIndex(std::filesystem::path path) : path_(std::move(path)) {}
+
+std::vector<uint16_t> MessageTextIndex::trigrams(std::string_view text) {
+  std::vector<uint16_t> result;
+  add_trigrams(text, result);
+  sort_unique(result);
+  return result;
+}
+
+bool MessageTextIndex::Load() {
+  Clear();
+  if (!File::Exists(path_)) {
+    return false;
+  }
+  File file(path_);
+  if (!file.Open(File::modeBinary | File::modeReadOnly)) {
+    return false;
+  }
+  const auto len = file.length();
+  if (len < static_cast<File::size_type>(sizeof(message_text_index_header_t))) {
+    return false;
+  }
+  std::string data(static_cast<size_t>(len), '\0');
+  if (file.Read(&data[0], len) != len) {
+    return false;
+  }
+  file.Close();
+
+  message_text_index_header_t h{};
+  memcpy(&h, data.data(), sizeof(message_text_index_header_t));
+  if (memcmp(h.signature, TEXT_INDEX_SIGNATURE, sizeof(h.signature)) != 0 ||
+      h.revision != TEXT_INDEX_REVISION) {
+    VLOG(1) << path_ << " is not a valid text index.";
+    return false;
+  }
+  const auto* p = data.data() + sizeof(message_text_index_header_t);
+  const auto* end = data.data() + data.size();
+  if (static_cast<size_t>(end - p) < h.num_docs * sizeof(message_text_index_doc_t)) {
+    return false;
+  }
+  docs_.reserve(h.num_docs);
+  for (auto i = 0u; i < h.num_docs; i++) {
+    message_text_index_doc_t d{};
+    memcpy(&d, p, sizeof(message_text_index_doc_t));
+    p += sizeof(message_text_index_doc_t);
+    docs_.emplace(d.qscan, d.stored_as);
+  }
+  for (auto i = 0u; i < h.num_trigrams; i++) {
+    message_text_index_trigram_t t{};
+    if (static_cast<size_t>(end - p) < sizeof(message_text_index_trigram_t)) {
+      Clear();
+      return false;
+    }
+    memcpy(&t, p, sizeof(message_text_index_trigram_t));
+    p += sizeof(message_text_index_trigram_t);
+    if (static_cast<size_t>(end - p) < t.size) {
+      Clear();
+      return false;
+    }
+    const auto* list_end = p + t.size;
+    auto& v = postings_[t.trigram];
+    v.reserve(t.count);
+    uint32_t qscan = 0;
+    for (auto j = 0u; j < t.count; j++) {
+      const auto delta = get_varint(p, list_end);
+      if (!delta) {
+        Clear();
+        return false;
+      }
+      qscan += delta.value();
+      v.push_back(qscan);
+    }
+    p = list_end;
+  }
+  stamp_ = stamp_t{h.sub_size, h.sub_last_write_time};
+  return true;
+}
+
+bool MessageTextIndex::Save() {
+  if (!dirty_) {
+    return true;
+  }
+  message_text_index_header_t h{};
+  memcpy(h.signature, TEXT_INDEX_SIGNATURE, sizeof(h.signature));
+  h.revision = TEXT_INDEX_REVISION;
+  h.num_docs = static_cast<uint32_t>(docs_.size());
+  h.num_trigrams = static_cast<uint32_t>(postings_.size());
+  if (stamp_) {
+    h.sub_size = stamp_->size;
+    h.sub_last_write_time = stamp_->last_write_time;
+  }
+
+  std::vector<message_text_index_doc_t> docs;
+  docs.reserve(docs_.size());
+  for (const auto& [qscan, stored_as] : docs_) {
+    docs.push_back({qscan, stored_as});
+  }
+  std::sort(std::begin(docs), std::end(docs),
+            [](const auto& l, const auto& r) { return l.qscan < r.qscan; });
+  std::vector<uint16_t> keys;
+  keys.reserve(postings_.size());
+  for (const auto& [key, _] : postings_) {
+    keys.push_back(key);
+  }
+  std::sort(std::begin(keys), std::end(keys));
+
+  std::string data;
+  data.append(reinterpret_cast<const char*>(&h), sizeof(message_text_index_header_t));
+  if (!docs.empty()) {
+    data.append(reinterpret_cast<const char*>(&docs[0]),
+                docs.size() * sizeof(message_text_index_doc_t));
+  }
+  std::string list;
+  for (const auto key : keys) {
+    const auto& v = postings_.at(key);
+    list.clear();
+    uint32_t last = 0;
+    for (const auto qscan : v) {
+      put_varint(qscan - last, list);
+      last = qscan;
+    }
+    const message_text_index_trigram_t t{key, static_cast<uint32_t>(v.size()),
+                                         static_cast<uint32_t>(list.size())};
+    data.append(reinterpret_cast<const char*>(&t), sizeof(message_text_index_trigram_t));
+    data.append(list);
+  }
+
+  File file(path_);
+  if (!file.Open(File::modeBinary | File::modeReadWrite | File::modeCreateFile)) {
+    LOG(WARNING) << "Unable to write: " << path_;
+    return false;
+  }
+  const auto size = static_cast<File::size_type>(data.size());
+  if (file.Write(data.data(), size) != size || !file.set_length(size)) {
+    LOG(WARNING) << "Unable to write: " << path_;
+    return false;
+  }
+  dirty_ = false;
+  return true;
+}
+
+void MessageTextIndex::set_stamp(const stamp_t& stamp) {
+  if (stamp_ != stamp) {
+    stamp_ = stamp;
+    dirty_ = true;
+  }
+}
+
+void MessageTextIndex::Add(const postrec& p, std::string_view text) {
+  Remove(p.qscan);
+  const std::string title(p.title, strnlen(p.title, sizeof(p.title)));
+  std::vector<uint16_t> keys;
+  add_trigrams(title, keys);
+  add_trigrams(stripcolors(title), keys);
+  add_trigrams(text, keys);
+  sort_unique(keys);
+  AddPostings(p.qscan, keys);
+  docs_[p.qscan] = p.msg.stored_as;
+  dirty_ = true;
+}
+
+void MessageTextIndex::Remove(uint32_t qscan) {
+  Remove(std::vector<uint32_t>{qscan});
+}
+
+void MessageTextIndex::Remove(std::vector<uint32_t> qscans) {
+  qscans.erase(std::remove_if(std::begin(qscans), std::end(qscans),
+                              [&](uint32_t q) { return docs_.find(q) == std::end(docs_); }),
+               std::end(qscans));
+  if (qscans.empty()) {
+    return;
+  }
+  std::sort(std::begin(qscans), std::end(qscans));
+  RemovePostings(qscans);
+  for (const auto qscan : qscans) {
+    docs_.erase(qscan);
+  }
+  dirty_ = true;
+}
+
+int MessageTextIndex::Sync(const std::vector<postrec>& posts, const read_text_fn& read_text) {
+  std::unordered_map<uint32_t, uint32_t> wanted;
+  wanted.reserve(posts.size());
+  for (const auto& p : posts) {
+    wanted.emplace(p.qscan, p.msg.stored_as);
+  }
+
+  std::vector<uint32_t> removed;
+  for (const auto& [qscan, stored_as] : docs_) {
+    if (const auto it = wanted.find(qscan); it == std::end(wanted) || it->second != stored_as) {
+      removed.push_back(qscan);
+    }
+  }
+  if (!removed.empty()) {
+    std::sort(std::begin(removed), std::end(removed));
+    RemovePostings(removed);
+    for (const auto qscan : removed) {
+      docs_.erase(qscan);
+    }
+    dirty_ = true;
+  }
+
+  auto added = 0;
+  for (const auto& p : posts) {
+    if (docs_.find(p.qscan) != std::end(docs_)) {
+      continue;
+    }
+    const auto text = read_text(p);
+    Add(p, text.value_or(""));
+    ++added;
+  }
+  VLOG(1) << "Synced " << path_ << ": removed " << removed.size() << "; added " << added;
+  return stl::size_int(removed) + added;
+}
+
+std::optional<std::vector<uint32_t>> MessageTextIndex::Candidates(std::string_view text) const {
+  const auto keys = trigrams(text);
+  if (keys.empty()) {
+    return std::nullopt;
+  }
+  std::vector<const std::vector<uint32_t>*> lists;
+  lists.reserve(keys.size());
+  for (const auto key : keys) {
+    const auto it = postings_.find(key);
+    if (it == std::end(postings_)) {
+      return std::vector<uint32_t>{};
+    }
+    lists.push_back(&it->second);
+  }
+  // Start with the shortest list so each intersection is as cheap as possible.
+  std::sort(std::begin(lists), std::end(lists),
+            [](const auto* l, const auto* r) { return l->size() < r->size(); });
+  auto result = *lists.front();
+  std::vector<uint32_t> next;
+  for (auto i = 1; i < stl::size_int(lists) && !result.empty(); i++) {
+    next.clear();
+    std::set_intersection(std::begin(result), std::end(result), std::begin(*lists[i]),
+                          std::end(*lists[i]), std::back_inserter(next));
+    result.swap(next);
+  }
+  return result;
+}
+
+// Implementation Details
+
+void MessageTextIndex::Clear() {
+  docs_.clear();
+  postings_.clear();
+  stamp_.reset();
+  dirty_ = false;
+}
+
+void MessageTextIndex::AddPostings(uint32_t qscan, const std::vector<uint16_t>& keys) {
+  for (const auto key : keys) {
+    auto& v = postings_[key];
+    // Posts are almost always added in qscan order.
+    if (v.empty() || v.back() < qscan) {
+      v.push_back(qscan);
+    } else if (const auto it = std::lower_bound(std::begin(v), std::end(v), qscan);
+               it == std::end(v) || *it != qscan) {
+      v.insert(it, qscan);
+    }
+  }
+}
+
+void MessageTextIndex::RemovePostings(const std::vector<uint32_t>& qscans) {
+  for (auto it = std::begin(postings_); it != std::end(postings_);) {
+    auto& v = it->second;
+    v.erase(std::remove_if(std::begin(v), std::end(v),
+                           [&](uint32_t q) {
+                             return std::binary_search(std::begin(qscans), std::end(qscans), q);
+                           }),
+            std::end(v));
+    if (v.empty()) {
+      it = postings_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace
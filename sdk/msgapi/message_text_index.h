@@ -0,0 +1,159 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#ifndef INCLUDED_SDK_MSGAPI_MESSAGE_TEXT_INDEX_H
+#define INCLUDED_SDK_MSGAPI_MESSAGE_TEXT_INDEX_H
+
+#include "sdk/vardec.h"
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace wwiv::sdk::msgapi {
+
+#pragma pack(push, 1)
+struct message_text_index_header_t {
+  // "WWIVTIDX"
+  char signature[8];
+  uint32_t revision;
+  // Number of message_text_index_doc_t records following the header.
+  uint32_t num_docs;
+  // Number of trigrams, each is a message_text_index_trigram_t followed by
+  // its posting list.
+  uint32_t num_trigrams;
+  uint32_t reserved;
+  // Size of the *.sub file when this index was written.
+  int64_t sub_size;
+  // Last write time of the *.sub file (in file clock ticks) when this index was written.
+  int64_t sub_last_write_time;
+};
+
+struct message_text_index_doc_t {
+  uint32_t qscan;
+  // messagerec.stored_as of the post, changes when the text is edited.
+  uint32_t stored_as;
+};
+
+struct message_text_index_trigram_t {
+  uint16_t trigram;
+  // Number of qscan values in the posting list.
+  uint32_t count;
+  // Size in bytes of the posting list, stored as varint encoded deltas.
+  uint32_t size;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(message_text_index_header_t) == 40);
+static_assert(sizeof(message_text_index_doc_t) == 8);
+static_assert(sizeof(message_text_index_trigram_t) == 10);
+
+/**
+ * Full text index for a message sub, stored next to the *.sub file.
+ *
+ * Maps every trigram (3 letters or digits in a row, ignoring case) found in
+ * the title or text of a post to the sorted list of qscan values of the posts
+ * containing it. Posts are keyed by qscan since that does not change when
+ * posts before it are deleted.
+ *
+ * Since search strings match anywhere in a post, the index only narrows the
+ * search down to the posts that may contain the search string, callers still
+ * need to check each candidate.
+ *
+ * Like EmailIndex, the index remembers the size and last write time of the
+ * *.sub file it matches, since the BBS writes to the *.sub file directly.
+ * When those no longer match, Sync brings it up to date by only indexing
+ * the posts that were added or edited, and dropping the ones removed.
+ */
+class MessageTextIndex final {
+public:
+  struct stamp_t {
+    int64_t size;
+    int64_t last_write_time;
+    bool operator==(const stamp_t& o) const {
+      return size == o.size && last_write_time == o.last_write_time;
+    }
+    bool operator!=(const stamp_t& o) const { return !(*this == o); }
+  };
+  /** Returns the text of a post, or std::nullopt if it can not be read */
+  typedef std::function<std::optional<std::string>(const postrec&)> read_text_fn;
+
+  /** path is the full path to the index file */
+  explicit MessageTextIndex(std::filesystem::path path);
+
+  /**
+   * Loads the index from disk. Returns false and leaves the index empty if it
+   * is missing or damaged, in which case Sync will rebuild it.
+   */
+  bool Load();
+  /** Writes the index to disk, if it has changed. */
+  bool Save();
+
+  /** Stamp of the *.sub file the index matches, if any */
+  [[nodiscard]] const std::optional<stamp_t>& stamp() const noexcept { return stamp_; }
+  void set_stamp(const stamp_t& stamp);
+
+  /** Indexes the title of post p along with text, replacing any older copy of it. */
+  void Add(const postrec& p, std::string_view text);
+  /** Removes the post with qscan value qscan from the index. */
+  void Remove(uint32_t qscan);
+  /** Removes all of the posts in qscans from the index in a single pass. */
+  void Remove(std::vector<uint32_t> qscans);
+  /**
+   * Makes the index match posts: removes posts no longer there, and indexes
+   * the new or edited ones using read_text. Returns the number of posts
+   * added or removed.
+   */
+  int Sync(const std::vector<postrec>& posts, const read_text_fn& read_text);
+
+  /**
+   * Returns the sorted qscan values of all posts that may contain text, or
+   * std::nullopt if text is too short to use the index (it needs at least 3
+   * letters or digits in a row) and every post needs to be checked.
+   */
+  [[nodiscard]] std::optional<std::vector<uint32_t>> Candidates(std::string_view text) const;
+
+  /** Number of posts in the index */
+  [[nodiscard]] int size() const noexcept { return static_cast<int>(docs_.size()); }
+  [[nodiscard]] bool dirty() const noexcept { return dirty_; }
+
+  /** Returns the sorted unique trigrams in text */
+  [[nodiscard]] static std::vector<uint16_t> trigrams(std::string_view text);
+
+private:
+  void Clear();
+  void AddPostings(uint32_t qscan, const std::vector<uint16_t>& keys);
+  /** Removes all of the posts with a qscan in the sorted list qscans */
+  void RemovePostings(const std::vector<uint32_t>& qscans);
+
+  const std::filesystem::path path_;
+  // stored_as for each qscan in the index.
+  std::unordered_map<uint32_t, uint32_t> docs_;
+  // Sorted qscan values of the posts containing each trigram.
+  std::unordered_map<uint16_t, std::vector<uint32_t>> postings_;
+  std::optional<stamp_t> stamp_;
+  bool dirty_{false};
+};
+
+}  // namespace
+
+#endif
@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "gtest/gtest.h"
+
+#include "core/strings.h"
+#include "core/test/file_helper.h"
+#include "sdk/msgapi/message_text_index.h"
+#include "sdk/vardec.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace wwiv::core;
+using namespace wwiv::sdk;
+using namespace wwiv::sdk::msgapi;
+using namespace wwiv::strings;
+
+class MessageTextIndexTest : public testing::Test {
+public:
+  static postrec CreatePost(uint32_t qscan, const std::string& title) {
+    postrec p{};
+    to_char_array(p.title, title);
+    p.qscan = qscan;
+    p.msg.storage_type = 2;
+    p.msg.stored_as = qscan * 10;
+    return p;
+  }
+
+  wwiv::core::test::FileHelper helper_;
+};
+
+TEST_F(MessageTextIndexTest, Trigrams) {
+  EXPECT_EQ(MessageTextIndex::trigrams("abcd"), MessageTextIndex::trigrams("ABCD"));
+  EXPECT_EQ(2u, MessageTextIndex::trigrams("abcd").size());
+  EXPECT_EQ(1u, MessageTextIndex::trigrams("abc abc").size());
+  EXPECT_TRUE(MessageTextIndex::trigrams("ab cd").empty());
+}
+
+TEST_F(MessageTextIndexTest, Candidates) {
+  MessageTextIndex index(helper_.CreateTempFilePath("a1.fts"));
+  index.Add(CreatePost(1, "First"), "The quick brown fox");
+  index.Add(CreatePost(2, "Second"), "jumps over the lazy dog");
+  index.Add(CreatePost(3, "|#1Third"), "");
+
+  EXPECT_EQ(index.Candidates("QUICK"), std::vector<uint32_t>({1}));
+  EXPECT_EQ(index.Candidates("the"), std::vector<uint32_t>({1, 2}));
+  EXPECT_EQ(index.Candidates("SECOND"), std::vector<uint32_t>({2}));
+  EXPECT_EQ(index.Candidates("THIRD"), std::vector<uint32_t>({3}));
+  EXPECT_EQ(index.Candidates("LAZY FOX"), std::vector<uint32_t>());
+  EXPECT_EQ(index.Candidates("CAT"), std::vector<uint32_t>());
+  EXPECT_FALSE(index.Candidates("OX").has_value());
+
+  index.Remove(1);
+  EXPECT_EQ(index.Candidates("THE"), std::vector<uint32_t>({2}));
+  EXPECT_EQ(2, index.size());
+}
+
+TEST_F(MessageTextIndexTest, Remove_Many) {
+  MessageTextIndex index(helper_.CreateTempFilePath("a1.fts"));
+  index.Add(CreatePost(1, "First"), "The quick brown fox");
+  index.Add(CreatePost(2, "Second"), "jumps over the lazy dog");
+  index.Add(CreatePost(3, "Third"), "the end");
+
+  index.Remove(std::vector<uint32_t>{3, 1, 4});
+  EXPECT_EQ(index.Candidates("THE"), std::vector<uint32_t>({2}));
+  EXPECT_EQ(index.Candidates("QUICK"), std::vector<uint32_t>());
+  EXPECT_EQ(1, index.size());
+}
+
+TEST_F(MessageTextIndexTest, SaveAndLoad) {
+  const auto path = helper_.CreateTempFilePath("a1.fts");
+  {
+    MessageTextIndex index(path);
+    EXPECT_FALSE(index.Load());
+    for (uint32_t i = 1; i <= 300; i++) {
+      index.Add(CreatePost(i * 1000, StrCat("Title", i)), i % 2 ? "odd" : "even");
+    }
+    index.set_stamp({1234, 5678});
+    EXPECT_TRUE(index.dirty());
+    EXPECT_TRUE(index.Save());
+    EXPECT_FALSE(index.dirty());
+  }
+
+  MessageTextIndex index(path);
+  ASSERT_TRUE(index.Load());
+  EXPECT_EQ(300, index.size());
+  EXPECT_EQ(index.stamp(), MessageTextIndex::stamp_t({1234, 5678}));
+  EXPECT_EQ(150u, index.Candidates("ODD")->size());
+  EXPECT_EQ(index.Candidates("TITLE299"), std::vector<uint32_t>({299000}));
+}
+
+TEST_F(MessageTextIndexTest, Sync) {
+  MessageTextIndex index(helper_.CreateTempFilePath("a1.fts"));
+  std::vector<postrec> posts{CreatePost(1, "One"), CreatePost(2, "Two"), CreatePost(3, "Three")};
+  auto reads = 0;
+  const auto read_text = [&reads](const postrec& p) -> std::optional<std::string> {
+    ++reads;
+    return StrCat("Text", p.qscan);
+  };
+  EXPECT_EQ(3, index.Sync(posts, read_text));
+  EXPECT_EQ(3, reads);
+  EXPECT_EQ(0, index.Sync(posts, read_text));
+  EXPECT_EQ(3, reads);
+
+  // Delete the first post and edit the last one.
+  posts.erase(posts.begin());
+  posts.back().msg.stored_as++;
+  EXPECT_EQ(3, index.Sync(posts, read_text));
+  EXPECT_EQ(4, reads);
+  EXPECT_EQ(index.Candidates("ONE"), std::vector<uint32_t>());
+  EXPECT_EQ(index.Candidates("THREE"), std::vector<uint32_t>({3}));
+  EXPECT_EQ(index.Candidates("TEXT"), std::vector<uint32_t>({2, 3}));
+}
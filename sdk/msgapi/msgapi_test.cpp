@@ -23,9 +23,12 @@
 #include "sdk/config.h"
 #include "sdk/msgapi/message_api_wwiv.h"
 #include "sdk/msgapi/msgapi.h"
+#include "sdk/msgapi/sub_qscan_table.h"
 #include "sdk/sdk_helper.h"
+#include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace wwiv::core;
@@ -172,3 +175,197 @@ TEST_F(MsgApiTest, Resynch_MessageNumber) {
   a2->ResyncMessage(msgnum);
   EXPECT_EQ(1, msgnum);
 }
+
+TEST_F(MsgApiTest, SeesChangesFromOtherArea) {
+  subboard_t sub{};
+  sub.filename = "a1";
+  ASSERT_TRUE(api->Create(sub, -1));
+  auto a1(api->Open(sub, -1));
+  auto a2(api->Open(sub, -1));
+  auto m(CreateMessage(*a1, 1, "From1", "Title1", "Line1\r\nLine2\r\n"));
+  EXPECT_TRUE(a1->AddMessage(m, {}));
+  EXPECT_EQ(1, a1->number_of_messages());
+  EXPECT_EQ(1, a2->number_of_messages());
+
+  m.header().set_from("From2");
+  m.header().set_title("Title2");
+  EXPECT_TRUE(a2->AddMessage(m, {}));
+  EXPECT_EQ(2, a1->number_of_messages());
+  EXPECT_TRUE(a1->Exists(m.header().daten(), "Title2", 0, 1));
+
+  EXPECT_TRUE(a1->DeleteMessage(1));
+  EXPECT_EQ(1, a2->number_of_messages());
+  EXPECT_EQ("From2", a2->ReadMessage(1)->header().from());
+  EXPECT_FALSE(a2->Exists(m.header().daten(), "Title1", 0, 1));
+}
+
+TEST_F(MsgApiTest, Exists) {
+  subboard_t sub{};
+  sub.filename = "a1";
+  ASSERT_TRUE(api->Create(sub, -1));
+  auto area(api->Open(sub, -1));
+  auto m(CreateMessage(*area, 1, "From1", "Title1", "Line1\r\nLine2\r\n"));
+  const auto daten = m.header().daten();
+  EXPECT_FALSE(area->Exists(daten, "Title1", 0, 1));
+  EXPECT_TRUE(area->AddMessage(m, {}));
+  m.header().set_title("Title2");
+  EXPECT_TRUE(area->AddMessage(m, {}));
+
+  EXPECT_TRUE(area->Exists(daten, "Title1", 0, 1));
+  EXPECT_TRUE(area->Exists(daten, "TITLE2", 0, 1));
+  EXPECT_FALSE(area->Exists(daten + 1, "Title1", 0, 1));
+  EXPECT_FALSE(area->Exists(daten, "Title1", 1, 1));
+  EXPECT_FALSE(area->Exists(daten, "Title1", 0, 2));
+  EXPECT_FALSE(area->Exists(daten, "Title3", 0, 1));
+
+  EXPECT_TRUE(area->DeleteMessage(1));
+  EXPECT_FALSE(area->Exists(daten, "Title1", 0, 1));
+  EXPECT_TRUE(area->Exists(daten, "Title2", 0, 1));
+}
+
+TEST_F(MsgApiTest, FindMessages) {
+  subboard_t sub{};
+  sub.filename = "a1";
+  ASSERT_TRUE(api->Create(sub, -1));
+  auto area(api->Open(sub, -1));
+  auto m1(CreateMessage(*area, 1, "From1", "Hello", "The quick brown fox\r\n"));
+  EXPECT_TRUE(area->AddMessage(m1, {}));
+  auto m2(CreateMessage(*area, 1, "From1", "World", "Jumps over the lazy dog\r\n"));
+  EXPECT_TRUE(area->AddMessage(m2, {}));
+
+  EXPECT_EQ(area->FindMessages("QUICK"), std::vector<int>({1}));
+  EXPECT_EQ(area->FindMessages("world"), std::vector<int>({2}));
+  EXPECT_EQ(area->FindMessages("THE"), std::vector<int>({1, 2}));
+  EXPECT_EQ(area->FindMessages("ZEBRA"), std::vector<int>());
+  EXPECT_FALSE(area->FindMessages("TO").has_value());
+
+  // Changes made through the area update the loaded index.
+  auto m3(CreateMessage(*area, 1, "From1", "Third", "Another quick one\r\n"));
+  EXPECT_TRUE(area->AddMessage(m3, {}));
+  EXPECT_TRUE(area->DeleteMessage(1));
+  EXPECT_EQ(area->FindMessages("QUICK"), std::vector<int>({2}));
+  EXPECT_TRUE(area->Close());
+  EXPECT_TRUE(File::Exists(FilePath(helper.datadir(), "a1.fts")));
+
+  auto a2(api->Open(sub, -1));
+  EXPECT_EQ(a2->FindMessages("QUICK"), std::vector<int>({2}));
+  EXPECT_EQ(a2->FindMessages("LAZY"), std::vector<int>({1}));
+}
+
+TEST_F(MsgApiTest, FindMessages_SeesChangesFromOtherArea) {
+  subboard_t sub{};
+  sub.filename = "a1";
+  ASSERT_TRUE(api->Create(sub, -1));
+  auto a1(api->Open(sub, -1));
+  auto a2(api->Open(sub, -1));
+  auto m(CreateMessage(*a1, 1, "From1", "Title1", "Apples\r\n"));
+  EXPECT_TRUE(a1->AddMessage(m, {}));
+  EXPECT_EQ(a1->FindMessages("APPLES"), std::vector<int>({1}));
+
+  auto m2(CreateMessage(*a2, 1, "From1", "Title2", "Oranges\r\n"));
+  EXPECT_TRUE(a2->AddMessage(m2, {}));
+  EXPECT_TRUE(a2->DeleteMessage(1));
+  EXPECT_EQ(a1->FindMessages("APPLES"), std::vector<int>());
+  EXPECT_EQ(a1->FindMessages("ORANGES"), std::vector<int>({1}));
+}
+
+TEST_F(MsgApiTest, AddMessage_UpdatesSubQScanTable) {
+  subboard_t sub{};
+  sub.filename = "a1";
+  ASSERT_TRUE(api->Create(sub, -1));
+  auto area(api->Open(sub, -1));
+  auto m(CreateMessage(*area, 1, "From1", "Title1", "Line1\r\n"));
+  EXPECT_TRUE(area->AddMessage(m, {}));
+
+  SubQScanTable table(helper.datadir());
+  ASSERT_TRUE(table.Load());
+  EXPECT_EQ(table.last_qscan("a1"), area->ReadMessageHeader(1)->data().qscan);
+}
+
+TEST_F(MsgApiTest, Pack) {
+  subboard_t sub{};
+  sub.filename = "a1";
+  ASSERT_TRUE(api->Create(sub, -1));
+  auto area(api->Open(sub, -1));
+  for (auto i = 1; i <= 3; i++) {
+    auto m(CreateMessage(*area, 1, "From1", StrCat("Title", i), StrCat("Text", i, "\r\n")));
+    EXPECT_TRUE(area->AddMessage(m, {}));
+  }
+  EXPECT_TRUE(area->DeleteMessage(1));
+  ASSERT_TRUE(area->Pack());
+  EXPECT_FALSE(File::Exists(FilePath(helper.datadir(), "a1.sub.tmp")));
+  EXPECT_FALSE(File::Exists(FilePath(helper.msgsdir(), "a1.dat.tmp")));
+
+  ASSERT_EQ(2, area->number_of_messages());
+  EXPECT_EQ(1u, area->ReadMessageHeader(1)->data().msg.stored_as);
+  EXPECT_EQ("Title2", area->ReadMessageHeader(1)->title());
+  EXPECT_EQ("Title3", area->ReadMessageHeader(2)->title());
+  EXPECT_TRUE(area->ReadMessageText(1)->string().find("Text2") != std::string::npos);
+  EXPECT_TRUE(area->ReadMessageText(2)->string().find("Text3") != std::string::npos);
+}
+
+TEST_F(MsgApiTest, Pack_InPlace) {
+  subboard_t sub{};
+  sub.filename = "a1";
+  ASSERT_TRUE(api->Create(sub, -1));
+  auto area(api->Open(sub, -1));
+  for (auto i = 1; i <= 3; i++) {
+    auto m(CreateMessage(*area, 1, "From1", StrCat("Title", i), StrCat("Text", i, "\r\n")));
+    EXPECT_TRUE(area->AddMessage(m, {}));
+  }
+  EXPECT_TRUE(area->DeleteMessage(1));
+
+  // Another instance that already has the files open, such as one waiting
+  // for the lock, needs to see the packed files rather than the old ones.
+  std::ifstream sub_file(FilePath(helper.datadir(), "a1.sub"), std::ios::binary);
+  std::ifstream dat_file(FilePath(helper.msgsdir(), "a1.dat"), std::ios::binary);
+  ASSERT_TRUE(sub_file && dat_file);
+  ASSERT_TRUE(area->Pack());
+
+  std::vector<postrec> posts(4);
+  sub_file.read(reinterpret_cast<char*>(&posts[0]), sizeof(postrec) * posts.size());
+  EXPECT_EQ(static_cast<std::streamsize>(3 * sizeof(postrec)), sub_file.gcount());
+  EXPECT_EQ(1u, posts[1].msg.stored_as);
+  EXPECT_STREQ("Title2", posts[1].title);
+  dat_file.seekg(0, std::ios::end);
+  EXPECT_EQ(File(FilePath(helper.msgsdir(), "a1.dat")).length(), dat_file.tellg());
+}
+
+TEST_F(MsgApiTest, DeleteMessages) {
+  subboard_t sub{};
+  sub.filename = "a1";
+  ASSERT_TRUE(api->Create(sub, -1));
+  auto area(api->Open(sub, -1));
+  for (auto i = 1; i <= 5; i++) {
+    auto m(CreateMessage(*area, 1, "From1", StrCat("Title", i), "Text\r\n"));
+    EXPECT_TRUE(area->AddMessage(m, {}));
+  }
+  EXPECT_TRUE(area->DeleteMessages({4, 1, 2}));
+
+  ASSERT_EQ(2, area->number_of_messages());
+  EXPECT_EQ("Title3", area->ReadMessageHeader(1)->title());
+  EXPECT_EQ("Title5", area->ReadMessageHeader(2)->title());
+  EXPECT_FALSE(area->DeleteMessages({1, 3}));
+  EXPECT_EQ(2, area->number_of_messages());
+}
+
+TEST_F(MsgApiTest, AddMessage_DeletesAllExcess) {
+  MessageApiOptions options;
+  options.overflow_strategy = OverflowStrategy::delete_all;
+  api.reset(new WWIVMessageApi(options, helper.config(), {}, new NullLastReadImpl()));
+  subboard_t sub{};
+  sub.filename = "a1";
+  ASSERT_TRUE(api->Create(sub, -1));
+  auto area(api->Open(sub, -1));
+  for (auto i = 1; i <= 5; i++) {
+    auto m(CreateMessage(*area, 1, "From1", StrCat("Title", i), "Text\r\n"));
+    EXPECT_TRUE(area->AddMessage(m, {}));
+  }
+  area->set_max_messages(2);
+  auto m(CreateMessage(*area, 1, "From1", "Title6", "Text\r\n"));
+  EXPECT_TRUE(area->AddMessage(m, {}));
+
+  ASSERT_EQ(2, area->number_of_messages());
+  EXPECT_EQ("Title5", area->ReadMessageHeader(1)->title());
+  EXPECT_EQ("Title6", area->ReadMessageHeader(2)->title());
+}
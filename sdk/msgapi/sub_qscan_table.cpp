@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "sdk/msgapi/sub_qscan_table.h"
+
+#include "core/datafile.h"
+#include "core/file.h"
+#include "core/log.h"
+#include "core/strings.h"
+#include "sdk/filenames.h"
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace wwiv::sdk::msgapi {
+
+using namespace wwiv::core;
+using namespace wwiv::strings;
+
+static std::string rec_filename(const sub_qscan_rec_t& r) {
+  return ToStringLowerCase(std::string(r.filename, strnlen(r.filename, sizeof(r.filename))));
+}
+
+SubQScanTable::SubQScanTable(std::filesystem::path datadir)
+    : path_(std::move(datadir) / SUBS_QSCAN_DAT) {}
+
+bool SubQScanTable::Load() {
+  qscans_.clear();
+  if (!File::Exists(path_)) {
+    return false;
+  }
+  const DataFileView<sub_qscan_rec_t> recs(path_);
+  if (!recs) {
+    return false;
+  }
+  qscans_.reserve(static_cast<size_t>(recs.size()));
+  for (const auto& r : recs) {
+    qscans_[rec_filename(r)] = r.qscan;
+  }
+  return true;
+}
+
+std::optional<uint32_t> SubQScanTable::last_qscan(const std::string& filename) const {
+  if (const auto it = qscans_.find(ToStringLowerCase(filename)); it != std::end(qscans_)) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+bool SubQScanTable::Update(const std::string& filename, uint32_t qscan) {
+  sub_qscan_rec_t rec{};
+  if (filename.empty() || filename.size() > sizeof(rec.filename)) {
+    // Leave it unknown, so it's always checked.
+    return false;
+  }
+  const auto key = ToStringLowerCase(filename);
+  DataFile<sub_qscan_rec_t> file(path_,
+                                 File::modeBinary | File::modeReadWrite | File::modeCreateFile);
+  if (!file) {
+    LOG(WARNING) << "Unable to open: " << path_;
+    return false;
+  }
+  std::vector<sub_qscan_rec_t> recs;
+  if (!file.ReadVector(recs)) {
+    return false;
+  }
+  auto recno = 0;
+  for (const auto& r : recs) {
+    if (rec_filename(r) == key) {
+      if (r.qscan >= qscan) {
+        qscans_[key] = r.qscan;
+        return true;
+      }
+      break;
+    }
+    ++recno;
+  }
+  memcpy(rec.filename, key.data(), key.size());
+  rec.qscan = qscan;
+  if (!file.Write(recno, &rec)) {
+    LOG(WARNING) << "Unable to write: " << path_;
+    return false;
+  }
+  qscans_[key] = qscan;
+  return true;
+}
+
+}  // namespace
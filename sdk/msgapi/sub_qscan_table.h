@@ -0,0 +1,83 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#ifndef INCLUDED_SDK_MSGAPI_SUB_QSCAN_TABLE_H
+#define INCLUDED_SDK_MSGAPI_SUB_QSCAN_TABLE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace wwiv::sdk::msgapi {
+
+#pragma pack(push, 1)
+struct sub_qscan_rec_t {
+  // subboard_t::filename of the sub, NUL padded.
+  char filename[16];
+  // qscan pointer of the newest post added to the sub.
+  uint32_t qscan;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(sub_qscan_rec_t) == 20);
+
+/**
+ * Table of the newest qscan pointer posted to each sub, shared by all
+ * instances in SUBS_QSCAN_DAT.
+ *
+ * Everything that adds a post updates the table, so a new message scan can
+ * tell that a sub has nothing new for a user without opening the sub at all.
+ * Subs missing from the table (nothing was posted to them since it was
+ * created) still need to be checked the slow way, and Update can be used to
+ * seed the table with what was found.
+ *
+ * Since qscan pointers only ever grow, a value in the table is never lowered,
+ * so deleting the newest post leaves the table a little high, which only
+ * makes the sub look changed.
+ */
+class SubQScanTable final {
+public:
+  /** datadir is the directory holding SUBS_QSCAN_DAT */
+  explicit SubQScanTable(std::filesystem::path datadir);
+
+  /**
+   * Reads the whole table (it is memory mapped) into memory. Returns false
+   * if it does not exist or can not be read, in which case every sub is
+   * unknown.
+   */
+  bool Load();
+
+  /** qscan pointer of the newest post in sub filename, if known */
+  [[nodiscard]] std::optional<uint32_t> last_qscan(const std::string& filename) const;
+
+  /**
+   * Records that sub filename has a post with qscan pointer qscan, raising
+   * its entry if needed. Returns false if the table could not be written.
+   */
+  bool Update(const std::string& filename, uint32_t qscan);
+
+private:
+  const std::filesystem::path path_;
+  std::unordered_map<std::string, uint32_t> qscans_;
+};
+
+}  // namespace
+
+#endif
@@ -0,0 +1,65 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "gtest/gtest.h"
+
+#include "core/file.h"
+#include "core/test/file_helper.h"
+#include "sdk/filenames.h"
+#include "sdk/msgapi/sub_qscan_table.h"
+#include <optional>
+
+using namespace wwiv::core;
+using namespace wwiv::sdk::msgapi;
+
+class SubQScanTableTest : public testing::Test {
+public:
+  wwiv::core::test::FileHelper helper_;
+};
+
+TEST_F(SubQScanTableTest, Missing) {
+  SubQScanTable table(helper_.TempDir());
+  EXPECT_FALSE(table.Load());
+  EXPECT_FALSE(table.last_qscan("general").has_value());
+}
+
+TEST_F(SubQScanTableTest, Update) {
+  {
+    SubQScanTable table(helper_.TempDir());
+    EXPECT_TRUE(table.Update("general", 10));
+    EXPECT_TRUE(table.Update("sysop", 11));
+    EXPECT_TRUE(table.Update("GENERAL", 12));
+    // Never lowered.
+    EXPECT_TRUE(table.Update("sysop", 5));
+    EXPECT_EQ(std::optional<uint32_t>(11), table.last_qscan("sysop"));
+  }
+
+  SubQScanTable table(helper_.TempDir());
+  ASSERT_TRUE(table.Load());
+  EXPECT_EQ(std::optional<uint32_t>(12), table.last_qscan("General"));
+  EXPECT_EQ(std::optional<uint32_t>(11), table.last_qscan("sysop"));
+  EXPECT_FALSE(table.last_qscan("other").has_value());
+  EXPECT_EQ(2 * static_cast<int>(sizeof(sub_qscan_rec_t)),
+            File(FilePath(helper_.TempDir(), SUBS_QSCAN_DAT)).length());
+}
+
+TEST_F(SubQScanTableTest, FilenameTooLong) {
+  SubQScanTable table(helper_.TempDir());
+  EXPECT_FALSE(table.Update("areallylongsubfilename", 10));
+  EXPECT_FALSE(table.last_qscan("areallylongsubfilename").has_value());
+}
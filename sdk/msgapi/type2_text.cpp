@@ -19,9 +19,13 @@
 
 #include "core/datafile.h"
 #include "core/file.h"
+#include "core/log.h"
 #include "core/stl.h"
 #include "core/strings.h"
 #include "sdk/vardec.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
 #include <optional>
 #include <string>
 #include <utility>
@@ -45,27 +49,42 @@ Type2Text::Type2Text(std::filesystem::path p) : path_(std::move(p)) {}
 // Implementation Details
 
 bool Type2Text::remove_link(const messagerec& msg) {
+  return remove_links({msg});
+}
+
+bool Type2Text::remove_links(const std::vector<messagerec>& msgs) {
   auto file = OpenMessageFile();
   if (!file || !file->IsOpen()) {
     return false;
   }
-  const auto section = static_cast<int>(msg.stored_as / GAT_NUMBER_ELEMENTS);
-  auto gat = load_gat(*file, section);
-  auto current_section = msg.stored_as % GAT_NUMBER_ELEMENTS;
-  while (current_section > 0 && current_section < GAT_NUMBER_ELEMENTS) {
-    const uint32_t next_section = static_cast<long>(gat[current_section]);
-    gat[current_section] = 0;
-    current_section = next_section;
+  std::map<int, std::vector<uint32_t>> sections;
+  for (const auto& msg : msgs) {
+    sections[static_cast<int>(msg.stored_as / GAT_NUMBER_ELEMENTS)].push_back(msg.stored_as);
+  }
+  for (const auto& [section, stored_as] : sections) {
+    auto gat = load_gat(*file, section);
+    for (const auto s : stored_as) {
+      auto current_section = s % GAT_NUMBER_ELEMENTS;
+      auto freed = 0;
+      while (current_section > 0 && current_section < GAT_NUMBER_ELEMENTS &&
+             freed < GAT_NUMBER_ELEMENTS) {
+        const uint32_t next_section = static_cast<long>(gat[current_section]);
+        gat[current_section] = 0;
+        current_section = next_section;
+        ++freed;
+      }
+    }
+    save_gat(*file, section, gat);
+    if (section < ssize(free_blocks_)) {
+      free_blocks_[section] = -1;
+    }
   }
-  save_gat(*file, section, gat);
   file->Close();
   return true;
 }
 
-
 /**
 * Opens the message area file {messageAreaFileName} and returns the file handle.
-* Note: This is a Private method to this module.
 */
 std::optional<File> Type2Text::OpenMessageFile() const {
   // TODO(rushfan): Pass in the status manager. this is needed to
@@ -116,33 +135,63 @@ void Type2Text::save_gat(File& file, int section, const std::vector<gati_t>& gat
 }
 
 std::optional<std::string> Type2Text::readfile(const messagerec& msg) {
-  auto file(OpenMessageFile());
-  if (!file || !file->IsOpen()) {
+  File file(path_);
+  if (!file.Open(File::modeReadOnly | File::modeBinary)) {
     // TODO(rushfan): set error code,
     return std::nullopt;
   }
+  return readfile(file, msg);
+}
+
+std::optional<std::string> Type2Text::readfile(File& file, const messagerec& msg) {
   const uint32_t gat_section = msg.stored_as / GAT_NUMBER_ELEMENTS;
-  auto gat = load_gat(*file, gat_section);
+  const auto section_pos = static_cast<File::size_type>(gat_section) * GATSECLEN;
+  if (file.length() < section_pos + GAT_SECTION_SIZE) {
+    LOG(ERROR) << "GAT section missing for message stored_as: " << msg.stored_as;
+    return std::nullopt;
+  }
+  std::vector<gati_t> gat(GAT_NUMBER_ELEMENTS);
+  file.Seek(section_pos, File::Whence::begin);
+  if (file.Read(&gat[0], GAT_SECTION_SIZE) != GAT_SECTION_SIZE) {
+    LOG(ERROR) << "Error reading GAT for message stored_as: " << msg.stored_as;
+    return std::nullopt;
+  }
 
+  // Follow the chain first so that contiguous blocks can be read at once.
+  std::vector<gati_t> blocks;
   auto current_section = msg.stored_as % GAT_NUMBER_ELEMENTS;
-  std::string out;
-  while (current_section > 0 && current_section < GAT_NUMBER_ELEMENTS) {
-    const auto pos = file->Seek(MSG_STARTING(gat_section) + MSG_BLOCK_SIZE * current_section, File::Whence::begin);
+  while (current_section > 0 && current_section < GAT_NUMBER_ELEMENTS &&
+         ssize(blocks) < GAT_NUMBER_ELEMENTS) {
+    blocks.push_back(static_cast<gati_t>(current_section));
+    current_section = gat[current_section];
+  }
+
+  std::string raw(blocks.size() * MSG_BLOCK_SIZE, '\0');
+  for (size_t i = 0; i < blocks.size();) {
+    auto run = 1;
+    while (i + run < blocks.size() && blocks[i + run] == blocks[i] + run) {
+      ++run;
+    }
+    const auto pos =
+        file.Seek(MSG_STARTING(gat_section) + MSG_BLOCK_SIZE * blocks[i], File::Whence::begin);
     if (pos == -1) {
       // Error seeking occurred.
       LOG(ERROR) << "Error seeking to position for message stored_as: " << msg.stored_as;
       return std::nullopt;
     }
-    char b[MSG_BLOCK_SIZE + 1];
-    const auto ret = file->Read(b, MSG_BLOCK_SIZE);
-    if (ret == -1) {
-      // Error seeking occurred.
+    if (file.Read(&raw[i * MSG_BLOCK_SIZE], run * MSG_BLOCK_SIZE) == -1) {
       LOG(ERROR) << "Error reading block for message stored_as: " << msg.stored_as;
       return std::nullopt;
     }
-    b[MSG_BLOCK_SIZE] = '\0';
-    out.append(b);
-    current_section = gat[current_section];
+    i += run;
+  }
+
+  std::string out;
+  out.reserve(raw.size());
+  for (size_t i = 0; i < blocks.size(); i++) {
+    // Each block holds text up to the first NUL.
+    const auto* b = &raw[i * MSG_BLOCK_SIZE];
+    out.append(b, strnlen(b, MSG_BLOCK_SIZE));
   }
 
   const long last_cz = out.find_last_of(CZ);
@@ -154,46 +203,251 @@ std::optional<std::string> Type2Text::readfile(const messagerec& msg) {
   return {out};
 }
 
+std::vector<gati_t> Type2Text::find_free_blocks(const std::vector<gati_t>& gat, int num_blocks) {
+  std::vector<gati_t> first_free;
+  gati_t run_start = 0;
+  auto run = 0;
+  for (gati_t i = 1; i < GAT_NUMBER_ELEMENTS; i++) {
+    if (gat[i] != 0) {
+      run = 0;
+      continue;
+    }
+    if (run++ == 0) {
+      run_start = i;
+    }
+    if (run == num_blocks) {
+      std::vector<gati_t> blocks(num_blocks);
+      for (auto b = 0; b < num_blocks; b++) {
+        blocks[b] = static_cast<gati_t>(run_start + b);
+      }
+      return blocks;
+    }
+    if (ssize(first_free) < num_blocks) {
+      first_free.push_back(i);
+    }
+  }
+  // No run is long enough, so fall back to the lowest free blocks.
+  if (ssize(first_free) < num_blocks) {
+    return {};
+  }
+  return first_free;
+}
+
 std::optional<messagerec> Type2Text::savefile(const std::string& text) {
-  std::vector<gati_t> gati;
   auto msgfile(OpenMessageFile());
   if (!msgfile || !msgfile->IsOpen()) {
     // Unable to write to the message file.
     return std::nullopt;
   }
-  int section = 0;
-  for (; section < 1024; section++) {
+  const auto num_blocks_required =
+      std::max<int>(1, static_cast<int>((text.length() + MSG_BLOCK_SIZE - 1) / MSG_BLOCK_SIZE));
+  if (num_blocks_required >= GAT_NUMBER_ELEMENTS) {
+    LOG(ERROR) << "Message text is too large to save: " << text.length();
+    return std::nullopt;
+  }
+  for (auto section = 0; section < GAT_MAX_SECTIONS; section++) {
+    if (section < ssize(free_blocks_) && free_blocks_[section] >= 0 &&
+        free_blocks_[section] < num_blocks_required) {
+      continue;
+    }
     auto gat = load_gat(*msgfile, section);
-    const auto num_blocks_required = static_cast<int>((text.length() + MSG_BLOCK_SIZE - 1) / MSG_BLOCK_SIZE);
-    gati_t i4 = 1;
-    gati.clear();
-    while (ssize(gati) < num_blocks_required && i4 < GAT_NUMBER_ELEMENTS) {
-      if (gat[i4] == 0) {
-        gati.push_back(i4);
-      }
-      ++i4;
-    }
-    if (size_int(gati) >= num_blocks_required) {
-      constexpr auto none = static_cast<uint16_t>(-1);
-      gati.push_back(none);
-      const auto text_len = ssize(text);
-      for (auto i = 0; i < num_blocks_required; i++) {
-        char block[MSG_BLOCK_SIZE + 1];
-        memset(block, 0, sizeof(block));
-        msgfile->Seek(MSG_STARTING(section) + MSG_BLOCK_SIZE * static_cast<long>(gati[i]), File::Whence::begin);
-        const auto remaining = std::min(text_len - (i * MSG_BLOCK_SIZE), MSG_BLOCK_SIZE);
-        memcpy(block, &text[i * MSG_BLOCK_SIZE], remaining);
-        msgfile->Write(block, MSG_BLOCK_SIZE);
-        gat[gati[i]] = gati[i + 1];
+    const auto blocks = find_free_blocks(gat, num_blocks_required);
+    const auto num_free = static_cast<int>(
+        std::count(std::begin(gat) + 1, std::end(gat), static_cast<gati_t>(0)));
+    if (section >= ssize(free_blocks_)) {
+      free_blocks_.resize(section + 1, -1);
+    }
+    if (blocks.empty()) {
+      free_blocks_[section] = num_free;
+      continue;
+    }
+
+    std::string buf(num_blocks_required * MSG_BLOCK_SIZE, '\0');
+    memcpy(&buf[0], text.data(), text.length());
+    constexpr auto none = static_cast<uint16_t>(-1);
+    for (auto i = 0; i < num_blocks_required;) {
+      // Write each run of contiguous blocks at once.
+      auto run = 1;
+      while (i + run < num_blocks_required && blocks[i + run] == blocks[i] + run) {
+        ++run;
       }
-      save_gat(*msgfile, section, gat);
+      msgfile->Seek(MSG_STARTING(section) + MSG_BLOCK_SIZE * static_cast<long>(blocks[i]),
+                    File::Whence::begin);
+      msgfile->Write(&buf[i * MSG_BLOCK_SIZE], run * MSG_BLOCK_SIZE);
+      i += run;
+    }
+    for (auto i = 0; i < num_blocks_required; i++) {
+      gat[blocks[i]] = i + 1 < num_blocks_required ? blocks[i + 1] : none;
+    }
+    save_gat(*msgfile, section, gat);
+    free_blocks_[section] = num_free - num_blocks_required;
+
+    messagerec m{};
+    m.storage_type = STORAGE_TYPE;
+    m.stored_as = static_cast<uint32_t>(blocks[0]) + static_cast<uint32_t>(section) * GAT_NUMBER_ELEMENTS;
+    return {m};
+  }
+  LOG(ERROR) << "No room left in message file: " << path_.string();
+  return std::nullopt;
+}
+
+std::optional<std::vector<messagerec>> Type2Text::pack(File& msgfile,
+                                                       const std::vector<messagerec>& msgs,
+                                                       const std::filesystem::path& packed_path) {
+  std::vector<std::string> texts;
+  texts.reserve(msgs.size());
+  for (const auto& m : msgs) {
+    auto text = m.storage_type == STORAGE_TYPE ? readfile(msgfile, m) : std::nullopt;
+    if (!text) {
+      LOG(ERROR) << "Unable to read text for stored_as: " << m.stored_as << " in " << path_;
+      return std::nullopt;
+    }
+    texts.emplace_back(std::move(text.value()));
+  }
+
+  File packed(packed_path);
+  if (!packed.Open(File::modeReadWrite | File::modeBinary | File::modeCreateFile |
+                   File::modeTruncate)) {
+    LOG(ERROR) << "Unable to create: " << packed_path;
+    return std::nullopt;
+  }
+  auto result = write_sections(packed, 0, texts);
+  packed.Close();
+  if (!result) {
+    File::Remove(packed_path);
+    return std::nullopt;
+  }
+  return result;
+}
+
+bool Type2Text::replace_with_packed(File& msgfile, const std::filesystem::path& packed_path) {
+  // Every GAT section changed.
+  free_blocks_.clear();
+  File packed(packed_path);
+  if (!packed.Open(File::modeReadOnly | File::modeBinary)) {
+    LOG(ERROR) << "Unable to open: " << packed_path;
+    return false;
+  }
+  std::vector<char> buf(64 * 1024);
+  File::size_type pos = 0;
+  for (;;) {
+    const auto num = packed.Read(buf.data(), ssize(buf));
+    if (num < 0) {
+      LOG(ERROR) << "Unable to read: " << packed_path;
+      return false;
+    }
+    if (num == 0) {
+      break;
+    }
+    if (msgfile.WriteAt(pos, buf.data(), num) != num) {
+      LOG(ERROR) << "Unable to write: " << path_;
+      return false;
+    }
+    pos += num;
+  }
+  if (!msgfile.set_length(pos)) {
+    LOG(ERROR) << "Unable to set the length of: " << path_;
+    return false;
+  }
+  packed.Close();
+  return File::Remove(packed_path);
+}
+
+std::optional<std::vector<messagerec>> Type2Text::savefiles(const std::vector<std::string>& texts) {
+  if (texts.empty()) {
+    return std::vector<messagerec>{};
+  }
+  auto msgfile(OpenMessageFile());
+  if (!msgfile || !msgfile->IsOpen()) {
+    return std::nullopt;
+  }
+  // Start after the last section holding any text, everything past it is free.
+  const auto num_sections =
+      static_cast<int>((msgfile->length() + GATSECLEN - 1) / GATSECLEN);
+  auto first_section = 0;
+  for (auto section = num_sections - 1; section >= 0; section--) {
+    const auto gat = load_gat(*msgfile, section);
+    if (std::any_of(std::begin(gat), std::end(gat), [](gati_t g) { return g != 0; })) {
+      first_section = section + 1;
       break;
     }
   }
-  messagerec m{};
-  m.storage_type = STORAGE_TYPE;
-  m.stored_as = static_cast<uint32_t>(gati[0]) + static_cast<uint32_t>(section) * GAT_NUMBER_ELEMENTS;
-  return {m};
+  auto result = write_sections(*msgfile, first_section, texts);
+  free_blocks_.clear();
+  return result;
+}
+
+std::optional<std::vector<messagerec>>
+Type2Text::write_sections(File& msgfile, int first_section, const std::vector<std::string>& texts) {
+  // Find the last section needed first, so nothing is written if they don't fit.
+  auto last_section = first_section;
+  auto used = 1;
+  for (const auto& text : texts) {
+    const auto num_blocks =
+        std::max<int>(1, static_cast<int>((text.size() + MSG_BLOCK_SIZE - 1) / MSG_BLOCK_SIZE));
+    if (num_blocks >= GAT_NUMBER_ELEMENTS) {
+      LOG(ERROR) << "Message text is too large to save: " << text.size();
+      return std::nullopt;
+    }
+    if (used + num_blocks > GAT_NUMBER_ELEMENTS) {
+      ++last_section;
+      used = 1;
+    }
+    used += num_blocks;
+  }
+  if (last_section >= GAT_MAX_SECTIONS) {
+    LOG(ERROR) << "Message text needs more than " << GAT_MAX_SECTIONS << " GAT sections.";
+    return std::nullopt;
+  }
+
+  std::vector<messagerec> result;
+  result.reserve(texts.size());
+  std::vector<gati_t> gat(GAT_NUMBER_ELEMENTS);
+  std::string blocks(GAT_NUMBER_ELEMENTS * MSG_BLOCK_SIZE, '\0');
+  auto section = first_section;
+  gati_t next_block = 1;
+  File::size_type file_size = 0;
+  auto write_section = [&]() -> bool {
+    const auto section_pos = static_cast<File::size_type>(section) * GATSECLEN;
+    const auto len = next_block * MSG_BLOCK_SIZE;
+    msgfile.Seek(section_pos, File::Whence::begin);
+    if (msgfile.Write(&gat[0], GAT_SECTION_SIZE) != GAT_SECTION_SIZE ||
+        msgfile.Write(&blocks[0], len) != len) {
+      return false;
+    }
+    file_size = section_pos + GAT_SECTION_SIZE + len;
+    return true;
+  };
+
+  constexpr auto none = static_cast<uint16_t>(-1);
+  for (const auto& text : texts) {
+    const auto num_blocks =
+        std::max<int>(1, static_cast<int>((text.size() + MSG_BLOCK_SIZE - 1) / MSG_BLOCK_SIZE));
+    if (next_block + num_blocks > GAT_NUMBER_ELEMENTS) {
+      if (!write_section()) {
+        return std::nullopt;
+      }
+      ++section;
+      next_block = 1;
+      std::fill(std::begin(gat), std::end(gat), static_cast<gati_t>(0));
+      std::fill(std::begin(blocks), std::end(blocks), '\0');
+    }
+    memcpy(&blocks[next_block * MSG_BLOCK_SIZE], text.data(), text.size());
+    for (auto i = 0; i < num_blocks; i++) {
+      const auto b = static_cast<gati_t>(next_block + i);
+      gat[b] = i + 1 < num_blocks ? static_cast<gati_t>(b + 1) : none;
+    }
+    messagerec m{};
+    m.storage_type = STORAGE_TYPE;
+    m.stored_as = static_cast<uint32_t>(next_block) + static_cast<uint32_t>(section) * GAT_NUMBER_ELEMENTS;
+    result.push_back(m);
+    next_block = static_cast<gati_t>(next_block + num_blocks);
+  }
+  if (!write_section()) {
+    return std::nullopt;
+  }
+  msgfile.set_length(file_size);
+  return result;
 }
 
 } // namespace wwiv
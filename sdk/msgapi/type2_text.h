@@ -35,6 +35,8 @@ static constexpr int32_t GAT_NUMBER_ELEMENTS = 2048;
 static constexpr int32_t GAT_SECTION_SIZE = GAT_NUMBER_ELEMENTS * sizeof(gati_t);
 static constexpr int32_t MSG_BLOCK_SIZE = 512;
 static constexpr int32_t GATSECLEN = GAT_SECTION_SIZE + GAT_NUMBER_ELEMENTS * MSG_BLOCK_SIZE;
+// Most GAT sections a message file may have, the BBS never looks past these.
+static constexpr int32_t GAT_MAX_SECTIONS = 1024;
 static constexpr uint8_t STORAGE_TYPE = 2;
 
 
@@ -47,10 +49,75 @@ public:
   [[nodiscard]] std::optional<std::string> readfile(const messagerec& msg);
   [[nodiscard]] std::optional<messagerec> savefile(const std::string& text);
   [[nodiscard]] bool remove_link(const messagerec& msg);
+  /** Removes the text of all of msgs, writing each GAT section touched once. */
+  [[nodiscard]] bool remove_links(const std::vector<messagerec>& msgs);
+  /** Full path to the text file */
+  [[nodiscard]] const std::filesystem::path& text_path() const noexcept { return path_; }
 
-private:
+  /**
+   * Opens the text file for reading and writing. Nothing else may write to
+   * it until the returned file is closed.
+   */
   [[nodiscard]] std::optional<core::File> OpenMessageFile() const;
+
+  /**
+   * Writes a packed copy of msgfile, the open text file, to packed_path that
+   * only holds the text of msgs, each in contiguous blocks and in the order
+   * given, so reading them in that order reads the file front to back. The
+   * text file itself is not changed, the caller copies packed_path over it
+   * with replace_with_packed once everything else that refers to the new
+   * layout has been written.
+   *
+   * Returns the new messagerec for each of msgs, in the same order, or
+   * std::nullopt (and removes packed_path) if the text of any of msgs can
+   * not be read or packed_path can not be written.
+   */
+  [[nodiscard]] std::optional<std::vector<messagerec>>
+  pack(core::File& msgfile, const std::vector<messagerec>& msgs,
+       const std::filesystem::path& packed_path);
+  /**
+   * Copies packed_path, written by pack, over the contents of msgfile and
+   * removes it. The text file is rewritten in place rather than replaced, so
+   * anyone already waiting to open it sees the packed text. packed_path is
+   * left behind if it can not all be copied.
+   */
+  [[nodiscard]] bool replace_with_packed(core::File& msgfile,
+                                         const std::filesystem::path& packed_path);
+
+  /**
+   * Saves all of texts at once, each in contiguous blocks in new GAT sections
+   * after the last one in use, so it is much faster than calling savefile for
+   * each of them when importing or generating many messages.
+   *
+   * Returns the messagerec for each of texts, in the same order, or
+   * std::nullopt if they could not be saved.
+   */
+  [[nodiscard]] std::optional<std::vector<messagerec>> savefiles(const std::vector<std::string>& texts);
+
+private:
+  /** Reads the text of msg from file, which must already be open. */
+  [[nodiscard]] static std::optional<std::string> readfile(core::File& file, const messagerec& msg);
+  /**
+   * Writes texts into file one after another starting at GAT section
+   * first_section, replacing everything from there on. Nothing is written
+   * if they do not all fit before GAT_MAX_SECTIONS.
+   */
+  [[nodiscard]] static std::optional<std::vector<messagerec>>
+  write_sections(core::File& file, int first_section, const std::vector<std::string>& texts);
+  /**
+   * Returns the blocks to use in gat for a message needing num_blocks blocks,
+   * preferring the lowest run of contiguous free blocks, or an empty vector
+   * if the section does not have enough free blocks.
+   */
+  [[nodiscard]] static std::vector<gati_t> find_free_blocks(const std::vector<gati_t>& gat,
+                                                            int num_blocks);
+
   const std::filesystem::path path_;
+  // Number of free blocks seen in each GAT section the last time it was
+  // loaded, or -1 if not known. Only used to skip over sections that were
+  // too full, the GAT is always reloaded before allocating from it since
+  // other instances may have changed it.
+  std::vector<int> free_blocks_;
 };
 
 }  // namespace msgapi
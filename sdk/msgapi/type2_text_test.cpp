@@ -25,6 +25,7 @@
 #include "sdk/msgapi/type2_text.h"
 #include <memory>
 #include <optional>
+#include <vector>
 
 using namespace std;
 using namespace wwiv::core;
@@ -149,3 +150,182 @@ TEST_F(Type2TextTest, Move_To_Next_Gat_Section) {
 }
 
 
+TEST_F(Type2TextTest, Prefers_Contiguous_Blocks) {
+  ASSERT_TRUE(CreateMsgTextFile());
+
+  auto m1 = save_message("Hello World");
+  ASSERT_EQ(1u, m1->stored_as);
+  auto m2 = save_message("Hello World2");
+  ASSERT_EQ(2u, m2->stored_as);
+  ASSERT_TRUE(t_->remove_link(m1.value()));
+
+  // Block 1 is free, but too small to hold 2 blocks in a row.
+  const std::string two_blocks(513, 'x');
+  auto m3 = save_message(two_blocks);
+  ASSERT_EQ(3u, m3->stored_as);
+  EXPECT_EQ(two_blocks, readfile(m3.value()).value_or(""));
+
+  // Single blocks still fill the holes first.
+  auto m4 = save_message("Hello World4");
+  ASSERT_EQ(1u, m4->stored_as);
+}
+
+TEST_F(Type2TextTest, Read_Scattered_Blocks) {
+  ASSERT_TRUE(CreateMsgTextFile());
+
+  std::vector<messagerec> singles;
+  for (auto i = 0; i < 4; i++) {
+    singles.push_back(save_message(StrCat("Hello World", i)).value());
+  }
+  auto tail = save_message("Tail");
+  ASSERT_EQ(5u, tail->stored_as);
+  ASSERT_TRUE(t_->remove_link(singles.at(0)));
+  ASSERT_TRUE(t_->remove_link(singles.at(2)));
+
+  // No run of 3 free blocks before 6, and blocks 1 and 3 are free, so this
+  // uses blocks 6, 7 and 8 in a row.
+  std::string text(3 * 512 - 10, 'a');
+  text[600] = 'b';
+  text[1200] = 'c';
+  auto m = save_message(text);
+  ASSERT_EQ(6u, m->stored_as);
+  EXPECT_EQ(text, readfile(m.value()).value_or(""));
+
+  // With only 4 free blocks left in the section and no run of 4, they are
+  // scattered.
+  File f(path_);
+  ASSERT_TRUE(f.Open(File::modeBinary | File::modeReadWrite));
+  auto gat = t_->load_gat(f, 0);
+  for (auto i = 9; i < GAT_NUMBER_ELEMENTS - 2; i++) {
+    gat[i] = static_cast<gati_t>(-1);
+  }
+  t_->save_gat(f, 0, gat);
+  f.Close();
+
+  Type2Text t2(path_);
+  const std::string four_blocks(3 * 512 + 1, 'z');
+  auto m5 = t2.savefile(four_blocks);
+  ASSERT_EQ(1u, m5->stored_as);
+  EXPECT_EQ(four_blocks, t2.readfile(m5.value()).value_or(""));
+}
+
+TEST_F(Type2TextTest, Pack) {
+  ASSERT_TRUE(CreateMsgTextFile());
+
+  const std::string two_blocks(513, 'x');
+  auto m1 = save_message("Hello World");
+  auto m2 = save_message("Deleted");
+  auto m3 = save_message(two_blocks);
+  auto m4 = save_message("Hello World4");
+  ASSERT_TRUE(t_->remove_link(m2.value()));
+
+  // Put the messages in a new order.
+  auto packed_path = path_;
+  packed_path += ".tmp";
+  std::optional<std::vector<messagerec>> packed;
+  {
+    File f(path_);
+    ASSERT_TRUE(f.Open(File::modeBinary | File::modeReadWrite));
+    packed = t_->pack(f, {m4.value(), m1.value(), m3.value()}, packed_path);
+    ASSERT_TRUE(packed.has_value());
+    ASSERT_TRUE(t_->replace_with_packed(f, packed_path));
+  }
+  EXPECT_FALSE(File::Exists(packed_path));
+  ASSERT_EQ(3u, packed->size());
+  EXPECT_EQ(1u, packed->at(0).stored_as);
+  EXPECT_EQ(2u, packed->at(1).stored_as);
+  EXPECT_EQ(3u, packed->at(2).stored_as);
+
+  EXPECT_EQ("Hello World4", readfile(packed->at(0)).value_or(""));
+  EXPECT_EQ("Hello World", readfile(packed->at(1)).value_or(""));
+  EXPECT_EQ(two_blocks, readfile(packed->at(2)).value_or(""));
+  EXPECT_EQ(GAT_SECTION_SIZE + 5 * MSG_BLOCK_SIZE, File(path_).length());
+
+  // New messages go after the packed ones.
+  auto m5 = save_message("Hello World5");
+  EXPECT_EQ(5u, m5->stored_as);
+}
+
+TEST_F(Type2TextTest, Pack_UnreadableText) {
+  ASSERT_TRUE(CreateMsgTextFile());
+
+  auto m1 = save_message("Hello World");
+  const auto size = File(path_).length();
+  messagerec missing{};
+  missing.storage_type = STORAGE_TYPE;
+  // GAT section 5 does not exist.
+  missing.stored_as = 5 * GAT_NUMBER_ELEMENTS + 1;
+
+  auto packed_path = path_;
+  packed_path += ".tmp";
+  {
+    File f(path_);
+    ASSERT_TRUE(f.Open(File::modeBinary | File::modeReadWrite));
+    EXPECT_FALSE(t_->pack(f, {m1.value(), missing}, packed_path).has_value());
+  }
+  EXPECT_FALSE(File::Exists(packed_path));
+  EXPECT_EQ(size, File(path_).length());
+  EXPECT_EQ("Hello World", readfile(m1.value()).value_or(""));
+}
+
+TEST_F(Type2TextTest, RemoveLinks) {
+  ASSERT_TRUE(CreateMsgTextFile());
+
+  auto m1 = save_message("Hello World");
+  auto m2 = save_message(std::string(513, 'x'));
+  auto m4 = save_message("Hello World4");
+  ASSERT_TRUE(t_->remove_links({m1.value(), m2.value()}));
+
+  File f(path_);
+  ASSERT_TRUE(f.Open(File::modeBinary | File::modeReadWrite));
+  auto gat = t_->load_gat(f, 0);
+  EXPECT_EQ(0, gat[1]);
+  EXPECT_EQ(0, gat[2]);
+  EXPECT_EQ(0, gat[3]);
+  EXPECT_NE(0, gat[4]);
+  f.Close();
+  EXPECT_EQ("Hello World4", readfile(m4.value()).value_or(""));
+}
+
+TEST_F(Type2TextTest, SaveFiles) {
+  ASSERT_TRUE(CreateMsgTextFile());
+  auto m1 = save_message("Hello World");
+
+  const std::string two_blocks(513, 'x');
+  auto saved = t_->savefiles({"Hello World2", two_blocks});
+  ASSERT_TRUE(saved.has_value());
+  ASSERT_EQ(2u, saved->size());
+  // Section 0 is in use, so they go in the next section.
+  EXPECT_EQ(GAT_NUMBER_ELEMENTS + 1u, saved->at(0).stored_as);
+  EXPECT_EQ(GAT_NUMBER_ELEMENTS + 2u, saved->at(1).stored_as);
+
+  EXPECT_EQ("Hello World", readfile(m1.value()).value_or(""));
+  EXPECT_EQ("Hello World2", readfile(saved->at(0)).value_or(""));
+  EXPECT_EQ(two_blocks, readfile(saved->at(1)).value_or(""));
+}
+
+TEST_F(Type2TextTest, SaveFiles_EmptyFile) {
+  ASSERT_TRUE(CreateMsgTextFile());
+  auto saved = t_->savefiles({"Hello World"});
+  ASSERT_TRUE(saved.has_value());
+  ASSERT_EQ(1u, saved->size());
+  EXPECT_EQ(1u, saved->at(0).stored_as);
+  EXPECT_EQ("Hello World", readfile(saved->at(0)).value_or(""));
+}
+
+TEST_F(Type2TextTest, SaveFiles_NoSectionsLeft) {
+  // Mark a block used in the last allowed GAT section, leaving the rest of
+  // the (sparse) file empty.
+  File f(path_);
+  ASSERT_TRUE(f.Open(File::modeBinary | File::modeCreateFile | File::modeReadWrite));
+  const auto last_section_pos = static_cast<File::size_type>(GAT_MAX_SECTIONS - 1) * GATSECLEN;
+  std::vector<gati_t> gat(GAT_NUMBER_ELEMENTS);
+  gat[1] = static_cast<gati_t>(-1);
+  f.Seek(last_section_pos, File::Whence::begin);
+  ASSERT_EQ(GAT_SECTION_SIZE, f.Write(&gat[0], GAT_SECTION_SIZE));
+  f.Close();
+  const auto length = File(path_).length();
+
+  EXPECT_FALSE(t_->savefiles({"Hello World"}).has_value());
+  EXPECT_EQ(length, File(path_).length());
+}
@@ -20,6 +20,7 @@
 #include "core/datafile.h"
 #include "core/file.h"
 #include "core/log.h"
+#include "core/stl.h"
 #include "core/strings.h"
 #include "fmt/format.h"
 #include "sdk/config.h"
@@ -27,9 +28,12 @@
 #include "sdk/usermanager.h"
 #include "sdk/vardec.h"
 #include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <string>
 
 using namespace wwiv::core;
+using namespace wwiv::stl;
 using namespace wwiv::strings;
 
 namespace wwiv::sdk {
@@ -38,22 +42,29 @@ Names::Names(const wwiv::sdk::Config& config) : data_directory_(config.datadir()
   loaded_ = Load();
 }
 
-static smalrec smalrec_for(uint32_t user_number, const std::vector<smalrec>& names) {
-  for (const auto& n : names) {
-    if (n.number == user_number) {
-      return n;
-    }
+static const char* name_of(const smalrec& sr) {
+  return reinterpret_cast<const char*>(sr.name);
+}
+
+static void set_name(smalrec& sr, const std::string& name) {
+  strncpy(reinterpret_cast<char*>(sr.name), name.c_str(), sizeof(sr.name) - 1);
+}
+
+// NAMES.LST order: by name, then by user number for the same name.
+static bool name_less(const smalrec& a, const smalrec& b) {
+  const auto equal = strcmp(name_of(a), name_of(b));
+  if (equal == 0) {
+    return a.number < b.number;
   }
-  return smalrec{"", 0};
+  return equal < 0;
 }
 
 std::string Names::UserName(uint32_t user_number) const {
-  const auto sr = smalrec_for(user_number, names_);
-  if (sr.number == 0) {
+  const auto it = names_by_number_.find(user_number);
+  if (it == names_by_number_.end()) {
     return "";
   }
-  const auto name = properize(std::string(reinterpret_cast<const char*>(sr.name)));
-  return fmt::format("{} #{}", name, user_number);
+  return fmt::format("{} #{}", properize(it->second), user_number);
 }
 
 std::string Names::UserName(uint32_t user_number, uint32_t system_number) const {
@@ -65,44 +76,47 @@ std::string Names::UserName(uint32_t user_number, uint32_t system_number) const
 }
 
 bool Names::Add(const std::string& name, uint32_t user_number) {
-  const auto upper_case_name = ToStringUpperCase(name);
-  auto it = names_.begin();
-  for (; it != names_.end()
-         && StringCompare(upper_case_name.c_str(), reinterpret_cast<char*>((*it).name)) > 0;
-         ++it) {
-  }
   smalrec sr{};
-  strcpy(reinterpret_cast<char*>(sr.name), upper_case_name.c_str());
+  set_name(sr, ToStringUpperCase(name));
   sr.number = static_cast<uint16_t>(user_number);
+  const auto it = std::upper_bound(names_.begin(), names_.end(), sr, name_less);
+  const auto pos = static_cast<std::size_t>(std::distance(names_.begin(), it));
   names_.insert(it, sr);
+  IndexName(pos);
   return true;
 }
 
 bool Names::AddUnsorted(const std::string& name, uint32_t user_number) {
-  const auto upper_case_name = ToStringUpperCase(name);
   smalrec sr{};
-  strcpy(reinterpret_cast<char*>(sr.name), upper_case_name.c_str());
+  set_name(sr, ToStringUpperCase(name));
   sr.number = static_cast<uint16_t>(user_number);
   names_.emplace_back(sr);
   return true;
 }
 
 bool Names::Remove(uint32_t user_number) {
-  const std::string name(reinterpret_cast<char*>(smalrec_for(user_number, names_).name));
-  if (name.empty()) {
+  const auto nit = names_by_number_.find(user_number);
+  if (nit == names_by_number_.end()) {
     return false;
   }
-
-  const auto upper_case_name = ToStringUpperCase(name);
-  auto it = names_.cbegin();
-  for (; it != names_.cend()
-         && StringCompare(upper_case_name.c_str(), reinterpret_cast<const char*>((*it).name)) > 0;
-         ++it) {
-  }
-  if (!IsEquals(upper_case_name.c_str(), reinterpret_cast<const char*>((*it).name))) {
+  smalrec key{};
+  set_name(key, nit->second);
+  key.number = static_cast<uint16_t>(user_number);
+  const auto it = std::lower_bound(names_.begin(), names_.end(), key, name_less);
+  if (it == names_.end() || it->number != key.number || strcmp(name_of(*it), name_of(key)) != 0) {
     return false;
   }
   names_.erase(it);
+  names_by_number_.erase(nit);
+
+  // Point the name at whoever else is left using it, if anyone.
+  const auto folded = ToStringUpperCase(name_of(key));
+  numbers_.erase(folded);
+  key.number = 0;
+  if (const auto next = std::lower_bound(names_.begin(), names_.end(), key, name_less);
+      next != names_.end() && strcmp(name_of(*next), name_of(key)) == 0) {
+    numbers_.emplace(folded, next->number);
+  }
   return true;
 }
 
@@ -112,7 +126,9 @@ bool Names::Load() {
     return false;
   }
   names_.clear();
-  return file.ReadVector(names_);
+  const auto result = file.ReadVector(names_);
+  Reindex();
+  return result;
 }
 
 bool Names::Save() {
@@ -123,17 +139,7 @@ bool Names::Save() {
     LOG(ERROR) << "Error saving NAMES.LST";
     return false;
   }
-
-  std::sort(names_.begin(), names_.end(), [](const smalrec& a, const smalrec& b) -> bool {
-    const auto equal = strcmp((char*)a.name, (char*)b.name);
-    // Sort by user number if names match.
-    if (equal == 0) {
-      return a.number < b.number;
-    }
-    // Otherwise sort by name comparison.
-    return equal < 0;
-  });
-
+  Reindex();
   return file.WriteVector(names_);
 }
 
@@ -144,22 +150,59 @@ bool Names::Rebuild(const UserManager& um) {
   }
 
   names_.clear();
-  for (auto i = 1; i <= num_user_records; i++) {
-    if (const auto user = um.readuser(i, UserManager::mask::active)) {
-      AddUnsorted(user->name(), i);
-    }
-  }
+  um.for_each_user(
+      [this](const User& user) {
+        AddUnsorted(user.name(), user.usernum());
+        return true;
+      },
+      UserManager::mask::active);
+  Reindex();
   return true;
 }
 
+void Names::Reindex() {
+  if (!std::is_sorted(names_.begin(), names_.end(), name_less)) {
+    std::sort(names_.begin(), names_.end(), name_less);
+  }
+  numbers_.clear();
+  names_by_number_.clear();
+  numbers_.reserve(names_.size());
+  names_by_number_.reserve(names_.size());
+  for (std::size_t i = 0; i < names_.size(); i++) {
+    IndexName(i);
+  }
+}
+
+void Names::IndexName(std::size_t pos) {
+  const auto& sr = names_.at(pos);
+  // Since names_ is sorted, only the lowest number with a name comes first.
+  auto& number = numbers_[ToStringUpperCase(name_of(sr))];
+  if (number == 0 || sr.number < number) {
+    number = sr.number;
+  }
+  names_by_number_.emplace(sr.number, name_of(sr));
+}
+
+int Names::FindUser(const std::string& search_string) const {
+  const auto it = numbers_.find(ToStringUpperCase(search_string));
+  return it == numbers_.end() ? 0 : it->second;
+}
 
-int Names::FindUser(const std::string& search_string) {
-  for (const auto& n : names_) {
-    if (iequals(search_string.c_str(), reinterpret_cast<const char*>(n.name))) {
-      return n.number;
+std::vector<smalrec> Names::FindUsersWithPrefix(const std::string& prefix,
+                                                int max_results) const {
+  // Names are stored in upper case, so the matches are all next to each other.
+  const auto upper_prefix = ToStringUpperCase(prefix);
+  smalrec key{};
+  set_name(key, upper_prefix);
+  std::vector<smalrec> result;
+  for (auto it = std::lower_bound(names_.begin(), names_.end(), key, name_less);
+       it != names_.end() && starts_with(name_of(*it), upper_prefix); ++it) {
+    if (max_results > 0 && ssize(result) >= max_results) {
+      break;
     }
+    result.push_back(*it);
   }
-  return 0;
+  return result;
 }
 
 Names::~Names() {
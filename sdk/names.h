@@ -19,8 +19,10 @@
 #define INCLUDED_SDK_NAMES_H
 
 #include "sdk/config.h"
+#include <cstdint>
 #include <filesystem>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 struct smalrec;
@@ -28,6 +30,12 @@ struct smalrec;
 namespace wwiv::sdk {
 class UserManager;
 
+/**
+ * The names of all active users from NAMES.LST, kept sorted by name.
+ *
+ * Names are indexed by their upper case form and by user number so that
+ * looking up a user by either does not need to check every name.
+ */
 class Names final {
 public:
   explicit Names(const wwiv::sdk::Config& config);
@@ -40,7 +48,17 @@ public:
   bool Load();
   bool Save();
   bool Rebuild(const UserManager& um);
-  [[nodiscard]] int FindUser(const std::string& search_string);
+  /**
+   * Returns the number of the user named search_string, ignoring case, or 0
+   * if there is none. The lowest user number wins if the name is used twice.
+   */
+  [[nodiscard]] int FindUser(const std::string& search_string) const;
+  /**
+   * Returns the users whose names start with prefix, ignoring case, sorted
+   * by name. At most max_results are returned when it is greater than 0.
+   */
+  [[nodiscard]] std::vector<smalrec> FindUsersWithPrefix(const std::string& prefix,
+                                                         int max_results = 0) const;
 
   [[nodiscard]] const std::vector<smalrec>& names_vector() const { return names_;  }
   [[nodiscard]] int size() const { return static_cast<int>(names_.size()); }
@@ -53,11 +71,19 @@ private:
    * should only be used when adding many items, as Save will sort.
    */
   bool AddUnsorted(const std::string& name, uint32_t user_number);
+  /** Sorts names_ if needed and rebuilds the indexes from it. */
+  void Reindex();
+  /** Adds names_[pos] to the indexes, names_ must be sorted. */
+  void IndexName(std::size_t pos);
 
   const std::filesystem::path data_directory_;
   bool loaded_{false};
   bool save_on_exit_{false};
   std::vector<smalrec> names_;
+  // User number for each upper case name.
+  std::unordered_map<std::string, uint16_t> numbers_;
+  // Name for each user number.
+  std::unordered_map<uint32_t, std::string> names_by_number_;
 };
 
 
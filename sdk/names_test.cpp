@@ -104,6 +104,52 @@ TEST_F(NamesTest, Insert) {
   EXPECT_EQ(4, names_->size());
 }
 
+TEST_F(NamesTest, FindUser) {
+  EXPECT_EQ(3, names_->FindUser("A"));
+  EXPECT_EQ(2, names_->FindUser("b"));
+  EXPECT_EQ(0, names_->FindUser("D"));
+  EXPECT_EQ(0, names_->FindUser(""));
+}
+
+TEST_F(NamesTest, FindUser_AddAndRemove) {
+  EXPECT_TRUE(names_->Add("Bob Smith", 10));
+  EXPECT_EQ(10, names_->FindUser("BOB SMITH"));
+  EXPECT_EQ(10, names_->FindUser("bob smith"));
+
+  // The lowest user number wins when a name is used twice.
+  EXPECT_TRUE(names_->Add("Bob Smith", 4));
+  EXPECT_EQ(4, names_->FindUser("Bob Smith"));
+  EXPECT_TRUE(names_->Remove(4));
+  EXPECT_EQ(10, names_->FindUser("Bob Smith"));
+  EXPECT_TRUE(names_->Remove(10));
+  EXPECT_EQ(0, names_->FindUser("Bob Smith"));
+
+  // Still sorted by name.
+  std::vector<std::string> v;
+  for (const auto& n : names_->names_vector()) {
+    v.emplace_back(reinterpret_cast<const char*>(n.name));
+  }
+  EXPECT_EQ(v, (std::vector<std::string>{"A", "B", "C"}));
+}
+
+TEST_F(NamesTest, FindUsersWithPrefix) {
+  names_->Add("Bob", 10);
+  names_->Add("Bobby", 11);
+  names_->Add("Alice", 12);
+
+  auto found = names_->FindUsersWithPrefix("bo");
+  ASSERT_EQ(2u, found.size());
+  EXPECT_EQ(10, found.at(0).number);
+  EXPECT_EQ(11, found.at(1).number);
+
+  found = names_->FindUsersWithPrefix("B");
+  ASSERT_EQ(3u, found.size());
+  EXPECT_EQ(2, found.at(0).number);
+
+  EXPECT_EQ(1u, names_->FindUsersWithPrefix("B", 1).size());
+  EXPECT_TRUE(names_->FindUsersWithPrefix("X").empty());
+}
+
 TEST_F(NamesTest, SaveOnExit) {
   names_->set_save_on_exit(true);
   ASSERT_TRUE(names_->save_on_exit());
@@ -132,4 +178,6 @@ TEST(NamesRebuildTest, Rebuild) {
   ASSERT_EQ(2u, v.size());
   EXPECT_STREQ("BAR", (char*) v.at(0).name);
   EXPECT_STREQ("FOO", (char*) v.at(1).name);
+  EXPECT_EQ(1, names.FindUser("foo"));
+  EXPECT_EQ("Bar #2", names.UserName(2));
 }
\ No newline at end of file
@@ -28,6 +28,7 @@
 #include "sdk/filenames.h"
 #include <cstdint>
 #include <ctime>
+#include <iterator>
 #include <string>
 #include <utility>
 #include <vector>
@@ -39,15 +40,104 @@ using namespace wwiv::strings;
 
 namespace wwiv::sdk {
 
+void FtnDupeCrcSet::insert(uint32_t crc) {
+  if (crc == 0) {
+    return;
+  }
+  // Keep the load factor at or below 1/2 so probe runs stay short.
+  if ((size_ + 1) * 2 > ssize(slots_)) {
+    grow();
+  }
+  auto& slot = slots_[find(crc)];
+  if (slot.crc == 0) {
+    slot.crc = crc;
+    ++size_;
+  }
+  ++slot.count;
+}
+
+bool FtnDupeCrcSet::erase(uint32_t crc) {
+  if (crc == 0 || slots_.empty()) {
+    return false;
+  }
+  auto i = find(crc);
+  if (slots_[i].crc == 0) {
+    return false;
+  }
+  if (--slots_[i].count > 0) {
+    return true;
+  }
+  // Backward shift deletion, so no tombstones are needed.
+  const auto mask = slots_.size() - 1;
+  slots_[i] = {};
+  --size_;
+  for (auto j = (i + 1) & mask; slots_[j].crc != 0; j = (j + 1) & mask) {
+    const auto k = home(slots_[j].crc);
+    // Move the entry at j into the hole at i unless its home slot lies
+    // cyclically in (i, j].
+    const auto in_range = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+    if (!in_range) {
+      slots_[i] = slots_[j];
+      slots_[j] = {};
+      i = j;
+    }
+  }
+  return true;
+}
+
+bool FtnDupeCrcSet::contains(uint32_t crc) const {
+  if (crc == 0 || slots_.empty()) {
+    return false;
+  }
+  return slots_[find(crc)].crc == crc;
+}
+
+void FtnDupeCrcSet::clear() {
+  slots_.clear();
+  size_ = 0;
+}
+
+std::size_t FtnDupeCrcSet::home(uint32_t crc) const noexcept {
+  // Fibonacci hashing, the crc32 is already well mixed but this keeps
+  // similar values from clustering.
+  return static_cast<std::size_t>(crc * 2654435769u) & (slots_.size() - 1);
+}
+
+std::size_t FtnDupeCrcSet::find(uint32_t crc) const noexcept {
+  const auto mask = slots_.size() - 1;
+  auto i = home(crc);
+  while (slots_[i].crc != 0 && slots_[i].crc != crc) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+void FtnDupeCrcSet::grow() {
+  auto old = std::move(slots_);
+  slots_.assign(old.empty() ? 1024 : old.size() * 2, slot_t{});
+  for (const auto& s : old) {
+    if (s.crc != 0) {
+      slots_[find(s.crc)] = s;
+    }
+  }
+}
+
 FtnMessageDupe::FtnMessageDupe(const Config& config) : FtnMessageDupe(config.datadir(), true) {}
 
-FtnMessageDupe::FtnMessageDupe(const std::filesystem::path& datadir, bool use_filesystem)
-    : datadir_(datadir), use_filesystem_(use_filesystem) {
+FtnMessageDupe::FtnMessageDupe(const std::filesystem::path& datadir, bool use_filesystem,
+                               int max_dupes)
+    : datadir_(datadir), use_filesystem_(use_filesystem), max_dupes_(max_dupes) {
   if (!datadir_.empty()) {
     initialized_ = Load();
   }
 }
 
+FtnMessageDupe::~FtnMessageDupe() {
+  if (!pending_.empty() && !Flush()) {
+    LOG(ERROR) << "Unable to write " << pending_.size() << " pending records to: " << MSGDUPE_DAT;
+  }
+}
+
 bool FtnMessageDupe::Load() {
   if (!use_filesystem_) {
     return true;
@@ -68,24 +158,72 @@ bool FtnMessageDupe::Load() {
     LOG(ERROR) << "Unable to initialize FtnMessageDupe: Read Failed";
     return false;
   }
+  file.Close();
+  if (ssize(dupes_) > max_dupes_ + max_dupes_ / 4) {
+    // Compact also rebuilds the hash sets.
+    return Compact();
+  }
   for (const auto& d : dupes_) {
-    header_dupes_.insert(d.header);
-    msgid_dupes_.insert(d.msgid);
+    insert_crcs(d);
   }
   return true;
 }
 
-bool FtnMessageDupe::Save() {
-  if (!use_filesystem_) {
+bool FtnMessageDupe::Append(const std::vector<msgids>& ids) {
+  if (!use_filesystem_ || ids.empty()) {
     return true;
   }
-  DataFile<msgids> file(FilePath(datadir_, MSGDUPE_DAT),
-                        File::modeReadWrite | File::modeBinary | File::modeCreateFile |
-                            File::modeTruncate);
+  DataFile<msgids> file(FilePath(datadir_, MSGDUPE_DAT), File::modeReadWrite | File::modeBinary |
+                                                             File::modeCreateFile |
+                                                             File::modeAppend);
   if (!file) {
     return false;
   }
-  return file.WriteVector(dupes_);
+  return file.WriteVector(ids);
+}
+
+bool FtnMessageDupe::Compact() {
+  if (const auto excess = ssize(dupes_) - max_dupes_; excess > 0) {
+    dupes_.erase(dupes_.begin(), dupes_.begin() + excess);
+  }
+  header_dupes_.clear();
+  msgid_dupes_.clear();
+  for (const auto& d : dupes_) {
+    insert_crcs(d);
+  }
+  if (!use_filesystem_) {
+    pending_.clear();
+    return true;
+  }
+  // Write to a temp file and rename it so a crash while compacting can't
+  // lose the existing dupe database.
+  const auto path = FilePath(datadir_, MSGDUPE_DAT);
+  auto tmp = path;
+  tmp += ".tmp";
+  {
+    DataFile<msgids> file(tmp, File::modeReadWrite | File::modeBinary | File::modeCreateFile |
+                                   File::modeTruncate);
+    if (!file || !file.WriteVector(dupes_)) {
+      LOG(ERROR) << "Unable to write: " << tmp;
+      return false;
+    }
+  }
+  if (!File::Rename(tmp, path)) {
+    return false;
+  }
+  // Compacting writes everything in dupes_, which includes anything pending.
+  pending_.clear();
+  return true;
+}
+
+void FtnMessageDupe::insert_crcs(const msgids& ids) {
+  header_dupes_.insert(ids.header);
+  msgid_dupes_.insert(ids.msgid);
+}
+
+void FtnMessageDupe::erase_crcs(const msgids& ids) {
+  header_dupes_.erase(ids.header);
+  msgid_dupes_.erase(ids.msgid);
 }
 
 std::string FtnMessageDupe::CreateMessageID(const wwiv::sdk::fido::FidoAddress& a) {
@@ -191,43 +329,58 @@ bool FtnMessageDupe::add(const FidoPackedMessage& msg) {
 }
 
 bool FtnMessageDupe::add(uint32_t header_crc32, uint32_t msgid_crc32) {
-  if (header_crc32 != 0) {
-    header_dupes_.insert(header_crc32);
-  }
-  if (msgid_crc32 != 0) {
-    msgid_dupes_.insert(msgid_crc32);
-  }
-
   msgids ids{};
   ids.header = header_crc32;
   ids.msgid = msgid_crc32;
 
+  insert_crcs(ids);
   dupes_.emplace_back(ids);
-  return Save();
+  pending_.emplace_back(ids);
+  if (batch_) {
+    return true;
+  }
+  return Flush();
+}
+
+bool FtnMessageDupe::Flush() {
+  batch_ = false;
+  if (ssize(dupes_) > max_dupes_ + max_dupes_ / 4) {
+    return Compact();
+  }
+  if (!Append(pending_)) {
+    // Keep the records pending so that the next Flush writes them.
+    LOG(ERROR) << "Unable to append " << pending_.size() << " records to: " << MSGDUPE_DAT;
+    return false;
+  }
+  pending_.clear();
+  return true;
+}
+
+void FtnMessageDupe::Rollback() {
+  batch_ = false;
+  for (const auto& p : pending_) {
+    erase_crcs(p);
+  }
+  // pending_ is always the tail of dupes_
+  dupes_.resize(dupes_.size() - std::min(dupes_.size(), pending_.size()));
+  pending_.clear();
 }
 
 bool FtnMessageDupe::remove(uint32_t header_crc32, uint32_t msgid_crc32) {
-  for (auto it = dupes_.begin(); it != std::end(dupes_);) {
-    const auto& d = *it;
-    if (d.header == header_crc32 && d.msgid == msgid_crc32) {
-      dupes_.erase(it);
-      header_dupes_.erase(header_crc32);
-      msgid_dupes_.erase(msgid_crc32);
-      return Save();
+  // Search newest first, since a removed message is most likely a recent one.
+  for (auto it = dupes_.rbegin(); it != dupes_.rend(); ++it) {
+    if (it->header == header_crc32 && it->msgid == msgid_crc32) {
+      erase_crcs(*it);
+      dupes_.erase(std::next(it).base());
+      return Compact();
     }
-    ++it;
   }
   return false;
 }
 
 bool FtnMessageDupe::is_dupe(uint32_t header_crc32, uint32_t msgid_crc32) const {
-  if (contains(header_dupes_, header_crc32) && header_crc32 != 0) {
-    return true;
-  }
-  if (contains(msgid_dupes_, msgid_crc32) && msgid_crc32 != 0) {
-    return true;
-  }
-  return false;
+  // The sets never contain 0, so an empty MSGID never matches.
+  return header_dupes_.contains(header_crc32) || msgid_dupes_.contains(msgid_crc32);
 }
 
 bool FtnMessageDupe::is_dupe(const FidoPackedMessage& msg) const {
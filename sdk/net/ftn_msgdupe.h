@@ -18,9 +18,9 @@
 #ifndef INCLUDED_SDK_FTN_MSGDUPE_H
 #define INCLUDED_SDK_FTN_MSGDUPE_H
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
-#include <set>
 #include <vector>
 #include "sdk/config.h"
 #include "sdk/fido/fido_address.h"
@@ -38,16 +38,71 @@ namespace wwiv::sdk {
 static_assert(std::is_trivial<msgids>::value == true);
 static_assert(sizeof(msgids) == sizeof(uint64_t), "sizeof(msgids) must be the same as an int64.");
 
+/**
+ * Hash set of non-zero CRC32 values using open addressing (linear probing).
+ *
+ * Each value also has a count of how many times it was inserted, so erasing
+ * one copy of a value that was inserted twice keeps it in the set.
+ */
+class FtnDupeCrcSet final {
+public:
+  void insert(uint32_t crc);
+  /** Removes one copy of crc, returns true if it was found. */
+  bool erase(uint32_t crc);
+  [[nodiscard]] bool contains(uint32_t crc) const;
+  [[nodiscard]] int size() const noexcept { return size_; }
+  void clear();
+
+private:
+  struct slot_t {
+    uint32_t crc;
+    uint32_t count;
+  };
+  [[nodiscard]] std::size_t home(uint32_t crc) const noexcept;
+  /** Returns the slot holding crc or the empty slot where it belongs. */
+  [[nodiscard]] std::size_t find(uint32_t crc) const noexcept;
+  void grow();
+
+  // Always empty or a power of two in size. A crc of 0 marks an empty slot.
+  std::vector<slot_t> slots_;
+  int size_{0};
+};
+
+/**
+ * Duplicate checker for FTN messages, backed by MSGDUPE_DAT.
+ *
+ * MSGDUPE_DAT is an append only log of msgids records. Adding a message
+ * appends a single record (or a batch of them, see BeginBatch), and the
+ * file is only rewritten (compacted) to
+ * drop the oldest records once it grows more than 25% past max_dupes,
+ * or when a record is removed.
+ */
 class FtnMessageDupe final {
 public:
+  static constexpr int kDefaultMaxDupes = 100000;
+
   explicit FtnMessageDupe(const Config& config);
-  FtnMessageDupe(const std::filesystem::path& datadir, bool use_filesystem);
-  ~FtnMessageDupe() = default;
+  FtnMessageDupe(const std::filesystem::path& datadir, bool use_filesystem,
+                 int max_dupes = kDefaultMaxDupes);
+  /** Flushes any records still pending from a batch. */
+  ~FtnMessageDupe();
 
   [[nodiscard]] bool IsInitialized() const { return initialized_; }
   [[nodiscard]] std::string CreateMessageID(const fido::FidoAddress& a);
   bool add(const fido::FidoPackedMessage& msg);
   bool add(uint32_t header_crc32, uint32_t msgid_crc32);
+  /**
+   * Starts a batch: records added after this are checked by is_dupe right
+   * away, but are only written to MSGDUPE_DAT by the next call to Flush.
+   */
+  void BeginBatch() { batch_ = true; }
+  /**
+   * Writes any pending records to MSGDUPE_DAT and ends the batch. On failure
+   * the records stay pending, so a later Flush can write them.
+   */
+  bool Flush();
+  /** Forgets any records added since BeginBatch and ends the batch. */
+  void Rollback();
   bool remove(uint32_t header_crc32, uint32_t msgid_crc32);
   /** returns true if either the header or msgid crc is duplicated */
   [[nodiscard]] bool is_dupe(uint32_t header_crc32, uint32_t msgid_crc32) const;
@@ -64,16 +119,29 @@ public:
    */
   [[nodiscard]] static std::string GetMessageIDFromWWIVText(const std::string& text);
 
+  /** Number of records in the dupe window. */
+  [[nodiscard]] int size() const noexcept { return static_cast<int>(dupes_.size()); }
+
 private:
   bool Load();
-  bool Save();
+  /** Appends records to the end of MSGDUPE_DAT */
+  bool Append(const std::vector<msgids>& ids);
+  /** Drops the oldest records past max_dupes_ and rewrites MSGDUPE_DAT */
+  bool Compact();
+  void insert_crcs(const msgids& ids);
+  void erase_crcs(const msgids& ids);
 
   bool initialized_{ false };
   const std::filesystem::path datadir_;
+  // Oldest first.
   std::vector<msgids> dupes_;
-  std::set<uint32_t> msgid_dupes_;
-  std::set<uint32_t> header_dupes_;
+  FtnDupeCrcSet msgid_dupes_;
+  FtnDupeCrcSet header_dupes_;
   bool use_filesystem_{true};
+  const int max_dupes_;
+  // Records added but not yet written, see BeginBatch.
+  std::vector<msgids> pending_;
+  bool batch_{false};
 };
 
 }
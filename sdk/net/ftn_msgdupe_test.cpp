@@ -132,4 +132,107 @@ TEST_F(FtnMsgDupeTest, Remove) {
   EXPECT_TRUE(dupe.is_dupe(1, 2));
   dupe.remove(1, 2);
   EXPECT_FALSE(dupe.is_dupe(1, 2));
-}
\ No newline at end of file
+}
+
+TEST_F(FtnMsgDupeTest, Remove_AddedTwice) {
+  FtnMessageDupe dupe(helper.datadir(), false);
+  dupe.add(1, 2);
+  dupe.add(1, 3);
+  dupe.remove(1, 2);
+  EXPECT_TRUE(dupe.is_dupe(1, 0));
+  EXPECT_FALSE(dupe.is_dupe(0, 2));
+  EXPECT_TRUE(dupe.is_dupe(0, 3));
+}
+
+TEST_F(FtnMsgDupeTest, ZeroIsNeverDupe) {
+  FtnMessageDupe dupe(helper.datadir(), false);
+  dupe.add(1, 0);
+  EXPECT_FALSE(dupe.is_dupe(0, 0));
+  EXPECT_TRUE(dupe.is_dupe(1, 0));
+}
+
+TEST_F(FtnMsgDupeTest, Append_Persists) {
+  {
+    FtnMessageDupe dupe(helper.datadir(), true);
+    dupe.add(1, 2);
+    dupe.add(3, 4);
+  }
+  DataFile<msgids> file(FilePath(helper.datadir(), MSGDUPE_DAT),
+                        File::modeReadOnly | File::modeBinary);
+  ASSERT_TRUE(file);
+  EXPECT_EQ(2, file.number_of_records());
+  file.Close();
+
+  const FtnMessageDupe dupe(helper.datadir(), true);
+  EXPECT_TRUE(dupe.is_dupe(1, 2));
+  EXPECT_TRUE(dupe.is_dupe(3, 4));
+  EXPECT_FALSE(dupe.is_dupe(5, 6));
+}
+
+TEST_F(FtnMsgDupeTest, Compact_DropsOldest) {
+  constexpr int max_dupes = 8;
+  {
+    FtnMessageDupe dupe(helper.datadir(), true, max_dupes);
+    for (uint32_t i = 1; i <= 11; i++) {
+      dupe.add(i, i + 100);
+    }
+    // 11 > 8 + 8/4, so the oldest 3 were dropped.
+    EXPECT_EQ(max_dupes, dupe.size());
+    EXPECT_FALSE(dupe.is_dupe(3, 103));
+    EXPECT_TRUE(dupe.is_dupe(4, 104));
+  }
+
+  const FtnMessageDupe dupe(helper.datadir(), true, max_dupes);
+  EXPECT_EQ(max_dupes, dupe.size());
+  EXPECT_FALSE(dupe.is_dupe(1, 101));
+  EXPECT_TRUE(dupe.is_dupe(11, 111));
+}
+
+TEST_F(FtnMsgDupeTest, Batch_Flush) {
+  {
+    FtnMessageDupe dupe(helper.datadir(), true);
+    dupe.BeginBatch();
+    dupe.add(1, 2);
+    dupe.add(3, 4);
+    EXPECT_TRUE(dupe.is_dupe(3, 4));
+    EXPECT_EQ(0, File(FilePath(helper.datadir(), MSGDUPE_DAT)).length());
+    EXPECT_TRUE(dupe.Flush());
+    EXPECT_EQ(2 * static_cast<int>(sizeof(msgids)),
+              File(FilePath(helper.datadir(), MSGDUPE_DAT)).length());
+  }
+  const FtnMessageDupe dupe(helper.datadir(), true);
+  EXPECT_TRUE(dupe.is_dupe(1, 2));
+  EXPECT_TRUE(dupe.is_dupe(3, 4));
+}
+
+TEST_F(FtnMsgDupeTest, Batch_Rollback) {
+  {
+    FtnMessageDupe dupe(helper.datadir(), true);
+    dupe.add(1, 2);
+    dupe.BeginBatch();
+    dupe.add(3, 4);
+    dupe.Rollback();
+    EXPECT_TRUE(dupe.is_dupe(1, 2));
+    EXPECT_FALSE(dupe.is_dupe(3, 4));
+    EXPECT_EQ(1, dupe.size());
+  }
+  const FtnMessageDupe dupe(helper.datadir(), true);
+  EXPECT_TRUE(dupe.is_dupe(1, 2));
+  EXPECT_FALSE(dupe.is_dupe(3, 4));
+}
+
+TEST_F(FtnMsgDupeTest, Batch_FlushFailureKeepsPending) {
+  const auto path = FilePath(helper.datadir(), MSGDUPE_DAT);
+  FtnMessageDupe dupe(helper.datadir(), true);
+  dupe.BeginBatch();
+  dupe.add(1, 2);
+  // Make MSGDUPE_DAT impossible to open.
+  ASSERT_TRUE(File::Remove(path));
+  ASSERT_TRUE(File::mkdir(path));
+  EXPECT_FALSE(dupe.Flush());
+  EXPECT_TRUE(dupe.is_dupe(1, 2));
+
+  ASSERT_TRUE(File::Remove(path));
+  EXPECT_TRUE(dupe.Flush());
+  EXPECT_EQ(static_cast<int>(sizeof(msgids)), File(path).length());
+}
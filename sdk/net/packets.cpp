@@ -27,6 +27,9 @@
 #include "sdk/filenames.h"
 #include "sdk/subxtr.h"
 #include "sdk/net/subscribers.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <utility>
 
@@ -169,6 +172,102 @@ bool write_wwivnet_packet(const std::filesystem::path& path, const NetPacket& p)
   return true;
 }
 
+// Appends packet to buf as it is stored in a WWIVnet file, returns false if it is malformed.
+static bool append_packet(std::string& buf, const NetPacket& p, const std::filesystem::path& path) {
+  if (p.nh.length != p.text().size()) {
+    LOG(ERROR) << "Error while writing NetPacket: " << path.string();
+    LOG(ERROR) << "Mismatched text and p.nh.length.  text =" << p.text().size()
+               << " nh.length = " << p.nh.length;
+    return false;
+  }
+  if (p.nh.list_len != p.list.size()) {
+    LOG(ERROR) << "p.nh.list_len [" << p.nh.list_len << "] != p.list.size() [" << p.list.size()
+               << "]";
+    return false;
+  }
+  buf.append(reinterpret_cast<const char*>(&p.nh), sizeof(net_header_rec));
+  if (p.nh.list_len) {
+    buf.append(reinterpret_cast<const char*>(&p.list[0]), sizeof(uint16_t) * p.nh.list_len);
+  }
+  buf.append(p.text());
+  return true;
+}
+
+// Appends buf to the end of the file path with a single write. If only part
+// of buf is written, the file is cut back to where it was so that writing it
+// again does not leave a partial packet in the file.
+static bool append_to_file(const std::filesystem::path& path, const std::string& buf) {
+  File file(path);
+  if (!file.Open(File::modeReadWrite | File::modeBinary | File::modeCreateFile)) {
+    LOG(ERROR) << "Error while writing NetPacket: " << path.string() << "Unable to open file.";
+    return false;
+  }
+  const auto length = file.Seek(0L, File::Whence::end);
+  if (const auto num = file.Write(buf); num != ssize(buf)) {
+    LOG(ERROR) << "Error while writing NetPackets: " << path.string() << " num written (" << num
+               << ") != " << buf.size();
+    if (num > 0 && length >= 0) {
+      file.set_length(length);
+    }
+    return false;
+  }
+  return true;
+}
+
+bool write_wwivnet_packets(const std::filesystem::path& path, const std::vector<NetPacket>& packets) {
+  if (packets.empty()) {
+    return true;
+  }
+  VLOG(2) << "write_wwivnet_packets: " << path.string() << "; num: " << packets.size();
+  std::string buf;
+  for (const auto& p : packets) {
+    if (!append_packet(buf, p, path)) {
+      return false;
+    }
+  }
+  return append_to_file(path, buf);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// NetPacketWriter
+
+NetPacketWriter::NetPacketWriter(std::size_t max_buffered) : max_buffered_(max_buffered) {}
+
+NetPacketWriter::~NetPacketWriter() { Flush(); }
+
+bool NetPacketWriter::Write(const std::filesystem::path& path, const NetPacket& packet) {
+  VLOG(1) << "NetPacketWriter: Writing type " << packet.nh.main_type << "/" << packet.nh.minor_type
+          << " message to NetPacket: " << path.string();
+  auto& buf = files_[path];
+  const auto size = buf.size();
+  if (!append_packet(buf, packet, path)) {
+    return false;
+  }
+  buffered_ += buf.size() - size;
+  if (buffered_ >= max_buffered_) {
+    // Anything not written stays buffered, and is counted in write_errors_.
+    Flush();
+  }
+  return true;
+}
+
+bool NetPacketWriter::Flush() {
+  auto result = true;
+  for (auto it = std::begin(files_); it != std::end(files_);) {
+    const auto& [path, buf] = *it;
+    VLOG(2) << "NetPacketWriter: " << path.string() << "; bytes: " << buf.size();
+    if (!append_to_file(path, buf)) {
+      ++write_errors_;
+      result = false;
+      ++it;
+      continue;
+    }
+    buffered_ -= buf.size();
+    it = files_.erase(it);
+  }
+  return result;
+}
+
 static std::string NetInfoFileName(uint16_t type) {
   switch (type) {
   case net_info_bbslist:
@@ -392,6 +491,106 @@ NetMailFile::iterator::iterator(NetMailFile& f, ReadNetPacketResponse response)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// NetPacketView
+
+std::vector<uint16_t> NetPacketView::list() const {
+  // Like read_packet, a short list is padded with zeros.
+  std::vector<uint16_t> l(nh.list_len);
+  if (!l.empty()) {
+    memcpy(l.data(), list_data.data(), std::min(list_data.size(), l.size() * sizeof(uint16_t)));
+  }
+  return l;
+}
+
+NetPacket NetPacketView::ToNetPacket() const {
+  NetPacket packet{};
+  packet.set_source(NetPacketSource::DISK);
+  packet.set_offset(offset);
+  packet.nh = nh;
+  packet.list = list();
+  if (nh.length != 0) {
+    packet.set_text(std::string(text));
+  }
+  packet.set_end_offset(end_offset);
+  return packet;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// NetMailFileView
+
+NetMailFileView::NetMailFileView(const std::filesystem::path& path, bool process_de)
+    : file_(path), process_de_(process_de) {
+  if (!file_.Open(File::modeBinary | File::modeReadOnly)) {
+    LOG(ERROR) << "Unable to open file: " << path.string() << "; error: " << file_.last_error();
+    return;
+  }
+  mapping_ = FileMapping(file_);
+}
+
+void NetMailFileView::Close() noexcept {
+  mapping_ = FileMapping();
+  file_.Close();
+}
+
+NetMailFileView::iterator NetMailFileView::begin() {
+  pos_ = 0;
+  iterator it(*this, ReadNetPacketResponse::NOT_OPENED);
+  return ++it;
+}
+
+ReadNetPacketResponse NetMailFileView::Read(NetPacketView& packet) {
+  last_read_response_ = [&] {
+    if (!mapping_) {
+      return ReadNetPacketResponse::NOT_OPENED;
+    }
+    std::string_view data(mapping_.data(), mapping_.size());
+    data.remove_prefix(pos_);
+    if (data.empty()) {
+      // at the end of the NetPacket.
+      return ReadNetPacketResponse::END_OF_FILE;
+    }
+    if (data.size() < sizeof(net_header_rec)) {
+      LOG(INFO) << "error reading header, got short read of size: " << data.size()
+                << "; expected: " << sizeof(net_header_rec);
+      pos_ = mapping_.size();
+      return ReadNetPacketResponse::ERROR;
+    }
+
+    NetPacketView p{};
+    p.offset = pos_;
+    memcpy(&p.nh, data.data(), sizeof(net_header_rec));
+    data.remove_prefix(sizeof(net_header_rec));
+    if (p.nh.method > 0) {
+      LOG(INFO) << "compression: de" << p.nh.method;
+    }
+    p.list_data = data.substr(0, sizeof(uint16_t) * p.nh.list_len);
+    data.remove_prefix(p.list_data.size());
+
+    if (p.nh.length != 0) {
+      if (p.nh.length > static_cast<uint32_t>(std::numeric_limits<int32_t>::max())) {
+        LOG(INFO) << "error reading header, got length too big (underflow?): " << p.nh.length;
+        pos_ = mapping_.size();
+        return ReadNetPacketResponse::ERROR;
+      }
+      if (p.nh.method == 1 && process_de_ &&
+          p.nh.length > 146 /* Make sure we have enough for a header */) {
+        // HACK - this should do this in a shim DE 146 is the sizeof EN/DE header for de1.
+        p.nh.length -= 146;
+        data.remove_prefix(std::min<std::size_t>(146, data.size()));
+      }
+      p.text = data.substr(0, p.nh.length);
+      data.remove_prefix(p.text.size());
+    }
+    pos_ = mapping_.size() - static_cast<File::size_type>(data.size());
+    p.end_offset = pos_;
+    packet = p;
+    return ReadNetPacketResponse::OK;
+  }();
+  return last_read_response_;
+}
+
+
 uint16_t get_forsys(const wwiv::sdk::BbsListNet& b, uint16_t node) {
   VLOG(2) << "get_forsys (forward to systen number) for node: " << node;
 
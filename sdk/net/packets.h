@@ -23,8 +23,10 @@
 #include "sdk/msgapi/message.h"
 #include "sdk/net/net.h"
 #include <filesystem>
+#include <map>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace wwiv::sdk {
@@ -243,6 +245,100 @@ private:
 };
 
 
+/**
+ * A packet in a NetMailFileView.
+ *
+ * The routing list and text point into the mapped WWIVnet mail file, so a
+ * view is only valid while the NetMailFileView that returned it is open. Use
+ * ToNetPacket to get a copy that can be changed or kept.
+ */
+struct NetPacketView {
+  net_header_rec nh{};
+  // Routing list as stored in the file, nh.list_len uint16_t values.
+  std::string_view list_data;
+  std::string_view text;
+  // Offsets of the start and end of the packet in the file.
+  wwiv::core::File::size_type offset{-1};
+  wwiv::core::File::size_type end_offset{-1};
+
+  /** Returns a copy of the routing list */
+  [[nodiscard]] std::vector<uint16_t> list() const;
+  /** Returns a copy of this packet, as read_packet would have returned it. */
+  [[nodiscard]] NetPacket ToNetPacket() const;
+};
+
+/**
+ * Read only view of a WWIVnet mail file. The whole file is memory mapped
+ * (see core::FileMapping) and each packet is returned as a NetPacketView,
+ * so nothing is copied or read a packet at a time.
+ *
+ * Use NetMailFile when packets need to be deleted from the file.
+ *
+ * // Example:
+ * NetMailFileView packets(path, true);
+ * if (!packets) {
+ *   return error;
+ * }
+ * for (const auto& packet : packets) {
+ *   process_wwivnet_packet(packet.ToNetPacket());
+ * }
+ */
+class NetMailFileView final {
+public:
+  class iterator {
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = NetPacketView;
+    using pointer = const NetPacketView*;
+    using reference = const NetPacketView&;
+    using iterator_category = std::input_iterator_tag;
+
+    iterator(NetMailFileView& f, ReadNetPacketResponse response) : f_(f), response_(response) {}
+    iterator& operator++() {
+      response_ = f_.Read(packet_);
+      return *this;
+    }
+    [[nodiscard]] bool operator==(const iterator& other) const noexcept {
+      return at_end() == other.at_end();
+    }
+    bool operator!=(const iterator& other) const noexcept { return !(*this == other); }
+    [[nodiscard]] reference operator*() const noexcept { return packet_; }
+    [[nodiscard]] pointer operator->() const noexcept { return &packet_; }
+
+  private:
+    [[nodiscard]] bool at_end() const noexcept { return response_ != ReadNetPacketResponse::OK; }
+
+    NetMailFileView& f_;
+    NetPacketView packet_;
+    ReadNetPacketResponse response_;
+  };
+
+  NetMailFileView(const std::filesystem::path& path, bool process_de);
+
+  /** Unmaps and closes the file, all views returned are no longer valid. */
+  void Close() noexcept;
+
+  /** Starts reading at the first packet in the file. */
+  [[nodiscard]] iterator begin();
+  [[nodiscard]] iterator end() { return iterator(*this, ReadNetPacketResponse::END_OF_FILE); }
+
+  explicit operator bool() const noexcept { return static_cast<bool>(mapping_); }
+  // Response from the last operation reading from the WWIVnet mail file.
+  [[nodiscard]] ReadNetPacketResponse last_read_response() const noexcept {
+    return last_read_response_;
+  }
+
+  /** Reads the next packet into packet, which is only set when this returns OK */
+  ReadNetPacketResponse Read(NetPacketView& packet);
+
+private:
+  wwiv::core::File file_;
+  wwiv::core::FileMapping mapping_;
+  bool process_de_{false};
+  wwiv::core::File::size_type pos_{0};
+  ReadNetPacketResponse last_read_response_{ReadNetPacketResponse::NOT_OPENED};
+};
+
 /**
  * Gets the next message field from a NetPacket text c with iterator iter.
  * The next message field will be the next set of characters that do not include
@@ -290,6 +386,48 @@ bool delete_packet(wwiv::core::File& f, NetPacket& packet);
  */
 bool write_wwivnet_packet(const std::filesystem::path& path, const NetPacket& packet);
 
+/**
+ * Apends all of packets to a wwivnet file specified by path, opening the
+ * file once and writing all of the packets with a single write.
+ */
+bool write_wwivnet_packets(const std::filesystem::path& path, const std::vector<NetPacket>& packets);
+
+/**
+ * Buffers packets being appended to WWIVnet files, and appends everything
+ * buffered for each file with a single open and write when Flush is called,
+ * when more than max_buffered bytes are buffered, or when destroyed.
+ *
+ * Packets are written to each file in the order they were given. Callers
+ * should Flush before removing the files the packets came from, so nothing
+ * is lost if the process stops before then. Anything that could not be
+ * written stays buffered and is tried again on the next Flush.
+ */
+class NetPacketWriter final {
+public:
+  explicit NetPacketWriter(std::size_t max_buffered = 1024 * 1024);
+  NetPacketWriter(const NetPacketWriter&) = delete;
+  NetPacketWriter& operator=(const NetPacketWriter&) = delete;
+  ~NetPacketWriter();
+
+  /** Appends packet to the WWIVnet file path, returns false if it is malformed. */
+  bool Write(const std::filesystem::path& path, const NetPacket& packet);
+  /** Writes all of the buffered packets, returns false if any file could not be written. */
+  bool Flush();
+  /** Number of bytes buffered */
+  [[nodiscard]] std::size_t buffered() const noexcept { return buffered_; }
+  /**
+   * Number of times a file could not be written, including by the flushes
+   * Write does when too much is buffered.
+   */
+  [[nodiscard]] int write_errors() const noexcept { return write_errors_; }
+
+private:
+  const std::size_t max_buffered_;
+  std::map<std::filesystem::path, std::string> files_;
+  std::size_t buffered_{0};
+  int write_errors_{0};
+};
+
 /**
  * Apends packet to a wwivnet DEAD.NET file located in the dir directory.
  */
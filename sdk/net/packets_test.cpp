@@ -216,3 +216,166 @@ TEST_F(PacketsTest, PacketFileReader_Smoke) {
   const auto num = std::count_if(iter2, end, [](NetPacket) { return true; });
   EXPECT_EQ(3, num);
 }
+
+TEST_F(PacketsTest, WriteWWIVNetPackets) {
+  const auto net = sdk_helper_.CreateTestNetwork(wwiv::sdk::net::network_type_t::wwivnet);
+  const auto path = FilePath(net.dir, LOCAL_NET);
+  ASSERT_TRUE(
+      write_wwivnet_packet(path, CreatePacket("MYSUB", "Title1", "Sysop #1", "Hello World")));
+  std::vector<NetPacket> packets;
+  packets.push_back(CreatePacket("MYSUB", "Title2", "Sysop #1", "Hello World"));
+  packets.push_back(CreatePacket("MYSUB", "Title3", "Sysop #1", "Hello World"));
+  ASSERT_TRUE(write_wwivnet_packets(path, packets));
+
+  NetMailFile reader(path, false);
+  std::vector<std::string> titles;
+  for (const auto& p : reader) {
+    titles.push_back(ParsedNetPacketText::FromNetPacket(p).title());
+  }
+  EXPECT_EQ(titles, (std::vector<std::string>{"Title1", "Title2", "Title3"}));
+}
+
+TEST_F(PacketsTest, NetMailFileView) {
+  const auto net = sdk_helper_.CreateTestNetwork(wwiv::sdk::net::network_type_t::wwivnet);
+  const auto path = FilePath(net.dir, LOCAL_NET);
+  std::vector<NetPacket> packets;
+  packets.push_back(CreatePacket("MYSUB", "Title1", "Sysop #1", "Hello World"));
+  packets.push_back(CreatePacket("MYSUB", "Title2", "Sysop #1", "Hello World"));
+  auto multi = CreatePacket("MYSUB", "Title3", "Sysop #1", "Hello World");
+  multi.nh.tosys = 0;
+  multi.list = {3, 4};
+  multi.update_header();
+  packets.push_back(multi);
+  ASSERT_TRUE(write_wwivnet_packets(path, packets));
+
+  std::vector<NetPacket> viewed;
+  {
+    NetMailFileView view(path, false);
+    ASSERT_TRUE(view);
+    for (const auto& p : view) {
+      viewed.push_back(p.ToNetPacket());
+    }
+    EXPECT_EQ(ReadNetPacketResponse::END_OF_FILE, view.last_read_response());
+  }
+
+  NetMailFile reader(path, false);
+  std::vector<NetPacket> read;
+  for (const auto& p : reader) {
+    read.push_back(p);
+  }
+
+  ASSERT_EQ(3u, viewed.size());
+  ASSERT_EQ(read.size(), viewed.size());
+  for (auto i = 0u; i < read.size(); i++) {
+    EXPECT_EQ(read[i].text(), viewed[i].text());
+    EXPECT_EQ(read[i].list, viewed[i].list);
+    EXPECT_EQ(read[i].nh.length, viewed[i].nh.length);
+    EXPECT_EQ(read[i].offset(), viewed[i].offset());
+    EXPECT_EQ(read[i].end_offset(), viewed[i].end_offset());
+  }
+  EXPECT_EQ(ParsedNetPacketText::FromNetPacket(viewed.at(2)).title(), "Title3");
+  EXPECT_EQ(viewed.at(2).list, (std::vector<uint16_t>{3, 4}));
+}
+
+TEST_F(PacketsTest, NetMailFileView_Truncated) {
+  const auto net = sdk_helper_.CreateTestNetwork(wwiv::sdk::net::network_type_t::wwivnet);
+  const auto path = FilePath(net.dir, LOCAL_NET);
+  ASSERT_TRUE(
+      write_wwivnet_packet(path, CreatePacket("MYSUB", "Title1", "Sysop #1", "Hello World")));
+  {
+    File f(path);
+    ASSERT_TRUE(f.Open(File::modeBinary | File::modeReadWrite));
+    f.Seek(0, File::Whence::end);
+    f.Write("\0\0\0", 3);
+  }
+
+  NetMailFileView view(path, false);
+  ASSERT_TRUE(view);
+  auto num = 0;
+  for (const auto& p : view) {
+    EXPECT_EQ(ParsedNetPacketText::FromNetPacket(p.ToNetPacket()).title(), "Title1");
+    ++num;
+  }
+  EXPECT_EQ(1, num);
+  EXPECT_EQ(ReadNetPacketResponse::ERROR, view.last_read_response());
+}
+
+static std::vector<std::string> ReadTitles(const std::filesystem::path& path) {
+  std::vector<std::string> titles;
+  NetMailFile reader(path, false);
+  for (const auto& p : reader) {
+    titles.push_back(ParsedNetPacketText::FromNetPacket(p).title());
+  }
+  return titles;
+}
+
+TEST_F(PacketsTest, NetPacketWriter) {
+  const auto net = sdk_helper_.CreateTestNetwork(wwiv::sdk::net::network_type_t::wwivnet);
+  const auto local = FilePath(net.dir, LOCAL_NET);
+  const auto s2 = FilePath(net.dir, "s2.net");
+  ASSERT_TRUE(write_wwivnet_packet(local, CreatePacket("MYSUB", "Title1", "Sysop #1", "Hello")));
+
+  NetPacketWriter writer;
+  ASSERT_TRUE(writer.Write(local, CreatePacket("MYSUB", "Title2", "Sysop #1", "Hello")));
+  ASSERT_TRUE(writer.Write(s2, CreatePacket("MYSUB", "Title3", "Sysop #1", "Hello")));
+  ASSERT_TRUE(writer.Write(local, CreatePacket("MYSUB", "Title4", "Sysop #1", "Hello")));
+  EXPECT_GT(writer.buffered(), 0u);
+  EXPECT_FALSE(File::Exists(s2));
+
+  ASSERT_TRUE(writer.Flush());
+  EXPECT_EQ(0u, writer.buffered());
+  EXPECT_EQ(ReadTitles(local), (std::vector<std::string>{"Title1", "Title2", "Title4"}));
+  EXPECT_EQ(ReadTitles(s2), (std::vector<std::string>{"Title3"}));
+}
+
+TEST_F(PacketsTest, NetPacketWriter_FlushesWhenFull) {
+  const auto net = sdk_helper_.CreateTestNetwork(wwiv::sdk::net::network_type_t::wwivnet);
+  const auto path = FilePath(net.dir, LOCAL_NET);
+  {
+    NetPacketWriter writer(1);
+    ASSERT_TRUE(writer.Write(path, CreatePacket("MYSUB", "Title1", "Sysop #1", "Hello")));
+    EXPECT_EQ(0u, writer.buffered());
+    EXPECT_EQ(ReadTitles(path), (std::vector<std::string>{"Title1"}));
+
+    NetPacketWriter writer2;
+    ASSERT_TRUE(writer2.Write(path, CreatePacket("MYSUB", "Title2", "Sysop #1", "Hello")));
+  }
+  // Destroying the writer flushes it.
+  EXPECT_EQ(ReadTitles(path), (std::vector<std::string>{"Title1", "Title2"}));
+}
+
+TEST_F(PacketsTest, NetPacketWriter_FlushFailsPartway) {
+  const auto net = sdk_helper_.CreateTestNetwork(wwiv::sdk::net::network_type_t::wwivnet);
+  const auto local = FilePath(net.dir, LOCAL_NET);
+  const auto missing_dir = FilePath(net.dir, "missing");
+  const auto s2 = FilePath(missing_dir, "s2.net");
+
+  NetPacketWriter writer(1);
+  ASSERT_TRUE(writer.Write(local, CreatePacket("MYSUB", "Title1", "Sysop #1", "Hello")));
+  // s2.net can not be created, so it stays buffered while local.net is written.
+  ASSERT_TRUE(writer.Write(s2, CreatePacket("MYSUB", "Title2", "Sysop #1", "Hello")));
+  EXPECT_EQ(1, writer.write_errors());
+  ASSERT_TRUE(writer.Write(local, CreatePacket("MYSUB", "Title3", "Sysop #1", "Hello")));
+  ASSERT_TRUE(writer.Write(s2, CreatePacket("MYSUB", "Title4", "Sysop #1", "Hello")));
+  EXPECT_EQ(ReadTitles(local), (std::vector<std::string>{"Title1", "Title3"}));
+  EXPECT_FALSE(writer.Flush());
+  EXPECT_GT(writer.buffered(), 0u);
+  EXPECT_EQ(4, writer.write_errors());
+
+  ASSERT_TRUE(File::mkdirs(missing_dir));
+  ASSERT_TRUE(writer.Flush());
+  EXPECT_EQ(0u, writer.buffered());
+  EXPECT_EQ(4, writer.write_errors());
+  EXPECT_EQ(ReadTitles(s2), (std::vector<std::string>{"Title2", "Title4"}));
+  EXPECT_EQ(ReadTitles(local), (std::vector<std::string>{"Title1", "Title3"}));
+}
+
+TEST_F(PacketsTest, NetPacketWriter_Malformed) {
+  const auto net = sdk_helper_.CreateTestNetwork(wwiv::sdk::net::network_type_t::wwivnet);
+  const auto path = FilePath(net.dir, LOCAL_NET);
+  auto packet = CreatePacket("MYSUB", "Title1", "Sysop #1", "Hello");
+  packet.nh.length++;
+  NetPacketWriter writer;
+  EXPECT_FALSE(writer.Write(path, packet));
+  EXPECT_EQ(0u, writer.buffered());
+}
@@ -0,0 +1,573 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "sdk/synthetic_data.h"
+
+#include "core/datafile.h"
+#include "core/datetime.h"
+#include "core/file.h"
+#include "core/log.h"
+#include "core/stl.h"
+#include "core/strings.h"
+#include "core/version.h"
+#include "fmt/format.h"
+#include "sdk/filenames.h"
+#include "sdk/names.h"
+#include "sdk/status.h"
+#include "sdk/subxtr.h"
+#include "sdk/user.h"
+#include "sdk/usermanager.h"
+#include "sdk/fido/fido_directories.h"
+#include "sdk/fido/fido_packets.h"
+#include "sdk/fido/fido_util.h"
+#include "sdk/files/dirs.h"
+#include "sdk/files/files.h"
+#include "sdk/msgapi/message_area_wwiv.h"
+#include "sdk/msgapi/sub_qscan_table.h"
+#include "sdk/msgapi/type2_text.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace wwiv::core;
+using namespace wwiv::sdk::fido;
+using namespace wwiv::sdk::files;
+using namespace wwiv::sdk::msgapi;
+using namespace wwiv::sdk::net;
+using namespace wwiv::stl;
+using namespace wwiv::strings;
+
+namespace wwiv::sdk {
+
+// Generated data is spread out over this many days after the start date.
+static constexpr int64_t generated_days = 365;
+static constexpr int64_t seconds_per_day = 24 * 60 * 60;
+// Number of synthetic users messages are sent from before set_senders.
+static constexpr int default_num_senders = 1000;
+
+static const std::array<const char*, 32> first_names = {
+    "ALICE",  "BOB",    "CAROL", "DAVE",   "ERIN",  "FRANK", "GRACE", "HEIDI",
+    "IVAN",   "JUDY",   "KEN",   "LAURA",  "MIKE",  "NANCY", "OSCAR", "PEGGY",
+    "QUINN",  "RUPERT", "SYBIL", "TRENT",  "URSULA", "VICTOR", "WALTER", "XENA",
+    "YVONNE", "ZACK",   "ANDY",  "BETTY",  "CHUCK", "DORIS", "EDDIE", "FLO"};
+
+static const std::array<const char*, 32> last_names = {
+    "SMITH",  "JONES",  "BROWN",   "MILLER", "DAVIS",  "GARCIA", "WILSON", "MOORE",
+    "TAYLOR", "ANDERSON", "THOMAS", "JACKSON", "WHITE", "HARRIS", "MARTIN", "THOMPSON",
+    "CLARK",  "LEWIS",  "ROBINSON", "WALKER", "YOUNG", "ALLEN",  "KING",   "WRIGHT",
+    "SCOTT",  "GREEN",  "BAKER",   "ADAMS",  "NELSON", "HILL",   "CAMPBELL", "MITCHELL"};
+
+static const std::array<const char*, 32> words = {
+    "the",    "quick",   "brown",  "fox",     "jumps", "over",   "lazy",  "dog",
+    "message", "bbs",    "sysop",  "modem",   "packet", "echo",  "net",   "file",
+    "door",   "ansi",    "callout", "node",   "zone",  "fidonet", "wwiv", "post",
+    "upload", "download", "baud",  "terminal", "chat", "board",  "logon", "menu"};
+
+std::string synthetic_word(SyntheticRandom& r) {
+  return words[r.next(size_uint32(words))];
+}
+
+std::string synthetic_text(SyntheticRandom& r, int num_bytes) {
+  std::string text;
+  text.reserve(num_bytes + 16);
+  auto line_len = 0;
+  while (ssize(text) < num_bytes) {
+    const auto word = synthetic_word(r);
+    if (line_len + ssize(word) > 72) {
+      text.append("\r\n");
+      line_len = 0;
+    } else if (line_len > 0) {
+      text.push_back(' ');
+      ++line_len;
+    }
+    text.append(word);
+    line_len += ssize(word);
+  }
+  text.resize(std::max(0, num_bytes));
+  return text;
+}
+
+std::string synthetic_text(int num_bytes, uint32_t seed) {
+  SyntheticRandom r(seed);
+  return synthetic_text(r, num_bytes);
+}
+
+std::string synthetic_user_name(int n) {
+  constexpr auto num_first = static_cast<int>(first_names.size());
+  constexpr auto num_last = static_cast<int>(last_names.size());
+  auto name = StrCat(first_names[n % num_first], " ", last_names[(n / num_first) % num_last]);
+  if (const auto suffix = n / (num_first * num_last); suffix > 0) {
+    name += StrCat(" ", suffix);
+  }
+  return name;
+}
+
+/**
+ * Returns the first name of the form prefix#### not used according to exists
+ * and without a file named name + ext in any of dirs.
+ */
+template <typename E>
+static std::string unused_filename(const std::string& prefix, int start, const E& exists,
+                                   const std::vector<std::filesystem::path>& dirs,
+                                   const std::string& ext) {
+  for (auto n = start;; n++) {
+    auto name = fmt::format("{}{:04d}", prefix, n);
+    if (exists(name)) {
+      continue;
+    }
+    if (std::none_of(std::begin(dirs), std::end(dirs),
+                     [&](const auto& d) { return File::Exists(FilePath(d, StrCat(name, ext))); })) {
+      return name;
+    }
+  }
+}
+
+/** Returns the path to the first p#.net file that does not exist in dir. */
+static std::filesystem::path unused_packet_path(const std::filesystem::path& dir) {
+  for (auto n = 1;; n++) {
+    if (auto path = FilePath(dir, fmt::format("p{}.net", n)); !File::Exists(path)) {
+      return path;
+    }
+  }
+}
+
+SyntheticData::SyntheticData(uint32_t seed, int text_size, daten_t start_daten)
+    : random_(seed), text_size_(std::clamp(text_size, 1, 60 * 1024)), start_daten_(start_daten) {
+  senders_.reserve(default_num_senders);
+  for (auto n = 1; n <= default_num_senders; n++) {
+    senders_.emplace_back(static_cast<uint16_t>(n),
+                          fmt::format("{} #{}", properize(synthetic_user_name(n - 1)), n));
+  }
+}
+
+std::string SyntheticData::text(int average) {
+  const auto size =
+      std::max(1, average / 2 + static_cast<int>(random_.next(static_cast<uint32_t>(average) + 1)));
+  return synthetic_text(random_, size);
+}
+
+daten_t SyntheticData::daten_for(int64_t i, int64_t num) const {
+  return static_cast<daten_t>(start_daten_ + i * generated_days * seconds_per_day /
+                                                 std::max<int64_t>(1, num));
+}
+
+void SyntheticData::set_senders(std::vector<std::pair<uint16_t, std::string>> senders) {
+  senders_ = std::move(senders);
+}
+
+const std::pair<uint16_t, std::string>& SyntheticData::random_sender() {
+  return senders_.at(random_.next(size_uint32(senders_)));
+}
+
+std::vector<postrec> SyntheticData::posts(int num, uint32_t first_qscan,
+                                          std::vector<std::string>* texts) {
+  std::vector<postrec> posts;
+  posts.reserve(num);
+  if (texts) {
+    texts->reserve(texts->size() + num);
+  }
+  for (auto i = 0; i < num; i++) {
+    const auto& [owner, sender] = random_sender();
+    postrec p{};
+    to_char_array(p.title, fmt::format("{} {} #{}", word(), word(), i + 1));
+    p.owneruser = owner;
+    p.qscan = first_qscan + static_cast<uint32_t>(i);
+    p.daten = daten_for(i, num);
+    if (texts) {
+      // FROM<CRLF>DATE<CRLF>TEXT like WWIVMessageArea::AddMessage.
+      texts->emplace_back(
+          StrCat(sender, "\r\n", daten_to_wwivnet_time(p.daten), "\r\n", text(), "\x1a"));
+    }
+    posts.push_back(p);
+  }
+  return posts;
+}
+
+std::vector<NetPacket> SyntheticData::wwivnet_posts(int num, uint16_t tosys,
+                                                    const std::string& subtype) {
+  std::vector<NetPacket> packets;
+  packets.reserve(num);
+  for (auto i = 0; i < num; i++) {
+    const auto& [from, sender] = random_sender();
+    const auto fromsys = static_cast<uint16_t>(tosys + 1 + random_.next(100));
+    net_header_rec nh{};
+    nh.daten = daten_for(i, num);
+    nh.fromsys = fromsys;
+    nh.fromuser = from;
+    nh.tosys = tosys;
+    nh.main_type = main_type_new_post;
+    ParsedNetPacketText ppt(main_type_new_post);
+    ppt.set_subtype(subtype);
+    ppt.set_title(fmt::format("Inbound post #{}", i + 1));
+    ppt.set_sender(fmt::format("{} @{}", sender, fromsys));
+    ppt.set_date(nh.daten);
+    ppt.set_text(text());
+    packets.emplace_back(nh, std::vector<uint16_t>{}, ppt);
+  }
+  return packets;
+}
+
+bool SyntheticData::write_fido_packet(const std::filesystem::path& path, const FidoAddress& from,
+                                      const FidoAddress& to, int num, const std::string& area) {
+  File f(path);
+  if (!f.Open(File::modeReadWrite | File::modeBinary | File::modeCreateFile |
+              File::modeTruncate) ||
+      !write_fido_packet_header(f, CreateType2PlusPacketHeader(from, to, DateTime::now(), ""))) {
+    return false;
+  }
+  for (auto i = 0; i < num; i++) {
+    fido_packed_message_t nh{};
+    nh.message_type = 2;
+    nh.orig_net = from.net();
+    nh.orig_node = from.node();
+    nh.dest_net = to.net();
+    nh.dest_node = to.node();
+    fido_variable_length_header_t vh{};
+    vh.date_time = daten_to_fido(daten_for(i, num));
+    vh.to_user_name = "All";
+    vh.from_user_name = properize(synthetic_user_name(static_cast<int>(random_.next(10000))));
+    vh.subject = fmt::format("Inbound echo #{}", i + 1);
+    vh.text = StrCat("AREA:", area, "\r", text());
+    if (!write_packed_message(f, FidoPackedMessage(nh, vh))) {
+      return false;
+    }
+  }
+  // Packets end with two NUL bytes.
+  return f.Write("\0\0", 2) == 2;
+}
+
+SyntheticBbs::SyntheticBbs(const Config& config, std::vector<Network> networks,
+                           SyntheticData& data)
+    : config_(config), networks_(std::move(networks)), data_(data) {}
+
+bool SyntheticBbs::AddUsers(int num_users) {
+  if (config_.userrec_length() != static_cast<int>(sizeof(userrec))) {
+    LOG(ERROR) << "Unexpected user record length: " << config_.userrec_length();
+    return false;
+  }
+  UserManager um(config_);
+  const auto first_user = std::max(1, um.num_user_records() + 1);
+  num_users = std::min(num_users, config_.max_users() - first_user + 1);
+  if (num_users <= 0) {
+    LOG(ERROR) << "USER.LST already has the maximum number of users: " << config_.max_users();
+    return false;
+  }
+  VLOG(1) << "Adding " << num_users << " users starting at #" << first_user;
+
+  const std::vector<uint8_t> colors{7, 11, 14, 13, 31, 10, 12, 9, 5, 3};
+  const std::vector<uint8_t> bwcolors{7, 15, 15, 15, 112, 15, 15, 7, 7, 7};
+  auto& r = data_.random();
+  std::vector<userrec> users;
+  users.reserve(num_users);
+  for (auto i = 0; i < num_users; i++) {
+    const auto user_number = first_user + i;
+    User u{};
+    User::CreateNewUserRecord(&u, config_.newuser_sl(), config_.newuser_dsl(),
+                              config_.newuser_restrict(), config_.newuser_gold(), colors,
+                              bwcolors);
+    u.set_name(synthetic_user_name(user_number - 1));
+    u.real_name(properize(synthetic_user_name(user_number - 1)));
+    u.password(fmt::format("PW{}", user_number));
+    u.city("Somewhere");
+    u.state("WA");
+    u.country("USA");
+    u.zip_code("98052");
+    u.voice_phone(fmt::format("425-555-{:04d}", user_number % 10000));
+    u.data_phone(u.voice_phone());
+    u.gender(r.next(2) ? 'M' : 'F');
+    u.birthday_mdy(static_cast<int>(r.next(12)) + 1, static_cast<int>(r.next(28)) + 1,
+                   1950 + static_cast<int>(r.next(50)));
+    const auto first_on = DateTime::from_daten(data_.daten_for(i, num_users));
+    u.firston(first_on.to_string("%m/%d/%y"));
+    u.laston(DateTime::now().to_string("%m/%d/%y"));
+    u.logons(static_cast<int>(r.next(1000)));
+    users.push_back(u.data);
+  }
+
+  DataFile<userrec> file(FilePath(config_.datadir(), USER_LST),
+                         File::modeBinary | File::modeReadWrite | File::modeCreateFile,
+                         File::shareDenyReadWrite);
+  if (!file || !file.Seek(first_user) || !file.WriteVector(users)) {
+    LOG(ERROR) << "Unable to write users to: " << USER_LST;
+    return false;
+  }
+  file.Close();
+
+  Names names(config_);
+  if (!names.Rebuild(um) || !names.Save()) {
+    LOG(ERROR) << "Unable to rebuild: " << NAMES_LST;
+    return false;
+  }
+  StatusMgr sm(config_.datadir());
+  return sm.Run([&](Status& s) { s.num_users(names.size()); });
+}
+
+bool SyntheticBbs::LoadSenders() {
+  const Names names(config_);
+  std::vector<std::pair<uint16_t, std::string>> senders;
+  for (const auto& n : names.names_vector()) {
+    senders.emplace_back(n.number, fmt::format("{} #{}",
+                                               properize(reinterpret_cast<const char*>(n.name)),
+                                               n.number));
+  }
+  if (senders.empty()) {
+    return false;
+  }
+  data_.set_senders(std::move(senders));
+  return true;
+}
+
+uint32_t SyntheticBbs::reserve_qscan(int64_t num) const {
+  uint32_t first = 0;
+  StatusMgr sm(config_.datadir());
+  if (!sm.Run([&](Status& s) {
+        first = s.qscanptr();
+        s.qscanptr(first + static_cast<uint32_t>(num));
+      })) {
+    return 0;
+  }
+  return first;
+}
+
+bool SyntheticBbs::AddSubs(int num_subs, int num_posts) {
+  num_posts = std::clamp(num_posts, 0, static_cast<int>(std::numeric_limits<uint16_t>::max()));
+  Subs subs(config_.datadir(), networks_, config_.max_backups());
+  if (!subs.Load()) {
+    LOG(ERROR) << "Unable to load: " << SUBS_JSON;
+    return false;
+  }
+  auto qscan = reserve_qscan(static_cast<int64_t>(num_subs) * num_posts);
+  if (qscan == 0) {
+    LOG(ERROR) << "Unable to update: " << STATUS_DAT;
+    return false;
+  }
+  SubQScanTable qscan_table(config_.datadir());
+  qscan_table.Load();
+
+  const auto sub_exists = [&](const std::string& name) { return subs.exists(name); };
+  for (auto sub_num = 0; sub_num < num_subs; sub_num++) {
+    subboard_t sub{};
+    sub.filename = unused_filename("gen", sub_num, sub_exists,
+                                   {config_.datadir(), config_.msgsdir()}, ".sub");
+    sub.name = fmt::format("Generated Sub {}", sub.filename.substr(3));
+    sub.desc = sub.name;
+    sub.storage_type = STORAGE_TYPE;
+    sub.maxmsgs = static_cast<uint16_t>(std::max(num_posts, 1));
+
+    std::vector<std::string> texts;
+    auto posts = data_.posts(num_posts, qscan, &texts);
+    qscan += static_cast<uint32_t>(num_posts);
+    Type2Text t2(FilePath(config_.msgsdir(), StrCat(sub.filename, ".dat")));
+    auto msgs = t2.savefiles(texts);
+    if (!msgs) {
+      LOG(ERROR) << "Unable to write message text for sub: " << sub.filename;
+      return false;
+    }
+    for (auto i = 0; i < num_posts; i++) {
+      posts[i].msg = msgs->at(i);
+    }
+    const WWIVMessageAreaHeader header(wwiv_config_version(), static_cast<uint32_t>(num_posts));
+    DataFile<postrec> file(FilePath(config_.datadir(), StrCat(sub.filename, ".sub")),
+                           File::modeBinary | File::modeReadWrite | File::modeCreateFile |
+                               File::modeTruncate,
+                           File::shareDenyReadWrite);
+    static_assert(sizeof(subfile_header_t) == sizeof(postrec));
+    if (!file || !file.Write(reinterpret_cast<const postrec*>(&header.header())) ||
+        (!posts.empty() && !file.WriteVector(posts))) {
+      LOG(ERROR) << "Unable to write sub: " << sub.filename;
+      return false;
+    }
+    if (!posts.empty()) {
+      qscan_table.Update(sub.filename, posts.back().qscan);
+    }
+    subs.add(sub);
+    VLOG(1) << "Added sub: " << sub.filename;
+  }
+  if (!subs.Save()) {
+    LOG(ERROR) << "Unable to save: " << SUBS_JSON;
+    return false;
+  }
+  return true;
+}
+
+bool SyntheticBbs::AddDirs(int num_dirs, int num_files) {
+  num_files = std::clamp(num_files, 0, static_cast<int>(std::numeric_limits<uint16_t>::max()));
+  Dirs dirs(config_.datadir(), config_.max_backups());
+  if (!dirs.Load()) {
+    LOG(ERROR) << "Unable to load: " << DIRS_JSON;
+    return false;
+  }
+  auto& r = data_.random();
+  FileApi api(config_.datadir());
+  const auto dir_exists = [&](const std::string& name) { return dirs.exists(name); };
+  for (auto dir_num = 0; dir_num < num_dirs; dir_num++) {
+    directory_t dir{};
+    dir.filename = unused_filename("gen", dir_num, dir_exists, {config_.datadir()}, ".dir");
+    dir.name = fmt::format("Generated Files {}", dir.filename.substr(3));
+    dir.path = FilePath(config_.dloadsdir(), dir.filename).string();
+    dir.maxfiles = static_cast<uint16_t>(std::max(num_files, 1));
+    File::mkdirs(dir.path);
+
+    if (!api.Create(dir)) {
+      LOG(ERROR) << "Unable to create file area: " << dir.filename;
+      return false;
+    }
+    auto area = api.Open(dir);
+    if (!area) {
+      LOG(ERROR) << "Unable to open file area: " << dir.filename;
+      return false;
+    }
+    // AddFile puts each file first, so add the oldest ones first.
+    for (auto i = 0; i < num_files; i++) {
+      const auto& [owner, sender] = data_.random_sender();
+      FileRecord f;
+      f.set_filename(fmt::format("F{:07d}.ZIP", i + 1));
+      f.set_description(
+          fmt::format("The {} {} {} archive", data_.word(), data_.word(), data_.word()));
+      f.set_numbytes(static_cast<int>(r.next(10 * 1024 * 1024)) + 1);
+      f.set_uploaded_by(sender);
+      f.set_ownerusr(owner);
+      f.set_date(DateTime::from_daten(data_.daten_for(i, num_files)));
+      // Give about a third of the files an extended description.
+      const auto ext_desc = r.next(3) == 0 ? data_.text(240) : "";
+      if (!area->AddFile(f, ext_desc)) {
+        LOG(ERROR) << "Unable to add file: " << f;
+        return false;
+      }
+    }
+    if (!area->Save()) {
+      LOG(ERROR) << "Unable to save file area: " << dir.filename;
+      return false;
+    }
+    dirs.insert(dirs.size(), dir);
+    VLOG(1) << "Added file area: " << dir.filename;
+  }
+  if (!dirs.Save()) {
+    LOG(ERROR) << "Unable to save: " << DIRS_JSON;
+    return false;
+  }
+  return true;
+}
+
+bool SyntheticBbs::AddEmail(int num_email) {
+  std::vector<std::string> texts;
+  std::vector<mailrec> headers;
+  std::map<uint16_t, int> waiting;
+  texts.reserve(num_email);
+  headers.reserve(num_email);
+  for (auto i = 0; i < num_email; i++) {
+    const auto& [from, sender] = data_.random_sender();
+    const auto to = data_.random_sender().first;
+    mailrec m{};
+    to_char_array(m.title, fmt::format("About the {} {}", data_.word(), data_.word()));
+    m.fromuser = from;
+    m.touser = to;
+    m.daten = data_.daten_for(i, num_email);
+    texts.emplace_back(StrCat(sender, "\r\n", daten_to_wwivnet_time(m.daten), "\r\n",
+                              data_.text(), "\x1a"));
+    headers.push_back(m);
+    ++waiting[to];
+  }
+  Type2Text t2(FilePath(config_.msgsdir(), EMAIL_DAT));
+  auto msgs = t2.savefiles(texts);
+  if (!msgs) {
+    LOG(ERROR) << "Unable to write email text.";
+    return false;
+  }
+  for (auto i = 0; i < num_email; i++) {
+    headers[i].msg = msgs->at(i);
+  }
+  {
+    DataFile<mailrec> file(FilePath(config_.datadir(), EMAIL_DAT),
+                           File::modeBinary | File::modeReadWrite | File::modeCreateFile,
+                           File::shareDenyReadWrite);
+    if (!file || !file.Seek(file.number_of_records()) || !file.WriteVector(headers)) {
+      LOG(ERROR) << "Unable to write: " << EMAIL_DAT;
+      return false;
+    }
+  }
+
+  // Update the waiting email count of everyone who got some, all at once.
+  DataFile<userrec> users(FilePath(config_.datadir(), USER_LST),
+                          File::modeBinary | File::modeReadWrite, File::shareDenyReadWrite);
+  std::vector<userrec> recs;
+  if (!users || !users.ReadVector(recs)) {
+    LOG(ERROR) << "Unable to read: " << USER_LST;
+    return false;
+  }
+  for (const auto& [user_number, count] : waiting) {
+    if (user_number < ssize(recs)) {
+      recs[user_number].waiting =
+          static_cast<uint8_t>(std::min(255, recs[user_number].waiting + count));
+    }
+  }
+  return users.Seek(0) && users.WriteVector(recs);
+}
+
+bool SyntheticBbs::AddPackets(int num_packets, const std::string& subtype) {
+  for (const auto& net : networks_) {
+    if (net.type == network_type_t::wwivnet) {
+      if (!AddWWIVnetPackets(net, num_packets, subtype)) {
+        return false;
+      }
+    } else if (net.type == network_type_t::ftn) {
+      if (!AddFidoPackets(net, num_packets, subtype)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SyntheticBbs::AddWWIVnetPackets(const Network& net, int num_packets,
+                                     const std::string& subtype) {
+  const auto packets = data_.wwivnet_posts(num_packets, net.sysnum, subtype);
+  const auto path = unused_packet_path(net.dir);
+  VLOG(1) << "Writing " << num_packets << " packets to " << path;
+  if (!write_wwivnet_packets(path, packets)) {
+    LOG(ERROR) << "Unable to write: " << path;
+    return false;
+  }
+  return true;
+}
+
+bool SyntheticBbs::AddFidoPackets(const Network& net, int num_packets,
+                                  const std::string& subtype) {
+  const auto us = try_parse_fidoaddr(net.fido.fido_address, fidoaddr_parse_t::lax);
+  if (!us) {
+    LOG(ERROR) << "Invalid FTN address: '" << net.fido.fido_address << "' for " << net.name;
+    return false;
+  }
+  const FidoAddress uplink(us->zone(), us->net(), static_cast<int16_t>(us->node() + 1), 0, "");
+  const FtnDirectories dirs(config_.root_directory(), net);
+  File::mkdirs(dirs.temp_inbound_dir());
+  const auto path = FilePath(dirs.temp_inbound_dir(), packet_name(DateTime::now()));
+  VLOG(1) << "Writing " << num_packets << " packets to " << path;
+  if (!data_.write_fido_packet(path, uplink, us.value(), num_packets, subtype)) {
+    LOG(ERROR) << "Unable to write: " << path;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
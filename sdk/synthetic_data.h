@@ -0,0 +1,151 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#ifndef INCLUDED_SDK_SYNTHETIC_DATA_H
+#define INCLUDED_SDK_SYNTHETIC_DATA_H
+
+#include "core/wwivport.h"
+#include "sdk/config.h"
+#include "sdk/vardec.h"
+#include "sdk/fido/fido_address.h"
+#include "sdk/net/net.h"
+#include "sdk/net/packets.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace wwiv::sdk {
+
+/** Small and fast random numbers, the same every time for a given seed. */
+class SyntheticRandom final {
+public:
+  explicit SyntheticRandom(uint32_t seed) : state_(seed ? seed : 0x2545f491) {}
+  uint32_t next() {
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 17;
+    state_ ^= state_ << 5;
+    return state_;
+  }
+  /** Returns a number from 0 up to but not including limit. */
+  uint32_t next(uint32_t limit) { return limit ? next() % limit : 0; }
+
+private:
+  uint32_t state_;
+};
+
+/** Returns a random lower case word. */
+[[nodiscard]] std::string synthetic_word(SyntheticRandom& r);
+/** Returns num_bytes of text made of words and CRLF line breaks. */
+[[nodiscard]] std::string synthetic_text(SyntheticRandom& r, int num_bytes);
+/** Returns num_bytes of text, the same every time for seed. */
+[[nodiscard]] std::string synthetic_text(int num_bytes, uint32_t seed);
+/** Returns the unique upper case name of synthetic user number n, starting at 0. */
+[[nodiscard]] std::string synthetic_user_name(int n);
+
+/**
+ * Synthetic messages and packets for load testing and benchmarks. Given the
+ * same seed and start date, everything generated is the same every time.
+ */
+class SyntheticData final {
+public:
+  /**
+   * Messages are about text_size bytes long and dated from start_daten
+   * through the following year.
+   */
+  SyntheticData(uint32_t seed, int text_size, daten_t start_daten);
+
+  [[nodiscard]] SyntheticRandom& random() noexcept { return random_; }
+  [[nodiscard]] std::string word() { return synthetic_word(random_); }
+  /** Returns text between half and one and a half times the text size. */
+  [[nodiscard]] std::string text() { return text(text_size_); }
+  /** Returns text between half and one and a half times average bytes. */
+  [[nodiscard]] std::string text(int average);
+
+  /** Returns the date of item i out of num, spread out evenly over the year. */
+  [[nodiscard]] daten_t daten_for(int64_t i, int64_t num) const;
+
+  /**
+   * Sets the user number and "Name #number" of everyone messages are sent
+   * from. Until this is called 1000 synthetic users are used.
+   */
+  void set_senders(std::vector<std::pair<uint16_t, std::string>> senders);
+  [[nodiscard]] const std::pair<uint16_t, std::string>& random_sender();
+
+  /**
+   * Returns num post records with qscan values starting at first_qscan. The
+   * text of each is returned in texts, formatted like WWIVMessageArea stores
+   * it, if texts is not null. The msg field of each post is left empty.
+   */
+  [[nodiscard]] std::vector<postrec> posts(int num, uint32_t first_qscan,
+                                           std::vector<std::string>* texts);
+  /** Returns num inbound posts for subtype from systems after tosys. */
+  [[nodiscard]] std::vector<net::NetPacket> wwivnet_posts(int num, uint16_t tosys,
+                                                          const std::string& subtype);
+  /** Writes a type 2+ FidoNet packet with num echomail messages in area to path. */
+  bool write_fido_packet(const std::filesystem::path& path, const fido::FidoAddress& from,
+                         const fido::FidoAddress& to, int num, const std::string& area);
+
+private:
+  SyntheticRandom random_;
+  const int text_size_;
+  const daten_t start_daten_;
+  std::vector<std::pair<uint16_t, std::string>> senders_;
+};
+
+/**
+ * Adds synthetic users, subs, file areas, email and inbound network packets
+ * to a BBS. Nothing existing is changed or removed, except that the users
+ * and email are appended to USER.LST and EMAIL.DAT.
+ */
+class SyntheticBbs final {
+public:
+  SyntheticBbs(const Config& config, std::vector<net::Network> networks, SyntheticData& data);
+
+  /** Appends num_users users to USER.LST and rebuilds NAMES.LST. */
+  bool AddUsers(int num_users);
+  /** Sends messages from the users in NAMES.LST. Returns false if there are none. */
+  bool LoadSenders();
+  /** Adds num_subs type-2 subs, each holding num_posts posts (at most 65535). */
+  bool AddSubs(int num_subs, int num_posts);
+  /** Adds num_dirs file areas, each holding num_files files. */
+  bool AddDirs(int num_dirs, int num_files);
+  /** Adds num_email email messages, sent to random users. */
+  bool AddEmail(int num_email);
+  /**
+   * Writes num_packets inbound posts for subtype to each network, WWIVnet
+   * packets as a p*.net file and FTN packets as a *.pkt file in the temp
+   * inbound directory.
+   */
+  bool AddPackets(int num_packets, const std::string& subtype);
+
+private:
+  bool AddWWIVnetPackets(const net::Network& net, int num_packets, const std::string& subtype);
+  bool AddFidoPackets(const net::Network& net, int num_packets, const std::string& subtype);
+  /** Reserves num qscan pointers, returning the first one or 0 on error. */
+  [[nodiscard]] uint32_t reserve_qscan(int64_t num) const;
+
+  const Config& config_;
+  const std::vector<net::Network> networks_;
+  SyntheticData& data_;
+};
+
+}  // namespace
+
+#endif
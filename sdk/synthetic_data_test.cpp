@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "core/strings.h"
+#include "sdk/names.h"
+#include "sdk/sdk_helper.h"
+#include "sdk/subxtr.h"
+#include "sdk/synthetic_data.h"
+#include "sdk/msgapi/message_api_wwiv.h"
+#include "sdk/msgapi/msgapi.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace wwiv::sdk;
+using namespace wwiv::sdk::msgapi;
+using namespace wwiv::strings;
+using testing::HasSubstr;
+using testing::StartsWith;
+
+// 01/01/1999
+static constexpr daten_t start_daten = 915192000;
+
+TEST(SyntheticDataTest, Text_ExactLength) {
+  const auto text = synthetic_text(1000, 1);
+  EXPECT_EQ(1000u, text.size());
+  EXPECT_EQ(text, synthetic_text(1000, 1));
+  EXPECT_NE(text, synthetic_text(1000, 2));
+}
+
+TEST(SyntheticDataTest, UserName_Unique) {
+  EXPECT_EQ("ALICE SMITH", synthetic_user_name(0));
+  EXPECT_EQ("BOB SMITH", synthetic_user_name(1));
+  EXPECT_EQ("ALICE JONES", synthetic_user_name(32));
+  EXPECT_EQ("ALICE SMITH 1", synthetic_user_name(32 * 32));
+}
+
+TEST(SyntheticDataTest, Posts_SameForSeed) {
+  SyntheticData d1(7, 200, start_daten);
+  SyntheticData d2(7, 200, start_daten);
+  std::vector<std::string> t1;
+  std::vector<std::string> t2;
+  const auto p1 = d1.posts(10, 100, &t1);
+  const auto p2 = d2.posts(10, 100, &t2);
+  ASSERT_EQ(10u, p1.size());
+  ASSERT_EQ(10u, t1.size());
+  EXPECT_EQ(t1, t2);
+  for (auto i = 0; i < 10; i++) {
+    EXPECT_STREQ(p1[i].title, p2[i].title);
+    EXPECT_EQ(100u + i, p1[i].qscan);
+    EXPECT_EQ(p1[i].daten, p2[i].daten);
+  }
+  EXPECT_EQ(start_daten, p1.front().daten);
+  EXPECT_LT(p1.front().daten, p1.back().daten);
+}
+
+class SyntheticBbsTest : public testing::Test {
+public:
+  SyntheticBbsTest() : data(1, 500, start_daten), bbs(helper.config(), {}, data) {}
+
+  SdkHelper helper;
+  SyntheticData data;
+  SyntheticBbs bbs;
+};
+
+TEST_F(SyntheticBbsTest, AddUsers) {
+  ASSERT_TRUE(bbs.AddUsers(10));
+
+  const Names names(helper.config());
+  EXPECT_EQ(10, names.size());
+  EXPECT_EQ(1, names.FindUser(synthetic_user_name(0)));
+  EXPECT_EQ(10, names.FindUser(synthetic_user_name(9)));
+  EXPECT_TRUE(bbs.LoadSenders());
+}
+
+TEST_F(SyntheticBbsTest, LoadSenders_NoUsers) {
+  EXPECT_FALSE(bbs.LoadSenders());
+}
+
+TEST_F(SyntheticBbsTest, AddSubs_ReadBack) {
+  ASSERT_TRUE(bbs.AddUsers(10));
+  ASSERT_TRUE(bbs.LoadSenders());
+  ASSERT_TRUE(bbs.AddSubs(2, 20));
+
+  Subs subs(helper.config().datadir(), {});
+  ASSERT_TRUE(subs.Load());
+  ASSERT_EQ(2, subs.size());
+
+  MessageApiOptions options;
+  WWIVMessageApi api(options, helper.config(), {}, new NullLastReadImpl());
+  for (const auto& sub : subs.subs()) {
+    EXPECT_THAT(sub.filename, StartsWith("gen"));
+    auto area = api.Open(sub, -1);
+    ASSERT_TRUE(area);
+    ASSERT_EQ(20, area->number_of_messages());
+    for (auto i = 1; i <= 20; i++) {
+      const auto msg = area->ReadMessage(i);
+      ASSERT_TRUE(msg) << sub.filename << " #" << i;
+      EXPECT_THAT(msg->header().title(), HasSubstr(StrCat("#", i)));
+      // Senders are "Name #number" of the users added above.
+      const auto from_usernum = msg->header().from_usernum();
+      EXPECT_GE(from_usernum, 1);
+      EXPECT_LE(from_usernum, 10);
+      EXPECT_THAT(msg->header().from(), HasSubstr(StrCat("#", from_usernum)));
+      EXPECT_FALSE(msg->text().string().empty());
+    }
+  }
+}
+
+TEST_F(SyntheticBbsTest, AddEmail) {
+  ASSERT_TRUE(bbs.AddUsers(10));
+  ASSERT_TRUE(bbs.LoadSenders());
+  ASSERT_TRUE(bbs.AddEmail(25));
+
+  MessageApiOptions options;
+  WWIVMessageApi api(options, helper.config(), {}, new NullLastReadImpl());
+  auto email = api.OpenEmail();
+  ASSERT_TRUE(email);
+  EXPECT_EQ(25, email->number_of_messages());
+}
@@ -31,6 +31,8 @@
 #include "sdk/user.h"
 #include "sdk/msgapi/email_wwiv.h"
 #include "sdk/msgapi/message_api_wwiv.h"
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -87,26 +89,30 @@ bool UserManager::readuser(User *u, int user_number) const {
     u->user_number_ = user_number;
     return false;
   }
-  const auto pos = userrec_length_ * user_number;
-  file.Seek(pos, File::Whence::begin);
-  file.Read(&u->data, userrec_length_);
+  const auto pos = static_cast<File::size_type>(userrec_length_) * user_number;
+  file.ReadAt(pos, &u->data, userrec_length_);
   u->FixUp();
   u->user_number_ = user_number;
   return true;
 }
 
+static bool matches(const User& u, UserManager::mask m) {
+  switch (m) {
+  case UserManager::mask::active:
+    return !u.deleted() && !u.inactive();
+  case UserManager::mask::non_deleted:
+    return !u.deleted();
+  case UserManager::mask::non_inactive:
+    return !u.inactive();
+  case UserManager::mask::any:
+    break;
+  }
+  return true;
+}
+
 std::optional<User> UserManager::readuser(int user_number, mask m) const {
   User u{};
-  if (readuser(&u, user_number)) {
-    if (m == mask::active && (u.deleted() || u.inactive())) {
-      return std::nullopt;
-    }
-    if (m == mask::non_deleted && u.deleted()) {
-      return std::nullopt;
-    }
-    if (m == mask::non_inactive && u.inactive()) {
-      return std::nullopt;
-    }
+  if (readuser(&u, user_number) && matches(u, m)) {
     return {u};
   }
   return std::nullopt;
@@ -119,14 +125,92 @@ bool UserManager::writeuser(const User *pUser, int user_number) {
 
   if (File file(FilePath(data_directory_, USER_LST));
       file.Open(File::modeReadWrite | File::modeBinary | File::modeCreateFile)) {
-    const auto pos = static_cast<long>(userrec_length_) * static_cast<long>(user_number);
-    file.Seek(pos, File::Whence::begin);
-    file.Write(&pUser->data, userrec_length_);
+    const auto pos = static_cast<File::size_type>(userrec_length_) * user_number;
+    file.WriteAt(pos, &pUser->data, userrec_length_);
     return true;
   }
   return false;
 }
 
+bool UserManager::for_each_user(const std::function<bool(const User&)>& fn, mask m) const {
+  File file(FilePath(data_directory_, USER_LST));
+  if (!file.Open(File::modeReadOnly | File::modeBinary)) {
+    return false;
+  }
+  const FileMapping mapping(file);
+  if (!mapping) {
+    return false;
+  }
+  const auto len = std::min<int>(userrec_length_, sizeof(userrec));
+  const auto num_user_records = static_cast<int>(mapping.size() / userrec_length_) - 1;
+  for (auto i = 1; i <= num_user_records; i++) {
+    User u{};
+    memcpy(&u.data, mapping.data() + static_cast<File::size_type>(userrec_length_) * i, len);
+    u.FixUp();
+    u.user_number_ = i;
+    if (matches(u, m) && !fn(u)) {
+      break;
+    }
+  }
+  return true;
+}
+
+// Deleted users with an SL of 255 are never reused.
+static bool is_free_user(const User& u) { return u.deleted() && u.sl() != 255; }
+
+std::vector<int> UserManager::find_free_user_numbers(File& file) const {
+  std::vector<int> free_users;
+  const FileMapping mapping(file);
+  if (!mapping) {
+    return free_users;
+  }
+  const auto len = std::min<int>(userrec_length_, sizeof(userrec));
+  const auto num_user_records = static_cast<int>(mapping.size() / userrec_length_) - 1;
+  for (auto i = num_user_records; i >= 1; i--) {
+    User u{};
+    memcpy(&u.data, mapping.data() + static_cast<File::size_type>(userrec_length_) * i, len);
+    if (is_free_user(u)) {
+      free_users.push_back(i);
+    }
+  }
+  return free_users;
+}
+
+std::optional<int> UserManager::add_user(const User& user) {
+  File file(FilePath(data_directory_, USER_LST));
+  if (!file.Open(File::modeReadWrite | File::modeBinary | File::modeCreateFile)) {
+    return std::nullopt;
+  }
+  if (!free_user_numbers_) {
+    free_user_numbers_ = find_free_user_numbers(file);
+  }
+  const auto num_user_records = static_cast<int>(file.length() / userrec_length_) - 1;
+  auto& free_users = free_user_numbers_.value();
+  auto user_number = std::max(1, num_user_records + 1);
+  while (!free_users.empty()) {
+    const auto n = free_users.back();
+    free_users.pop_back();
+    if (n > num_user_records) {
+      continue;
+    }
+    User u{};
+    if (file.ReadAt(static_cast<File::size_type>(userrec_length_) * n, &u.data,
+                    userrec_length_) == userrec_length_ &&
+        is_free_user(u)) {
+      user_number = n;
+      break;
+    }
+  }
+  if (user_number > max_number_users_) {
+    return std::nullopt;
+  }
+  const auto pos = static_cast<File::size_type>(userrec_length_) * user_number;
+  if (file.WriteAt(pos, &user.data, userrec_length_) != userrec_length_) {
+    return std::nullopt;
+  }
+  return user_number;
+}
+
 bool UserManager::writeuser(const User& user, int user_number) {
   return writeuser(&user, user_number);
 }
@@ -227,6 +311,16 @@ bool UserManager::delete_user(int user_number) {
   WWIVMessageApi api(options, config_, {}, new NullLastReadImpl());
 
   deluser(user_number, config_, *this, sm, names, api);
+  if (free_user_numbers_) {
+    if (const auto u = readuser(user_number); u && is_free_user(*u)) {
+      auto& free_users = free_user_numbers_.value();
+      if (const auto it = std::lower_bound(free_users.begin(), free_users.end(), user_number,
+                                           std::greater<>());
+          it == free_users.end() || *it != user_number) {
+        free_users.insert(it, user_number);
+      }
+    }
+  }
   return true;
 }
 
@@ -20,10 +20,14 @@
 #ifndef INCLUDED_USER_MANAGER_H
 #define INCLUDED_USER_MANAGER_H
 
+#include "core/file.h"
 #include "sdk/config.h"
 #include "sdk/user.h"
 #include <filesystem>
+#include <functional>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace wwiv::sdk {
 
@@ -52,6 +56,24 @@ public:
    bool writeuser(const User &user, int user_number);
    bool writeuser(const std::optional<User>& user, int user_number);
 
+  /**
+   * Calls fn with every user in USER.LST matching m, in user number order,
+   * reading the whole file at once instead of a record at a time. Stops early
+   * when fn returns false. Returns false if USER.LST can not be read.
+   */
+  bool for_each_user(const std::function<bool(const User&)>& fn, mask m = mask::any) const;
+
+  /**
+   * Writes user into the first free (deleted) slot in USER.LST, or after the
+   * last user when there is none, and returns the new user number. Returns
+   * std::nullopt if USER.LST is full or can not be written.
+   *
+   * The free slots are found with a single pass over USER.LST the first time
+   * this is called and remembered after that, each one is checked again
+   * before it is used since another instance may have taken it.
+   */
+  std::optional<int> add_user(const User& user);
+
    bool delete_user(int user_number);
    bool restore_user(int user_number);
 
@@ -68,11 +90,16 @@ public:
   }
 
 private:
+  /** Returns the free user numbers in file, highest first. */
+  [[nodiscard]] std::vector<int> find_free_user_numbers(core::File& file) const;
+
   const Config config_;
   const std::filesystem::path data_directory_;
   int userrec_length_;
   int max_number_users_;
   bool allow_writes_{false};
+  // Free user numbers known to add_user, highest first.
+  std::optional<std::vector<int>> free_user_numbers_;
 };
 
 }  // namespace
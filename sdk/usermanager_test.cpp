@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "gtest/gtest.h"
+
+#include "core/file.h"
+#include "sdk/config.h"
+#include "sdk/filenames.h"
+#include "sdk/user.h"
+#include "sdk/usermanager.h"
+#include "sdk/sdk_helper.h"
+#include <string>
+#include <vector>
+
+using namespace wwiv::core;
+using namespace wwiv::sdk;
+
+class UserManagerTest : public testing::Test {
+public:
+  UserManagerTest() : um(helper.config()) {}
+
+  [[nodiscard]] static User CreateUser(const std::string& name) {
+    User u{};
+    User::CreateNewUserRecord(&u, 50, 20, 0, 0.1234f, {7, 11, 14, 13, 31, 10, 12, 9, 5, 3},
+                              {7, 15, 15, 15, 112, 15, 15, 7, 7, 7});
+    u.set_name(name);
+    return u;
+  }
+
+  void DeleteUser(int user_number, int sl = 50) {
+    auto u = um.readuser(user_number).value();
+    u.set_inact(User::userDeleted);
+    u.sl(sl);
+    ASSERT_TRUE(um.writeuser(u, user_number));
+  }
+
+  SdkHelper helper;
+  UserManager um;
+};
+
+TEST_F(UserManagerTest, ReadWrite) {
+  ASSERT_TRUE(um.writeuser(CreateUser("FOO"), 1));
+  ASSERT_TRUE(um.writeuser(CreateUser("BAR"), 2));
+  EXPECT_EQ(2, um.num_user_records());
+
+  const auto u = um.readuser(2);
+  ASSERT_TRUE(u);
+  EXPECT_EQ("BAR", u->name());
+  EXPECT_EQ(2, u->usernum());
+  EXPECT_FALSE(um.readuser(3));
+}
+
+TEST_F(UserManagerTest, ForEachUser) {
+  ASSERT_TRUE(um.writeuser(CreateUser("FOO"), 1));
+  ASSERT_TRUE(um.writeuser(CreateUser("BAR"), 2));
+  ASSERT_TRUE(um.writeuser(CreateUser("BAZ"), 3));
+  DeleteUser(2);
+
+  std::vector<std::string> names;
+  std::vector<int> numbers;
+  ASSERT_TRUE(um.for_each_user(
+      [&](const User& u) {
+        names.push_back(u.name());
+        numbers.push_back(u.usernum());
+        return true;
+      },
+      UserManager::mask::non_deleted));
+  EXPECT_EQ(names, (std::vector<std::string>{"FOO", "BAZ"}));
+  EXPECT_EQ(numbers, (std::vector<int>{1, 3}));
+
+  auto count = 0;
+  ASSERT_TRUE(um.for_each_user([&](const User&) { return ++count < 2; }));
+  EXPECT_EQ(2, count);
+}
+
+TEST_F(UserManagerTest, ForEachUser_NoUserList) {
+  EXPECT_FALSE(um.for_each_user([](const User&) { return true; }));
+}
+
+TEST_F(UserManagerTest, AddUser) {
+  EXPECT_EQ(1, um.add_user(CreateUser("FOO")).value_or(0));
+  EXPECT_EQ(2, um.add_user(CreateUser("BAR")).value_or(0));
+  EXPECT_EQ(3, um.add_user(CreateUser("BAZ")).value_or(0));
+  EXPECT_EQ("BAR", um.readuser(2)->name());
+}
+
+TEST_F(UserManagerTest, AddUser_ReusesDeleted) {
+  for (auto i = 1; i <= 5; i++) {
+    ASSERT_TRUE(um.writeuser(CreateUser("USER"), i));
+  }
+  DeleteUser(2);
+  DeleteUser(3, 255);
+  DeleteUser(4);
+
+  EXPECT_EQ(2, um.add_user(CreateUser("FOO")).value_or(0));
+  // Someone else used 4, so it is skipped.
+  ASSERT_TRUE(um.writeuser(CreateUser("BAR"), 4));
+  // 3 has an SL of 255 so it is never reused.
+  EXPECT_EQ(6, um.add_user(CreateUser("BAZ")).value_or(0));
+  EXPECT_EQ("FOO", um.readuser(2)->name());
+  EXPECT_EQ("BAZ", um.readuser(6)->name());
+}
+
+TEST_F(UserManagerTest, AddUser_Full) {
+  const auto max_users = helper.config().max_users();
+  ASSERT_TRUE(um.writeuser(CreateUser("LAST"), max_users));
+  EXPECT_FALSE(um.add_user(CreateUser("FOO")));
+}
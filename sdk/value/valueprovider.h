@@ -40,7 +40,7 @@ public:
   /**
    * Returns the prefix for this value provider. i.e. "user"
    */
-  [[nodiscard]] std::string prefix() const { return prefix_; }
+  [[nodiscard]] const std::string& prefix() const noexcept { return prefix_; }
 
 private:
   const std::string prefix_;
@@ -19,11 +19,14 @@
 
 #include "core/command_line.h"
 #include "core/datetime.h"
+#include "core/file.h"
 #include "core/log.h"
 #include "core/stl.h"
 #include "core/strings.h"
 #include "core/textfile.h"
+#include "sdk/filenames.h"
 #include "sdk/names.h"
+#include "sdk/msgapi/email_index.h"
 #include "sdk/msgapi/message_api_wwiv.h"
 #include "sdk/net/networks.h"
 #include "wwivutil/util.h"
@@ -209,6 +212,30 @@ public:
   }
 };
 
+class ReindexEmailCommand final : public BaseEmailSubCommand {
+public:
+  ReindexEmailCommand()
+      : BaseEmailSubCommand("reindex", "Rebuilds the email mailbox index (email.idx).") {}
+
+  [[nodiscard]] std::string GetUsage() const override {
+    std::ostringstream ss;
+    ss << "Usage:   reindex" << std::endl;
+    return ss.str();
+  }
+
+  int Execute() override {
+    EmailIndex index(FilePath(config()->config()->datadir(), EMAIL_DAT));
+    if (!index.Rebuild()) {
+      std::clog << "Unable to rebuild the email index." << std::endl;
+      return 1;
+    }
+    std::cout << "Indexed " << index.number_of_messages() << " email messages in "
+              << index.number_of_records() << " records." << std::endl;
+    return 0;
+  }
+
+  bool AddSubCommands() override { return true; }
+};
 
 bool EmailCommand::AddSubCommands() {
   if (!add(std::make_unique<EmailDumpCommand>())) {
@@ -220,6 +247,9 @@ bool EmailCommand::AddSubCommands() {
   if (!add(std::make_unique<AddEmailCommand>())) {
     return false;
   }
+  if (!add(std::make_unique<ReindexEmailCommand>())) {
+    return false;
+  }
   
   return true;
 }
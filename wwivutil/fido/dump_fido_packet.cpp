@@ -118,23 +118,18 @@ static int dump_stored_message(const std::string& filename) {
 }
 
 static int dump_packet_file(const std::string& filename) {
-  File f(filename);
-  if (!f.Open(File::modeBinary | File::modeReadOnly)) {
+  auto o = FidoPacket::Open(filename);
+  if (!o) {
     LOG(ERROR) << "Unable to open file: " << filename;
     return 1;
   }
 
   auto done = false;
-  packet_header_2p_t header = {};
-  auto num_header_read = f.Read(&header, sizeof(packet_header_2p_t));
-  if (num_header_read < static_cast<int>(sizeof(packet_header_2p_t))) {
-    LOG(ERROR) << "Read less than packet header";
-    return 1;
-  }
+  auto& packet = o.value();
+  const auto header = packet.header();
 
   while (!done) {
-    FidoPackedMessage msg;
-    auto response = read_packed_message(f, msg);
+    auto [response, msg] = packet.Read();
     if (response == ReadNetPacketResponse::END_OF_FILE) {
       return 0;
     }
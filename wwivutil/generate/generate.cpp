@@ -0,0 +1,133 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#include "wwivutil/generate/generate.h"
+
+#include "core/command_line.h"
+#include "core/datetime.h"
+#include "core/log.h"
+#include "sdk/synthetic_data.h"
+#include <iostream>
+#include <string>
+
+using namespace wwiv::core;
+using namespace wwiv::sdk;
+
+namespace wwiv::wwivutil {
+
+// Echo area and subtype used for all generated network packets.
+static const std::string generated_area = "GENCHAT";
+// Generated data is spread out over this many days before now.
+static constexpr int64_t generated_days = 365;
+static constexpr int64_t seconds_per_day = 24 * 60 * 60;
+
+class GenerateBbsCommand final : public UtilCommand {
+public:
+  GenerateBbsCommand()
+      : UtilCommand("bbs", "Adds synthetic users, subs, files, email and packets to the BBS.") {}
+
+  [[nodiscard]] std::string GetUsage() const override {
+    std::ostringstream ss;
+    ss << "Usage:   bbs [--users=N] [--subs=N] [--posts=N] [--dirs=N] [--files=N]" << std::endl;
+    ss << "             [--email=N] [--packets=N] [--text_size=N] [--seed=N]" << std::endl;
+    ss << "Example: WWIVUTIL generate bbs --users=30000 --subs=100 --posts=10000" << std::endl;
+    ss << std::endl;
+    ss << "Adds generated data to the BBS for load and scale testing. Anything set" << std::endl;
+    ss << "to 0 is skipped. Only use this on a test BBS, nothing is ever removed." << std::endl;
+    ss << std::endl;
+    ss << "  users     Users added to USER.LST and NAMES.LST." << std::endl;
+    ss << "  subs      New type-2 subs, each with --posts posts (at most 65535)." << std::endl;
+    ss << "  dirs      New file areas, each with --files files." << std::endl;
+    ss << "  email     Email messages added to EMAIL.DAT." << std::endl;
+    ss << "  packets   Inbound posts written to each network, WWIVnet packets as a" << std::endl;
+    ss << "            p*.net file and FTN packets as a *.pkt file in the temp inbound" << std::endl;
+    ss << "            directory, all for the sub or echo " << generated_area << "." << std::endl;
+    ss << "  text_size Average size in bytes of each message." << std::endl;
+    ss << "  seed      Generating again with the same seed gives the same data." << std::endl;
+    return ss.str();
+  }
+
+  bool AddSubCommands() override {
+    add_argument({"users", "Number of users to add.", "1000"});
+    add_argument({"subs", "Number of subs to add.", "10"});
+    add_argument({"posts", "Number of posts in each new sub.", "1000"});
+    add_argument({"dirs", "Number of file areas to add.", "10"});
+    add_argument({"files", "Number of files in each new file area.", "500"});
+    add_argument({"email", "Number of email messages to add.", "1000"});
+    add_argument({"packets", "Number of inbound posts for each network.", "100"});
+    add_argument({"text_size", "Average size in bytes of each message.", "1500"});
+    add_argument({"seed", "Seed for the generated data.", "1"});
+    return true;
+  }
+
+  int Execute() override {
+    if (!config()->config()->IsInitialized()) {
+      LOG(ERROR) << "BBS is not initialized.";
+      return 1;
+    }
+    SyntheticData data(iarg<uint32_t>("seed"), iarg<int>("text_size"),
+                       daten_t_now() - generated_days * seconds_per_day);
+    SyntheticBbs bbs(*config()->config(), config()->networks().networks(), data);
+
+    if (const auto n = iarg<int>("users"); n > 0) {
+      std::cout << "Adding " << n << " users" << std::endl;
+      if (!bbs.AddUsers(n)) {
+        return 1;
+      }
+    }
+    if (!bbs.LoadSenders()) {
+      LOG(ERROR) << "No users to send messages from, use --users to add some.";
+      return 1;
+    }
+    if (const auto n = iarg<int>("subs"); n > 0) {
+      const auto posts = iarg<int>("posts");
+      std::cout << "Adding " << n << " subs with " << posts << " posts each" << std::endl;
+      if (!bbs.AddSubs(n, posts)) {
+        return 1;
+      }
+    }
+    if (const auto n = iarg<int>("dirs"); n > 0) {
+      const auto files = iarg<int>("files");
+      std::cout << "Adding " << n << " file areas with " << files << " files each" << std::endl;
+      if (!bbs.AddDirs(n, files)) {
+        return 1;
+      }
+    }
+    if (const auto n = iarg<int>("email"); n > 0) {
+      std::cout << "Adding " << n << " email messages" << std::endl;
+      if (!bbs.AddEmail(n)) {
+        return 1;
+      }
+    }
+    if (const auto n = iarg<int>("packets"); n > 0) {
+      std::cout << "Adding " << n << " inbound posts to each network" << std::endl;
+      if (!bbs.AddPackets(n, generated_area)) {
+        return 1;
+      }
+    }
+    std::cout << "Done!" << std::endl;
+    return 0;
+  }
+};
+
+bool GenerateCommand::AddSubCommands() {
+  add(std::make_unique<GenerateBbsCommand>());
+  return true;
+}
+
+}  // namespace
@@ -0,0 +1,34 @@
+/**************************************************************************/
+/*                                                                        */
+/*                          WWIV Version 5.x                              */
+/*                Copyright (C)2022, WWIV Software Services               */
+/*                                                                        */
+/*    Licensed  under the  Apache License, Version  2.0 (the "License");  */
+/*    you may not use this  file  except in compliance with the License.  */
+/*    You may obtain a copy of the License at                             */
+/*                                                                        */
+/*                http://www.apache.org/licenses/LICENSE-2.0              */
+/*                                                                        */
+/*    Unless  required  by  applicable  law  or agreed to  in  writing,   */
+/*    software  distributed  under  the  License  is  distributed on an   */
+/*    "AS IS"  BASIS, WITHOUT  WARRANTIES  OR  CONDITIONS OF ANY  KIND,   */
+/*    either  express  or implied.  See  the  License for  the specific   */
+/*    language governing permissions and limitations under the License.   */
+/*                                                                        */
+/**************************************************************************/
+#ifndef INCLUDED_WWIVUTIL_GENERATE_GENERATE_H
+#define INCLUDED_WWIVUTIL_GENERATE_GENERATE_H
+
+#include "wwivutil/command.h"
+
+namespace wwiv::wwivutil {
+
+class GenerateCommand final: public UtilCommand {
+public:
+  GenerateCommand(): UtilCommand("generate", "Generates synthetic BBS data for testing.") {}
+  bool AddSubCommands() override;
+};
+
+}  // namespace
+
+#endif
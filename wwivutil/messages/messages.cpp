@@ -262,7 +262,7 @@ public:
   [[nodiscard]] std::string GetUsage() const override {
     std::ostringstream ss;
     ss << "Usage:   pack <base sub filename>" << std::endl;
-    ss << "Example: post general" << std::endl;
+    ss << "Example: pack general" << std::endl;
     return ss.str();
   }
 
@@ -300,46 +300,17 @@ public:
       backup(*config()->config(), basename);
     }
 
-    auto newsub = sub();
-    newsub.filename = StrCat(basename, ".new");
-    {
-      auto area(api().Open(sub(), -1));
-      if (!api().Create(newsub, -1)) {
-        std::clog << "Unable to create new area: " << newsub.filename;
-        return 1;
-      }
-      auto newarea(api().Open(newsub, -1));
-      const auto total = area->number_of_messages();
-      for (auto i = 1; i <= total; i++) {
-        auto message(area->ReadMessage(i));
-        if (!message) {
-          LOG(ERROR) << "Unable to load message #" << i;
-          continue;
-        }
-        if (!newarea->AddMessage(*message, {})) {
-          LOG(ERROR) << "Error adding message: " << message->header().title();
-        } else {
-          std::cout << "[" << i << "]";
-        }
-      }
-    }
-
-    // Copy "new" versions back to sub and dat
-    const auto orig_sub_fn = FilePath(config()->config()->datadir(), StrCat(basename, ".sub"));
-    const auto new_sub_fn =
-        FilePath(config()->config()->datadir(), StrCat(newsub.filename, ".sub"));
-    File::Remove(orig_sub_fn);
-    if (!File::Rename(new_sub_fn, orig_sub_fn)) {
-      std::clog << "Unable to move sub";
+    auto area(api().Open(sub(), -1));
+    if (!area) {
+      std::clog << "Error opening message area: '" << basename << "'." << std::endl;
+      return 1;
     }
-    const auto orig_dat_fn =
-        FilePath(config()->config()->msgsdir(), StrCat(newsub.filename, ".dat"));
-    const auto new_dat_fn =
-        FilePath(config()->config()->msgsdir(), StrCat(newsub.filename, ".dat"));
-    File::Remove(orig_dat_fn);
-    if (!File::Rename(new_dat_fn, orig_dat_fn)) {
-      std::clog << "Unable to move dat";
+    const auto num_messages = area->number_of_messages();
+    if (!area->Pack()) {
+      std::clog << "Unable to pack message area: '" << basename << "'." << std::endl;
+      return 1;
     }
+    std::cout << "Packed " << num_messages << " messages in: '" << basename << "'." << std::endl;
 
     return 0;
   }
@@ -40,14 +40,14 @@ using namespace wwiv::strings;
 namespace wwiv::wwivutil {
 
 int dump_file(const std::filesystem::path& filename) {
-  NetMailFile file(filename, true);
+  NetMailFileView file(filename, true);
   if (!file) {
     LOG(ERROR) << "Unable to open file: " << filename;
     return 1;
   }
 
   auto current{0};
-  for (auto packet : file) {
+  for (const auto& packet : file) {
     std::cout << "Header for Packet Index Number: #" << std::setw(5) << std::left << current++ << std::endl;
     std::cout << "=============================================================================="
          << std::endl;
@@ -71,7 +71,7 @@ int dump_file(const std::filesystem::path& filename) {
     if (packet.nh.list_len > 0) {
       // read list of addresses.
       std::cout << "System List: ";
-      for (const auto item : packet.list) {
+      for (const auto item : packet.list()) {
         std::cout << item << " ";
       }
       std::cout << std::endl;
@@ -82,7 +82,7 @@ int dump_file(const std::filesystem::path& filename) {
       std::cout << "Raw Packet Text:" << std::endl;
       std::cout << "=============================================================================="
                 << std::endl;
-      for (const auto ch : packet.text()) {
+      for (const auto ch : packet.text) {
         dump_char(std::cout, ch);
       }
       std::cout << std::endl << std::endl;
@@ -30,6 +30,7 @@
 #include "wwivutil/fido/fido.h"
 #include "wwivutil/files/files.h"
 #include "wwivutil/fix/fix.h"
+#include "wwivutil/generate/generate.h"
 #include "wwivutil/messages/messages.h"
 #include "wwivutil/menus/menus.h"
 #include "wwivutil/net/net.h"
@@ -73,6 +74,7 @@ public:
       Add(std::make_unique<fido::FidoCommand>());
       Add(std::make_unique<files::FilesCommand>());
       Add(std::make_unique<FixCommand>());
+      Add(std::make_unique<GenerateCommand>());
       Add(std::make_unique<HelpCommand>());
       Add(std::make_unique<InstanceCommand>());
       Add(std::make_unique<MessagesCommand>());